@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package intl;
+
+import webbench.WebBenchBase;
+
+/**
+ * Measures locale sensitive sorting and formatting the way grid and table
+ * components do it: sorting rows with localeCompare, with and without an
+ * explicit locale and options, and formatting numbers and dates with a new
+ * Intl object or toLocaleString call per value.
+ *
+ * The rows are mostly ASCII names with some accented ones. Every iteration
+ * checks that the sort order and the formatted text match the first one.
+ *
+ * Usage: IntlBench [rows [iterations]]
+ */
+public class IntlBench extends WebBenchBase {
+
+    private static final String SCRIPT =
+        "var WORDS = ['alpha', 'Beta', 'gamma', 'Delta', 'epsilon', 'lorem', 'Ipsum', 'dolor', 'sit', 'amet', 'caf\\u00e9', '\\u00c9cole'];"
+        + "function rows(count) {"
+        + "  var list = [];"
+        + "  for (var i = 0; i < count; i++) {"
+        + "    var name = WORDS[(i * 7) % WORDS.length] + ' ' + WORDS[(i * 13 + 5) % WORDS.length] + ' ' + (i * 7919 % count);"
+        + "    list.push({ name: name, amount: i * 12.5 + 0.25, date: 1500000000000 + i * 86400000 });"
+        + "  }"
+        + "  return list;"
+        + "}"
+        + "var TESTS = {"
+        + "  'sort': function (list) { return list.slice().sort(function (a, b) { return a.name.localeCompare(b.name); }); },"
+        + "  'sort de': function (list) { return list.slice().sort(function (a, b) { return a.name.localeCompare(b.name, 'de'); }); },"
+        + "  'sort base': function (list) { return list.slice().sort(function (a, b) { return a.name.localeCompare(b.name, 'en', { sensitivity: 'base' }); }); },"
+        + "  'numbers': function (list) { return list.map(function (row) { return new Intl.NumberFormat('en-US', { style: 'currency', currency: 'EUR' }).format(row.amount); }); },"
+        + "  'dates': function (list) { return list.map(function (row) { return new Date(row.date).toLocaleDateString('en-US', { year: 'numeric', month: 'short', day: 'numeric' }); }); }"
+        + "};"
+        + "var data = {};"
+        + "function run(name, count, iterations) {"
+        + "  var list = data[count] || (data[count] = rows(count));"
+        + "  var expected, start = performance.now();"
+        + "  for (var i = 0; i < iterations; i++) {"
+        + "    var result = TESTS[name](list).map(function (value) { return typeof value == 'string' ? value : value.name; }).join('\\n');"
+        + "    if (expected !== undefined && result !== expected) return -1;"
+        + "    expected = result;"
+        + "  }"
+        + "  return (performance.now() - start) / iterations;"
+        + "}";
+
+    private static final String[] NAMES = {
+        "sort", "sort de", "sort base", "numbers", "dates"
+    };
+
+    private int rows;
+    private int iterations;
+
+    @Override
+    public void init() {
+        rows = getArgument(0, 100000);
+        iterations = getArgument(1, 3);
+    }
+
+    @Override
+    protected String getScript() {
+        return SCRIPT;
+    }
+
+    @Override
+    protected void runBenchmark() {
+        for (String name : NAMES) {
+            double[] result = call("run('" + name + "', " + rows + ", " + iterations + ")");
+            report(String.format("%-10s %7d rows", name, rows), result,
+                   "result changed between iterations", "%9.2f ms", result[0]);
+        }
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
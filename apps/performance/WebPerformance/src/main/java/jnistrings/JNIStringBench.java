@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package jnistrings;
+
+import org.w3c.dom.Document;
+import org.w3c.dom.Element;
+import org.w3c.dom.NodeList;
+import webbench.WebBenchBase;
+
+/**
+ * Measures the cost of passing strings between Java and WebCore through
+ * the DOM API, one figure per conversion path.
+ *
+ * Element names and attribute values are atomic strings in WebCore, so
+ * reading them repeatedly exercises the cached path. Text content is
+ * built on each call, so it is converted every time, from Latin-1 or
+ * from UTF-16 storage depending on the document text. Setting attributes
+ * converts Java strings to WebCore strings, again for Latin-1 and for
+ * non-Latin-1 values.
+ *
+ * Usage: JNIStringBench [elements [iterations]]
+ */
+public class JNIStringBench extends WebBenchBase {
+
+    private int elements;
+    private int iterations;
+
+    private long sink;
+
+    @Override
+    public void init() {
+        elements = getArgument(0, 2000);
+        iterations = getArgument(1, 50);
+    }
+
+    @Override
+    protected void runBenchmark() {
+        Document document = getEngine().getDocument();
+        NodeList latin1 = document.getElementById("latin1").getElementsByTagName("p");
+        NodeList utf16 = document.getElementById("utf16").getElementsByTagName("p");
+        Element[] targets = new Element[latin1.getLength()];
+        for (int i = 0; i < targets.length; i++) {
+            targets[i] = (Element) latin1.item(i);
+        }
+        Element[] utf16Targets = new Element[utf16.getLength()];
+        for (int i = 0; i < utf16Targets.length; i++) {
+            utf16Targets[i] = (Element) utf16.item(i);
+        }
+
+        // Warm up all paths before timing
+        for (int pass = 0; pass < 2; pass++) {
+            boolean print = pass == 1;
+            time(print, "atomic: localName", () -> {
+                for (Element e : targets) {
+                    sink += e.getLocalName().length();
+                }
+            });
+            time(print, "atomic: getAttribute", () -> {
+                for (Element e : targets) {
+                    sink += e.getAttribute("class").length();
+                }
+            });
+            time(print, "to Java: Latin-1 text", () -> {
+                for (Element e : targets) {
+                    sink += e.getTextContent().length();
+                }
+            });
+            time(print, "to Java: UTF-16 text", () -> {
+                for (Element e : utf16Targets) {
+                    sink += e.getTextContent().length();
+                }
+            });
+            time(print, "from Java: Latin-1 value", () -> {
+                for (Element e : targets) {
+                    e.setAttribute("data-v", "value café " + (sink & 7));
+                }
+            });
+            time(print, "from Java: UTF-16 value", () -> {
+                for (Element e : targets) {
+                    e.setAttribute("data-v", "значение " + (sink & 7));
+                }
+            });
+        }
+        System.out.println("(" + sink + ")");
+    }
+
+    private void time(boolean print, String name, Runnable body) {
+        long start = System.nanoTime();
+        for (int i = 0; i < iterations; i++) {
+            body.run();
+        }
+        double nanos = (System.nanoTime() - start) / (double) iterations / elements;
+        if (print) {
+            System.out.printf("%-28s %8.1f ns per string%n", name, nanos);
+        }
+    }
+
+    @Override
+    protected String createDocument() {
+        StringBuilder sb = new StringBuilder();
+        sb.append("<!DOCTYPE html><html><body>\n<div id=latin1>");
+        for (int i = 0; i < elements; i++) {
+            sb.append("<p class=\"item row").append(i % 10).append("\">Latin-1 paragraph number ")
+              .append(i).append(", déjà vu</p>\n");
+        }
+        sb.append("</div>\n<div id=utf16>");
+        for (int i = 0; i < elements; i++) {
+            sb.append("<p>Параграф ").append(i)
+              .append(" — 段落</p>\n");
+        }
+        sb.append("</div>\n</body></html>\n");
+        return sb.toString();
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package json;
+
+import webbench.WebBenchBase;
+
+/**
+ * Measures JSON.parse and JSON.stringify throughput on generated payloads
+ * shaped like the data that WebView based UIs exchange with Java.
+ *
+ * The payloads are a list of records with ids, names, free text with the
+ * occasional quote, newline or non-Latin-1 character, numbers and nested
+ * tag arrays. Each is measured compact, pretty-printed with two space
+ * indentation, and with long text fields. Every iteration checks that
+ * stringifying the parsed value reproduces the compact input exactly.
+ *
+ * Usage: JSONBench [records [iterations]]
+ */
+public class JSONBench extends WebBenchBase {
+
+    private static final String SCRIPT =
+        "var WORDS = ['alpha', 'beta', 'gamma', 'delta', 'epsilon', 'lorem', 'ipsum', 'dolor', 'sit', 'amet'];"
+        + "function text(seed, words) {"
+        + "  var s = [];"
+        + "  for (var i = 0; i < words; i++) s.push(WORDS[(seed * 7 + i * 13) % WORDS.length]);"
+        + "  if (seed % 17 == 0) s.push('say \"hi\"');"
+        + "  if (seed % 23 == 0) s.push('line\\nbreak');"
+        + "  if (seed % 29 == 0) s.push('caf\\u00e9 \\u65e5\\u672c');"
+        + "  return s.join(' ');"
+        + "}"
+        + "function payload(records, words) {"
+        + "  var list = [];"
+        + "  for (var i = 0; i < records; i++) {"
+        + "    list.push({ id: i, uuid: 'a1b2c3d4-' + (100000 + i), name: text(i, 3), active: i % 3 != 0,"
+        + "      score: i * 1.25, created: 1500000000000 + i * 1000, description: text(i, words),"
+        + "      tags: [text(i + 1, 1), text(i + 2, 1)], owner: { id: i % 97, name: text(i % 97, 2) } });"
+        + "  }"
+        + "  return { version: 3, total: records, items: list };"
+        + "}"
+        + "function measure(json, compact, iterations) {"
+        + "  var parse = 0, stringify = 0;"
+        + "  for (var i = 0; i < iterations; i++) {"
+        + "    var start = performance.now();"
+        + "    var value = JSON.parse(json);"
+        + "    parse += performance.now() - start;"
+        + "    start = performance.now();"
+        + "    var out = JSON.stringify(value);"
+        + "    stringify += performance.now() - start;"
+        + "    if (out !== compact) return [-1, -1];"
+        + "  }"
+        + "  return [parse / iterations, stringify / iterations];"
+        + "}"
+        + "function run(name, records, words, indent, iterations) {"
+        + "  var value = payload(records, words);"
+        + "  var compact = JSON.stringify(value);"
+        + "  var json = indent ? JSON.stringify(value, null, indent) : compact;"
+        + "  var result = measure(json, compact, iterations);"
+        + "  return [result[0], result[1], json.length];"
+        + "}";
+
+    private int records;
+    private int iterations;
+
+    @Override
+    public void init() {
+        records = getArgument(0, 20000);
+        iterations = getArgument(1, 10);
+    }
+
+    @Override
+    protected String getScript() {
+        return SCRIPT;
+    }
+
+    @Override
+    protected void runBenchmark() {
+        report("compact", 8, 0);
+        report("pretty", 8, 2);
+        report("long text", 200, 0);
+    }
+
+    private void report(String name, int words, int indent) {
+        double[] result = call("run('" + name + "', " + records + ", " + words + ", " + indent + ", " + iterations + ")");
+        double megabytes = result[2] / (1024 * 1024);
+        report(String.format("%-10s %6.1f MB", name, megabytes), result,
+               "stringify does not reproduce the input",
+               "parse %8.2f ms (%6.1f MB/s), stringify %8.2f ms",
+               result[0], megabytes * 1000 / result[0], result[1]);
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package regexp;
+
+import webbench.WebBenchBase;
+
+/**
+ * Measures regular expression search throughput on a generated log-like
+ * text, for patterns that start with a literal, that require a rare
+ * character, that alternate between literals, that start with a character
+ * class, and that ignore case.
+ *
+ * The figures are meant for the Yarr interpreter, so run the benchmark
+ * with -Dcom.sun.webkit.useJIT=false to keep the regular expression JIT
+ * out of the way. Every iteration checks the number of matches against
+ * the first one.
+ *
+ * Usage: RegExpBench [lines [iterations]]
+ */
+public class RegExpBench extends WebBenchBase {
+
+    private static final String SCRIPT =
+        "var WORDS = ['alpha', 'beta', 'gamma', 'delta', 'epsilon', 'lorem', 'ipsum', 'dolor', 'sit', 'amet'];"
+        + "function subject(lines) {"
+        + "  var s = [];"
+        + "  for (var i = 0; i < lines; i++) {"
+        + "    var line = [];"
+        + "    for (var j = 0; j < 12; j++) line.push(WORDS[(i * 7 + j * 13) % WORDS.length]);"
+        + "    if (i % 50 == 0) line.push('ERROR: code=' + i);"
+        + "    if (i % 70 == 0) line.push('user@example.com');"
+        + "    if (i % 90 == 0) line.push('Timeout ' + (i % 1000) + 'ms');"
+        + "    s.push(line.join(' '));"
+        + "  }"
+        + "  return s.join('\\n');"
+        + "}"
+        + "var PATTERNS = {"
+        + "  'literal': /ERROR: code=(\\d+)/g,"
+        + "  'required': /\\w+@\\w+\\.com/g,"
+        + "  'alternation': /Timeout|Exception|Fatal/g,"
+        + "  'class': /\\d+ms/g,"
+        + "  'ignore case': /error/gi"
+        + "};"
+        + "var text = {};"
+        + "function run(name, lines, iterations) {"
+        + "  var s = text[lines] || (text[lines] = subject(lines));"
+        + "  var re = PATTERNS[name];"
+        + "  var expected = -1, start = performance.now();"
+        + "  for (var i = 0; i < iterations; i++) {"
+        + "    var count = 0;"
+        + "    re.lastIndex = 0;"
+        + "    while (re.exec(s)) count++;"
+        + "    if (expected >= 0 && count != expected) return [-1, count, s.length];"
+        + "    expected = count;"
+        + "  }"
+        + "  return [(performance.now() - start) / iterations, expected, s.length];"
+        + "}";
+
+    private static final String[] NAMES = {
+        "literal", "required", "alternation", "class", "ignore case"
+    };
+
+    private int lines;
+    private int iterations;
+
+    @Override
+    public void init() {
+        lines = getArgument(0, 50000);
+        iterations = getArgument(1, 10);
+    }
+
+    @Override
+    protected String getScript() {
+        return SCRIPT;
+    }
+
+    @Override
+    protected void runBenchmark() {
+        for (String name : NAMES) {
+            double[] result = call("run('" + name + "', " + lines + ", " + iterations + ")");
+            double megabytes = result[2] / (1024 * 1024);
+            int matches = (int) result[1];
+            report(String.format("%-12s %6.1f MB", name, megabytes), result,
+                   "match count changed to " + matches,
+                   "%8.2f ms (%7.1f MB/s), %d matches",
+                   result[0], megabytes * 1000 / result[0], matches);
+        }
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package stylerecalc;
+
+import webbench.WebBenchBase;
+
+/**
+ * Measures style recalculation after a class toggle on synthetic DOMs.
+ *
+ * The wide document is a data grid whose cells carry a class per column,
+ * the deep document a tree of nested blocks. Each iteration toggles a
+ * class on the root that descendant rules depend on and forces a style
+ * update by reading a computed style, timed with performance.now(). A
+ * digest of the computed styles is taken in both states to check that
+ * repeated recalculation gives the same result as the initial one.
+ *
+ * Usage: StyleRecalcBench [rows [columns [depth [iterations]]]]
+ */
+public class StyleRecalcBench extends WebBenchBase {
+
+    private static final String STYLE =
+        "<style>"
+        + ".grid td { padding: 1px; color: black; }"
+        + ".grid.compact td { padding: 0; color: #333; }"
+        + ".c0 { font-weight: bold; } .c1 { text-align: right; } .c2 { font-style: italic; }"
+        + ".tree div { margin-left: 2px; border-left: 1px solid gray; }"
+        + ".tree.compact div { margin-left: 1px; }"
+        + ".tree .leaf { color: blue; } .tree.compact .leaf { color: navy; }"
+        + "</style>";
+
+    private static final String SCRIPT =
+        "function digest(root) {"
+        + "  var h = 0, list = root.getElementsByTagName('*');"
+        + "  for (var i = 0; i < list.length; i++) {"
+        + "    var s = getComputedStyle(list[i]);"
+        + "    var v = s.color + s.paddingLeft + s.marginLeft + s.fontWeight + s.textAlign;"
+        + "    for (var j = 0; j < v.length; j++) h = (h * 31 + v.charCodeAt(j)) | 0;"
+        + "  }"
+        + "  return h;"
+        + "}"
+        + "function run(id, iterations) {"
+        + "  var root = document.getElementById(id);"
+        + "  var expected = [digest(root)];"
+        + "  root.classList.toggle('compact');"
+        + "  expected.push(digest(root));"
+        + "  root.classList.toggle('compact');"
+        + "  var total = 0;"
+        + "  for (var i = 0; i < iterations; i++) {"
+        + "    var start = performance.now();"
+        + "    root.classList.toggle('compact');"
+        + "    getComputedStyle(root.lastElementChild).color;"
+        + "    total += performance.now() - start;"
+        + "    if (i < 2 && digest(root) != expected[(i + 1) % 2]) return -1;"
+        + "  }"
+        + "  return total / iterations;"
+        + "}";
+
+    private int rows;
+    private int columns;
+    private int depth;
+    private int iterations;
+
+    @Override
+    public void init() {
+        rows = getArgument(0, 5000);
+        columns = getArgument(1, 12);
+        depth = getArgument(2, 12);
+        iterations = getArgument(3, 20);
+    }
+
+    @Override
+    protected String createDocument() {
+        StringBuilder sb = new StringBuilder();
+        sb.append("<!DOCTYPE html><html><head>").append(STYLE)
+          .append("<script>").append(SCRIPT).append("</script></head><body>\n");
+
+        sb.append("<table id=wide class=grid>");
+        for (int r = 0; r < rows; r++) {
+            sb.append("<tr>");
+            for (int c = 0; c < columns; c++) {
+                sb.append("<td class=c").append(c).append('>').append(r).append("</td>");
+            }
+            sb.append("</tr>\n");
+        }
+        sb.append("</table>\n");
+
+        sb.append("<div id=deep class=tree>");
+        appendTree(sb, depth - 1);
+        sb.append("</div>\n");
+
+        sb.append("</body></html>\n");
+        return sb.toString();
+    }
+
+    @Override
+    protected void runBenchmark() {
+        report("wide", rows * columns);
+        report("deep", (1 << depth) - 1);
+    }
+
+    private void report(String id, int elements) {
+        double[] result = call("run('" + id + "', " + iterations + ")");
+        report(String.format("%-6s %8d elements", id, elements), result,
+               "computed styles differ", "%8.2f ms per recalc", result[0]);
+    }
+
+    private static void appendTree(StringBuilder sb, int levels) {
+        if (levels == 0) {
+            sb.append("<div class=leaf>x</div>");
+            return;
+        }
+        sb.append("<div>");
+        appendTree(sb, levels - 1);
+        appendTree(sb, levels - 1);
+        sb.append("</div>");
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
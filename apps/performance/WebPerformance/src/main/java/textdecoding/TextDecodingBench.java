@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package textdecoding;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.CharBuffer;
+import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import webbench.WebBenchBase;
+
+/**
+ * Compares the throughput of decoding legacy page encodings in WebKit's
+ * native codecs with the Java charsets that TextCodecJava used to call.
+ *
+ * For each encoding a large HTML document is generated. The Java figure
+ * decodes it in parser sized chunks, copying each chunk into a new byte
+ * array and the result into a new String, the way TextCodecJava did. The
+ * WebView figure is the time to load the document in that encoding minus
+ * the time to load the same document as UTF-8, which WebCore decodes with
+ * its built-in codec, so that parsing and layout cancel out.
+ *
+ * Usage: TextDecodingBench [sizeInMB [iterations]]
+ */
+public class TextDecodingBench extends WebBenchBase {
+
+    private static final String[] ENCODINGS = {
+        "Shift_JIS", "EUC-JP", "GBK", "Big5", "EUC-KR",
+        "windows-1251", "ISO-8859-2", "KOI8-R"
+    };
+
+    // The size of the chunks the HTML parser feeds to the decoder
+    private static final int CHUNK_SIZE = 8192;
+
+    private int sizeInMB;
+    private int iterations;
+
+    private final Deque<String> pending = new ArrayDeque<>();
+    private long loadStart;
+
+    @Override
+    public void init() {
+        sizeInMB = getArgument(0, 4);
+        iterations = getArgument(1, 5);
+    }
+
+    @Override
+    protected void runBenchmark() {
+        System.out.printf("%-14s %12s %12s %12s%n", "encoding", "Java MB/s", "WebView ms", "UTF-8 ms");
+        for (String encoding : ENCODINGS) {
+            if (Charset.isSupported(encoding)) {
+                pending.add(encoding);
+            }
+        }
+        next();
+    }
+
+    private void next() {
+        String encoding = pending.poll();
+        if (encoding != null) {
+            runEncoding(encoding);
+        }
+    }
+
+    private void runEncoding(String encoding) {
+        Charset charset = Charset.forName(encoding);
+        String html = generateDocument(charset, sizeInMB * 1024 * 1024);
+        byte[] encoded = html.getBytes(charset);
+        double javaMBs = measureJavaDecode(charset, encoded);
+
+        File legacy, utf8;
+        try {
+            legacy = writeDocument(encoded);
+            utf8 = writeDocument(html.replace("charset=" + encoding, "charset=UTF-8")
+                                     .getBytes(StandardCharsets.UTF_8));
+        } catch (IOException e) {
+            throw new RuntimeException(e);
+        }
+
+        long[] legacyNanos = new long[1];
+        long[] utf8Nanos = new long[1];
+        measureLoad(legacy, iterations, legacyNanos, () ->
+            measureLoad(utf8, iterations, utf8Nanos, () -> {
+                legacy.delete();
+                utf8.delete();
+                System.out.printf("%-14s %12.1f %12.1f %12.1f%n", encoding, javaMBs,
+                                  legacyNanos[0] / 1e6 / iterations,
+                                  utf8Nanos[0] / 1e6 / iterations);
+                next();
+            }));
+    }
+
+    private void measureLoad(File file, int count, long[] total, Runnable done) {
+        if (count == 0) {
+            done.run();
+            return;
+        }
+        loadStart = System.nanoTime();
+        load(file.toURI().toString(), () -> {
+            total[0] += System.nanoTime() - loadStart;
+            measureLoad(file, count - 1, total, done);
+        });
+    }
+
+    private double measureJavaDecode(Charset charset, byte[] encoded) {
+        // Warm up the charset before timing it
+        decodeInChunks(charset, encoded);
+        long start = System.nanoTime();
+        int chars = 0;
+        for (int i = 0; i < iterations; i++) {
+            chars += decodeInChunks(charset, encoded);
+        }
+        long nanos = System.nanoTime() - start;
+        if (chars == 0) {
+            throw new AssertionError();
+        }
+        return (double) encoded.length * iterations / (1024 * 1024) / (nanos / 1e9);
+    }
+
+    private static int decodeInChunks(Charset charset, byte[] encoded) {
+        int chars = 0;
+        for (int offset = 0; offset < encoded.length; offset += CHUNK_SIZE) {
+            int length = Math.min(CHUNK_SIZE, encoded.length - offset);
+            byte[] chunk = new byte[length];
+            System.arraycopy(encoded, offset, chunk, 0, length);
+            CharBuffer cb = charset.decode(ByteBuffer.wrap(chunk));
+            char[] decoded = new char[cb.remaining()];
+            cb.get(decoded);
+            chars += new String(decoded).length();
+        }
+        return chars;
+    }
+
+    private static String generateDocument(Charset charset, int size) {
+        // Mostly markup and text of the script the encoding is used for
+        String sample;
+        String name = charset.name();
+        if (name.equals("Shift_JIS") || name.equals("EUC-JP")) {
+            sample = "日本語の文章とカタカナ。";
+        } else if (name.equals("GBK")) {
+            sample = "中文网页的文字内容。";
+        } else if (name.equals("Big5")) {
+            sample = "繁體中文網頁的內容。";
+        } else if (name.equals("EUC-KR")) {
+            sample = "한국어 웹 페이지의 내용.";
+        } else if (name.equals("ISO-8859-2")) {
+            sample = "Żółta łódź płynie po rzece. ";
+        } else {
+            sample = "Русский текст страницы. ";
+        }
+
+        StringBuilder sb = new StringBuilder(size);
+        sb.append("<!DOCTYPE html><html><head><meta charset=")
+          .append(name).append("></head><body>\n");
+        int paragraph = 0;
+        while (sb.length() < size) {
+            sb.append("<p id=p").append(paragraph++).append(">");
+            for (int i = 0; i < 8; i++) {
+                sb.append(sample).append(" <b>abc ").append(i).append("</b> ");
+            }
+            sb.append("</p>\n");
+        }
+        sb.append("</body></html>\n");
+        return sb.toString();
+    }
+
+    private static File writeDocument(byte[] bytes) throws IOException {
+        File file = File.createTempFile("textdecoding", ".html");
+        file.deleteOnExit();
+        Files.write(file.toPath(), bytes);
+        return file;
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
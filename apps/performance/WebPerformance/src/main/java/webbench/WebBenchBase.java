@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package webbench;
+
+import java.util.List;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
+
+/**
+ * Shows a WebView, loads the document of the benchmark into it and runs
+ * the benchmark once it has loaded. The application exits when the
+ * benchmark returns, unless it started another load with
+ * {@link #load(String, Runnable)}.
+ *
+ * Script workloads define a run() function that returns an array, or a
+ * single number, whose first element is the time in milliseconds. A
+ * negative time means that the iterations did not agree on the result.
+ */
+public abstract class WebBenchBase extends Application {
+
+    private static final String EMPTY_DOCUMENT =
+        "<!DOCTYPE html><html><body></body></html>";
+
+    private WebEngine engine;
+    private Runnable onLoaded;
+
+    @Override
+    public void start(Stage stage) throws Exception {
+        WebView view = new WebView();
+        engine = view.getEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, oldState, state) -> {
+            if (state == Worker.State.SUCCEEDED || state == Worker.State.FAILED) {
+                Runnable r = onLoaded;
+                onLoaded = null;
+                // Let the loader unwind before going on
+                Platform.runLater(() -> {
+                    if (r != null) {
+                        r.run();
+                    }
+                    if (onLoaded == null) {
+                        Platform.exit();
+                    }
+                });
+            }
+        });
+        stage.setScene(new Scene(view, 800, 600));
+        stage.show();
+
+        onLoaded = () -> {
+            if (engine.getLoadWorker().getState() == Worker.State.SUCCEEDED) {
+                String script = getScript();
+                if (script != null) {
+                    engine.executeScript(script);
+                }
+                runBenchmark();
+            }
+        };
+        engine.loadContent(createDocument(), getContentType());
+    }
+
+    /**
+     * Returns the unnamed argument at the index as an int, or the default
+     * value if there is none.
+     */
+    protected int getArgument(int index, int defaultValue) {
+        List<String> args = getParameters().getUnnamed();
+        return args.size() > index ? Integer.parseInt(args.get(index)) : defaultValue;
+    }
+
+    protected WebEngine getEngine() {
+        return engine;
+    }
+
+    /**
+     * Returns the script that is run once the document has loaded, or
+     * null for none.
+     */
+    protected String getScript() {
+        return null;
+    }
+
+    protected String createDocument() {
+        return EMPTY_DOCUMENT;
+    }
+
+    protected String getContentType() {
+        return "text/html";
+    }
+
+    /**
+     * Runs the benchmark on the event thread once the document has loaded.
+     */
+    protected abstract void runBenchmark();
+
+    /**
+     * Loads the URL and calls onLoaded on the event thread once it has
+     * loaded or failed.
+     */
+    protected void load(String url, Runnable onLoaded) {
+        this.onLoaded = onLoaded;
+        engine.load(url);
+    }
+
+    /**
+     * Evaluates a call to run() and returns what it returned as an array.
+     */
+    protected double[] call(String call) {
+        Object result = engine.executeScript(call);
+        if (result instanceof Number) {
+            return new double[] { ((Number) result).doubleValue() };
+        }
+        JSObject array = (JSObject) result;
+        double[] values = new double[((Number) array.getMember("length")).intValue()];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = ((Number) array.getSlot(i)).doubleValue();
+        }
+        return values;
+    }
+
+    /**
+     * Prints the label followed by the columns, or by the failure if the
+     * iterations did not agree on the result.
+     */
+    protected void report(String label, double[] result, String failure,
+                          String format, Object... columns) {
+        if (result[0] < 0) {
+            System.out.println(label + ": " + failure);
+        } else {
+            System.out.println(label + ": " + String.format(format, columns));
+        }
+    }
+}
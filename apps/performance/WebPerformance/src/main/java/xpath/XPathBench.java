@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates.
+ * All rights reserved. Use is subject to license terms.
+ *
+ * This file is available and licensed under the following license:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the name of Oracle Corporation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package xpath;
+
+import webbench.WebBenchBase;
+
+/**
+ * Measures document.evaluate() on a large generated XML document.
+ *
+ * The document is a catalog of groups nested a few levels deep, each
+ * holding items with unique ids. Every query in the corpus is evaluated
+ * repeatedly with performance.now() timing, and the size of its result
+ * is checked against the same selection made by walking the DOM with
+ * getElementsByTagName, so that an index returning stale or unordered
+ * nodes shows up as a mismatch rather than as a speedup.
+ *
+ * Usage: XPathBench [items [iterations]]
+ */
+public class XPathBench extends WebBenchBase {
+
+    // Each query is paired with a script computing the expected result
+    private static final String[][] QUERIES = {
+        { "//item[@id='i777']", "document.getElementById('i777') ? [document.getElementById('i777')] : []" },
+        { "//item", "all('item')" },
+        { "//group//item", "all('item')" },
+        { "/catalog/group/group", "all('group').filter(function(g) { return g.parentNode.parentNode == document.documentElement; })" },
+        { "//item[@kind='b']", "all('item').filter(function(e) { return e.getAttribute('kind') == 'b'; })" },
+        { "//item[@id='i777']/ancestor::group", "ancestors(document.getElementById('i777'))" },
+        { "//group[@id='g3']//item | //group[@id='g5']//item", "within('g3').concat(within('g5'))" },
+    };
+
+    private static final String SCRIPT =
+        "function all(name) { return Array.prototype.slice.call(document.getElementsByTagName(name)); }"
+        + "function within(id) {"
+        + "  var g = document.getElementById(id);"
+        + "  return g ? Array.prototype.slice.call(g.getElementsByTagName('item')) : [];"
+        + "}"
+        + "function ancestors(node) {"
+        + "  var result = [];"
+        + "  for (node = node && node.parentNode; node && node.nodeType == 1; node = node.parentNode)"
+        + "    if (node.localName == 'group') result.unshift(node);"
+        + "  return result;"
+        + "}"
+        + "function run(query, expected, iterations) {"
+        + "  var total = 0, result;"
+        + "  for (var i = 0; i < iterations; i++) {"
+        + "    var start = performance.now();"
+        + "    result = document.evaluate(query, document, null, XPathResult.ORDERED_NODE_SNAPSHOT_TYPE, null);"
+        + "    total += performance.now() - start;"
+        + "  }"
+        + "  if (result.snapshotLength != expected.length) return [-1, result.snapshotLength];"
+        + "  for (var j = 0; j < expected.length; j++)"
+        + "    if (result.snapshotItem(j) != expected[j]) return [-1, result.snapshotLength];"
+        + "  return [total / iterations, result.snapshotLength];"
+        + "}";
+
+    private int items;
+    private int iterations;
+
+    @Override
+    public void init() {
+        items = getArgument(0, 100000);
+        iterations = getArgument(1, 20);
+    }
+
+    @Override
+    protected String getScript() {
+        return SCRIPT;
+    }
+
+    @Override
+    protected String getContentType() {
+        return "application/xml";
+    }
+
+    @Override
+    protected void runBenchmark() {
+        System.out.printf("%d items%n", items);
+        for (String[] query : QUERIES) {
+            double[] result = call("run(\"" + query[0] + "\", " + query[1] + ", " + iterations + ")");
+            report(String.format("%-50s %7d nodes", query[0], (int) result[1]), result,
+                   "result differs from DOM walk", "%8.3f ms per query", result[0]);
+        }
+    }
+
+    @Override
+    protected String createDocument() {
+        StringBuilder sb = new StringBuilder();
+        sb.append("<?xml version=\"1.0\"?>\n<catalog>\n");
+        // Ten top level groups of ten nested groups each
+        int groups = 100;
+        int perGroup = Math.max(1, items / groups);
+        int item = 0;
+        for (int g = 0; g < 10; g++) {
+            sb.append("<group id=\"g").append(g).append("\">\n");
+            for (int n = 0; n < 10; n++) {
+                sb.append("<group id=\"g").append(g).append('_').append(n).append("\">");
+                for (int i = 0; i < perGroup; i++, item++) {
+                    sb.append("<item id=\"i").append(item).append("\" kind=\"")
+                      .append((char) ('a' + item % 3)).append("\"><name>n")
+                      .append(item).append("</name></item>");
+                }
+                sb.append("</group>\n");
+            }
+            sb.append("</group>\n");
+        }
+        sb.append("</catalog>\n");
+        return sb.toString();
+    }
+
+    /**
+     * Java main for when running without JavaFX launcher
+     */
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
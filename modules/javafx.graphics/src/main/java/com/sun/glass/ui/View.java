@@ -44,6 +44,9 @@ public abstract class View {
     @Native public final static byte IME_ATTR_TARGET_NOTCONVERTED   = 0x03;
     @Native public final static byte IME_ATTR_INPUT_ERROR           = 0x04;
 
+    // Uploads with more damaged rectangles than this present the entire view
+    @Native public final static int MAX_DAMAGE_RECTS = 16;
+
     final static boolean accessible = AccessController.doPrivileged((PrivilegedAction<Boolean>) () -> {
         String force = System.getProperty("glass.accessible.force");
         if (force != null) return Boolean.parseBoolean(force);
@@ -758,6 +761,15 @@ public abstract class View {
 
 
     protected abstract void _uploadPixels(long ptr, Pixels pixels);
+
+    /**
+     * Dumps the damaged areas of the pixels on to the view. Platforms that
+     * can not present a partial frame upload the entire pixels.
+     */
+    protected void _uploadPixels(long ptr, Pixels pixels, int[] damage) {
+        _uploadPixels(ptr, pixels);
+    }
+
     /**
      * This method dumps the pixels on to the view.
      *
@@ -765,11 +777,23 @@ public abstract class View {
      * transparent windows in order to update them.
      */
     public void uploadPixels(Pixels pixels) {
+        uploadPixels(pixels, null);
+    }
+
+    /**
+     * This method dumps the pixels on to the view, limited to the areas
+     * that changed since the previously uploaded pixels.
+     *
+     * @param pixels the pixels of the entire view
+     * @param damage the changed areas as (x, y, width, height) quadruples
+     *        in pixel coordinates, or null if the entire view changed
+     */
+    public void uploadPixels(Pixels pixels, int[] damage) {
         Application.checkEventThread();
         checkNotClosed();
         lock();
         try {
-            _uploadPixels(this.ptr, pixels);
+            _uploadPixels(this.ptr, pixels, damage);
         } finally {
             unlock();
         }
@@ -252,7 +252,17 @@ final class GtkApplication extends Application implements
         final boolean disableGrab = AccessController.doPrivileged((PrivilegedAction<Boolean>) () -> Boolean.getBoolean("sun.awt.disablegrab") ||
                Boolean.getBoolean("glass.disableGrab"));
 
-        _init(eventProc, disableGrab);
+        // Presenting through MIT-SHM images can be turned off for X servers
+        // that advertise the extension but handle it poorly
+        final boolean useShm = AccessController.doPrivileged((PrivilegedAction<Boolean>) () ->
+               !"false".equals(System.getProperty("glass.gtk.useShm")));
+
+        // Bursts of motion, scroll and configure events are merged into one
+        // event natively unless this is turned off
+        final boolean coalesceEvents = AccessController.doPrivileged((PrivilegedAction<Boolean>) () ->
+               !"false".equals(System.getProperty("glass.gtk.coalesceEvents")));
+
+        _init(eventProc, disableGrab, useShm, coalesceEvents);
     }
 
     @Override
@@ -296,7 +306,20 @@ final class GtkApplication extends Application implements
 
     private native void _terminateLoop();
 
-    private native void _init(long eventProc, boolean disableGrab);
+    private native void _init(long eventProc, boolean disableGrab, boolean useShm, boolean coalesceEvents);
+
+    private static native void _getEventCounts(long[] counts);
+
+    /**
+     * Returns the number of native events that were merged into a later
+     * event of the same kind, followed by the number of native events that
+     * were delivered to FX windows. Must be called on the event thread.
+     */
+    static long[] getEventCounts() {
+        long[] counts = new long[2];
+        _getEventCounts(counts);
+        return counts;
+    }
 
     private native void _runLoop(Runnable launchable, boolean noErrorTrap);
 
@@ -85,25 +85,33 @@ final class GtkView extends View {
 
     @Override
     protected void _uploadPixels(long ptr, Pixels pixels) {
+        _uploadPixels(ptr, pixels, null);
+    }
+
+    @Override
+    protected void _uploadPixels(long ptr, Pixels pixels, int[] damage) {
+        if (damage != null && damage.length > 4 * MAX_DAMAGE_RECTS) {
+            damage = null;
+        }
         Buffer data = pixels.getPixels();
         if (data.isDirect() == true) {
-            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight(), damage);
         } else if (data.hasArray() == true) {
             if (pixels.getBytesPerComponent() == 1) {
                 ByteBuffer bytes = (ByteBuffer)data;
-                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight(), damage);
             } else {
                 IntBuffer ints = (IntBuffer)data;
-                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight(), damage);
             }
         } else {
             // gznote: what are the circumstances under which this can happen?
-            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight(), damage);
         }
     }
-    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height);
-    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height);
-    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height);
+    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height, int[] damage);
+    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height, int[] damage);
+    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height, int[] damage);
 
     @Override
     protected native boolean _enterFullscreen(long ptr, boolean animate, boolean keepRatio, boolean hideCursor);
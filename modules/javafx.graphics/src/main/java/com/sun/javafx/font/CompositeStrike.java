@@ -163,6 +163,39 @@ public class CompositeStrike implements FontStrike {
         return getStrikeSlot(slot).getGlyph(slotglyphCode);
     }
 
+    @Override
+    public void prepareGlyphs(GlyphList gl, int start, GlyphSink sink) {
+        int count = gl.getGlyphCount() - start;
+        if (count <= 0) return;
+        int[] glyphCodes = new int[count];
+        int[] slotCodes = null;
+        int nextSlot = 0;
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = gl.getGlyphCode(start + i);
+        }
+        /* Hand each slot strike the glyphs it renders, one slot at a time */
+        while (nextSlot >= 0) {
+            int slot = nextSlot;
+            int n = 0;
+            nextSlot = -1;
+            for (int i = 0; i < count; i++) {
+                int glyphSlot = glyphCodes[i] >>> 24;
+                if (glyphSlot == slot) {
+                    if (slotCodes == null) {
+                        slotCodes = new int[count];
+                    }
+                    slotCodes[n++] = glyphCodes[i];
+                } else if (glyphSlot > slot &&
+                           (nextSlot < 0 || glyphSlot < nextSlot)) {
+                    nextSlot = glyphSlot;
+                }
+            }
+            if (n > 0) {
+                getStrikeSlot(slot).prepareGlyphs(slotCodes, n, sink);
+            }
+        }
+    }
+
      /**
      * Access to individual character advances are frequently needed for layout
      * understand that advance may vary for single glyph if ligatures or kerning
@@ -28,6 +28,9 @@ package com.sun.javafx.font;
 import java.io.File;
 import java.io.FileInputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 
@@ -42,6 +45,7 @@ class FontConfigManager {
     static boolean useFontConfig = true;
     static boolean fontConfigFailed = false;
     static boolean useEmbeddedFontSupport = false;
+    static boolean useFontConfigCache = true;
 
     static {
         AccessController.doPrivileged(
@@ -52,6 +56,8 @@ class FontConfigManager {
                     useFontConfig = "true".equals(ufc);
                     String emb = System.getProperty("prism.embeddedfonts", "");
                     useEmbeddedFontSupport = "true".equals(emb);
+                    String ufcc = System.getProperty("prism.useFontConfigCache", "true");
+                    useFontConfigCache = "true".equals(ufcc);
                     return null;
                 }
         );
@@ -229,6 +235,90 @@ class FontConfigManager {
          HashMap<String,ArrayList<String>> familyToFontListMap,
          Locale locale);
 
+    /* Returns the fontconfig enumeration, read from the cache file when it
+     * is up to date, see fontpath_linux.c for the layout. The buffer maps
+     * native memory and must be released with freeFontListNative().
+     */
+    private static native ByteBuffer getFontListNative(String cachePath);
+    private static native void freeFontListNative(ByteBuffer fontList);
+
+    private static final String FONTCONFIG_CACHE_MAGIC = "JFXFCC01";
+
+    private static String getFontConfigCachePath() {
+        String dir = System.getenv("XDG_CACHE_HOME");
+        if (dir == null || dir.isEmpty()) {
+            dir = System.getProperty("user.home") + File.separator + ".cache";
+        }
+        String user = System.getProperty("user.name", "");
+        return dir + File.separator + "openjfx" + File.separator +
+               "fontconfig-" + user + ".cache";
+    }
+
+    private static String getCachedString(ByteBuffer buffer, byte[] bytes) {
+        int length = buffer.getInt();
+        if (length < 0 || length > buffer.remaining()) {
+            throw new IllegalStateException("Corrupted fontconfig cache");
+        }
+        buffer.get(bytes, 0, length);
+        return new String(bytes, 0, length, StandardCharsets.UTF_8);
+    }
+
+    private static boolean populateMapsFromCache
+        (HashMap<String,String> fontToFileMap,
+         HashMap<String,String> fontToFamilyNameMap,
+         HashMap<String,ArrayList<String>> familyToFontListMap,
+         Locale locale) {
+
+        long t0 = debugFonts ? System.nanoTime() : 0;
+        String cachePath = AccessController.doPrivileged(
+                (PrivilegedAction<String>) () -> getFontConfigCachePath());
+        ByteBuffer fontList = getFontListNative(cachePath);
+        if (fontList == null) {
+            return false;
+        }
+        try {
+            ByteBuffer buffer = fontList.duplicate().order(ByteOrder.nativeOrder());
+            byte[] bytes = new byte[buffer.remaining()];
+            buffer.get(bytes, 0, FONTCONFIG_CACHE_MAGIC.length());
+            String magic = new String(bytes, 0, FONTCONFIG_CACHE_MAGIC.length(),
+                                      StandardCharsets.US_ASCII);
+            if (!FONTCONFIG_CACHE_MAGIC.equals(magic)) {
+                return false;
+            }
+            int stampLength = buffer.getInt();
+            buffer.position(buffer.position() + stampLength);
+            int count = buffer.getInt();
+            for (int i = 0; i < count; i++) {
+                String file = getCachedString(buffer, bytes);
+                String family = getCachedString(buffer, bytes);
+                String fullName = getCachedString(buffer, bytes);
+                String fullNameLC = fullName.toLowerCase(locale);
+                fontToFileMap.put(fullNameLC, file);
+                fontToFamilyNameMap.put(fullNameLC, family);
+                ArrayList<String> list =
+                    familyToFontListMap.computeIfAbsent(family.toLowerCase(locale),
+                                                        k -> new ArrayList<String>(4));
+                list.add(fullName);
+            }
+            if (debugFonts) {
+                long t1 = System.nanoTime();
+                System.err.println("Read " + count + " fonts from fontconfig cache " +
+                                   cachePath + " in " + ((t1 - t0) / 1000000) + "ms.");
+            }
+            return true;
+        } catch (RuntimeException e) {
+            if (debugFonts) {
+                e.printStackTrace();
+            }
+            fontToFileMap.clear();
+            fontToFamilyNameMap.clear();
+            familyToFontListMap.clear();
+            return false;
+        } finally {
+            freeFontListNative(fontList);
+        }
+    }
+
     public static void populateMaps
         (HashMap<String,String> fontToFileMap,
          HashMap<String,String> fontToFamilyNameMap,
@@ -237,9 +327,14 @@ class FontConfigManager {
 
         boolean pnm = false;
         if (useFontConfig && !fontConfigFailed) {
-            pnm = populateMapsNative(fontToFileMap, fontToFamilyNameMap,
-                                familyToFontListMap, locale);
-
+            if (useFontConfigCache) {
+                pnm = populateMapsFromCache(fontToFileMap, fontToFamilyNameMap,
+                                            familyToFontListMap, locale);
+            }
+            if (!pnm) {
+                pnm = populateMapsNative(fontToFileMap, fontToFamilyNameMap,
+                                         familyToFontListMap, locale);
+            }
         }
 
         if (fontConfigFailed ||
@@ -47,6 +47,22 @@ public interface FontStrike {
     public Metrics getMetrics();
     public Glyph getGlyph(char symbol);
     public Glyph getGlyph(int glyphCode);
+
+    /**
+     * Called before the glyphs of the list, starting at index start, are
+     * requested for rendering. Strikes can use it to rasterize the missing
+     * glyphs in bulk and hand their images to the sink.
+     */
+    public default void prepareGlyphs(GlyphList gl, int start, GlyphSink sink) {
+    }
+
+    /**
+     * Same as {@link #prepareGlyphs(GlyphList, int, GlyphSink)} for the
+     * first count glyph codes of the array. The codes may carry a composite
+     * slot in their high byte, the sink gets them back unchanged.
+     */
+    public default void prepareGlyphs(int[] glyphCodes, int count, GlyphSink sink) {
+    }
     public void clearDesc(); // for cache management.
     public int getAAMode();
 
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.javafx.font;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Receives glyph images rasterized in bulk by
+ * {@link FontStrike#prepareGlyphs}.
+ */
+public interface GlyphSink {
+
+    /**
+     * Called once for each glyph with a visible image. The image is the
+     * glyph width by glyph height area at x, y of the atlas, for the sub
+     * pixel position 0. The atlas is only valid during the call, the sink
+     * must copy the pixels it wants to keep.
+     *
+     * @param glyphCode the glyph code as it was passed to prepareGlyphs
+     * @param glyph the glyph, its metrics are already initialized
+     * @param atlas the buffer holding the glyph image
+     * @param atlasWidth the scanline stride of the atlas, in bytes
+     * @param x the x-offset of the glyph image in the atlas, in bytes
+     * @param y the y-offset of the glyph image in the atlas
+     */
+    public void addGlyph(int glyphCode, Glyph glyph,
+                         ByteBuffer atlas, int atlasWidth, int x, int y);
+}
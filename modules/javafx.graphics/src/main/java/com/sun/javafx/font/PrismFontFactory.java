@@ -739,8 +739,6 @@ public abstract class PrismFontFactory implements FontFactory {
             }
         }
 
-        getFullNameToFileMap(); // init maps
-
         if (name != null && file != null) {
             // Typically the TTC case used in font linking.
             // The called method adds the resources to the physical
@@ -754,6 +752,10 @@ public abstract class PrismFontFactory implements FontFactory {
             }
         }
 
+        // The font linking case above does not need the platform font maps,
+        // so their (expensive) initialization waits until a lookup by name.
+        getFullNameToFileMap(); // init maps
+
         if (name != null) { // Typically normal application lookup
             fr = getFontResourceByFullName(name, wantComp);
             if (fr != null) {
@@ -107,7 +107,10 @@ public class FTFactory extends PrismFontFactory {
         OSFreetype.FT_Done_FreeType(library);
         if (error != 0) return false;
         if (OSFreetype.isPangoEnabled()) {
-            return OSPango.FcConfigAppFontAddFile(0, path);
+            if (!OSPango.FcConfigAppFontAddFile(0, path)) return false;
+            /* Cached runs may have been shaped with a fallback for the
+             * family of the new font */
+            OSPango.pango_shape_cache_clear();
         }
         return true;
     }
@@ -25,9 +25,12 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
+
 import com.sun.javafx.font.Disposer;
 import com.sun.javafx.font.FontResource;
 import com.sun.javafx.font.FontStrikeDesc;
+import com.sun.javafx.font.GlyphSink;
 import com.sun.javafx.font.PrismFontFactory;
 import com.sun.javafx.font.PrismFontFile;
 import com.sun.javafx.font.PrismFontStrike;
@@ -35,6 +38,9 @@ import com.sun.javafx.geom.Path2D;
 import com.sun.javafx.geom.transform.BaseTransform;
 
 class FTFontFile extends PrismFontFile {
+    private static final int ATLAS_MAX_WIDTH = 2048;
+    private static final byte[] EMPTY_BUFFER = new byte[0];
+
     /*
      * Font files can be accessed by several threads. In general this are the
      * JFX thread (measuring) and the Prism thread (rendering). But, if a Text
@@ -117,19 +123,12 @@ class FTFontFile extends PrismFontFile {
         return OSFreetype.FT_Outline_Decompose(face);
     }
 
-    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
+    /* Sets the face size and transform for the strike and returns the load flags */
+    private int setupStrike(FTFontStrike strike, boolean lcd) {
         float size = strike.getSize();
-        if (size == 0) {
-            glyph.buffer = new byte[0];
-            glyph.bitmap = new FT_Bitmap();
-            return;
-        }
         int size26dot6 = (int)(size * 64);
         OSFreetype.FT_Set_Char_Size(face, 0, size26dot6, 72, 72);
 
-        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
-                      FTFactory.LCD_SUPPORT;
-
         int flags = OSFreetype.FT_LOAD_RENDER | OSFreetype.FT_LOAD_NO_HINTING | OSFreetype.FT_LOAD_NO_BITMAP;
         FT_Matrix matrix = strike.matrix;
         if (matrix != null) {
@@ -142,6 +141,19 @@ class FTFontFile extends PrismFontFile {
         } else {
             flags |= OSFreetype.FT_LOAD_TARGET_NORMAL;
         }
+        return flags;
+    }
+
+    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
+        float size = strike.getSize();
+        if (size == 0) {
+            glyph.buffer = new byte[0];
+            glyph.initialized = true;
+            return;
+        }
+        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
+                      FTFactory.LCD_SUPPORT;
+        int flags = setupStrike(strike, lcd);
 
         int glyphCode = glyph.getGlyphCode();
         int error = OSFreetype.FT_Load_Glyph(face, glyphCode, flags);
@@ -198,7 +210,9 @@ class FTFontFile extends PrismFontFile {
         }
 
         glyph.buffer = buffer;
-        glyph.bitmap = bitmap;
+        glyph.width = width;
+        glyph.height = height;
+        glyph.initialized = true;
         glyph.bitmap_left = glyphRec.bitmap_left;
         glyph.bitmap_top = glyphRec.bitmap_top;
         glyph.advanceX = glyphRec.advance_x / 64f;    /* Fixed 26.6*/
@@ -206,4 +220,84 @@ class FTFontFile extends PrismFontFile {
         glyph.userAdvance = glyphRec.linearHoriAdvance / 65536.0f; /* Fixed 16.16 */
         glyph.lcd = lcd;
     }
+
+    /*
+     * Rasterizes several glyphs of the strike with a single native call.
+     * The glyph images are packed into a direct buffer that is reused for
+     * the whole run and handed to the sink while the buffer is valid, the
+     * glyphs only keep their metrics. A glyph asked for its pixels later
+     * rasterizes them again through initGlyph(). Glyphs that can not be
+     * handled here are left uninitialized, they fall back to initGlyph()
+     * when used.
+     */
+    synchronized void initGlyphs(FTGlyph[] glyphs, int[] codes, int count,
+                                 FTFontStrike strike, GlyphSink sink) {
+        float size = strike.getSize();
+        if (size == 0 || count == 0) return;
+        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
+                      FTFactory.LCD_SUPPORT;
+        int flags = setupStrike(strike, lcd);
+
+        int[] glyphCodes = new int[count];
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = glyphs[i].getGlyphCode();
+        }
+        int[] metrics = new int[count * OSFreetype.GLYPH_METRICS_SIZE];
+
+        /* Estimate the cell size from the strike, the atlas only needs
+         * to be large enough for most glyphs. */
+        BaseTransform tx = strike.getTransform();
+        double scale = Math.max(Math.abs(tx.getMxx()) + Math.abs(tx.getMxy()),
+                                Math.abs(tx.getMyx()) + Math.abs(tx.getMyy()));
+        int cellH = (int)Math.ceil(size * scale * 1.5) + 2;
+        int cellW = lcd ? cellH * 3 : cellH;
+
+        ByteBuffer atlas = null;
+        int done = 0;
+        while (done < count) {
+            int remaining = count - done;
+            int columns = (int)Math.ceil(Math.sqrt(remaining));
+            int atlasWidth = Math.max(cellW, Math.min(ATLAS_MAX_WIDTH, columns * cellW));
+            int rows = (remaining + (atlasWidth / cellW) - 1) / (atlasWidth / cellW);
+            int atlasHeight = (rows + 1) * cellH;
+            if (atlas == null || atlas.capacity() < atlasWidth * atlasHeight) {
+                atlas = ByteBuffer.allocateDirect(atlasWidth * atlasHeight);
+            }
+            int n = OSFreetype.rasterizeGlyphs(face, glyphCodes, done, remaining,
+                                               flags, atlas, atlasWidth,
+                                               atlasHeight, metrics);
+            for (int i = 0; i < n; i++) {
+                int m = i * OSFreetype.GLYPH_METRICS_SIZE;
+                int pixelMode = metrics[m + OSFreetype.GM_PIXEL_MODE];
+                if (pixelMode != OSFreetype.FT_PIXEL_MODE_GRAY &&
+                    pixelMode != OSFreetype.FT_PIXEL_MODE_LCD) {
+                    /* Errors and unexpected pixel modes, see initGlyph() */
+                    continue;
+                }
+                FTGlyph glyph = glyphs[done + i];
+                int width = metrics[m + OSFreetype.GM_WIDTH];
+                int height = metrics[m + OSFreetype.GM_HEIGHT];
+                glyph.buffer = width != 0 && height != 0 ? null : EMPTY_BUFFER;
+                glyph.width = width;
+                glyph.height = height;
+                glyph.bitmap_left = metrics[m + OSFreetype.GM_LEFT];
+                glyph.bitmap_top = metrics[m + OSFreetype.GM_TOP];
+                glyph.advanceX = metrics[m + OSFreetype.GM_ADVANCE_X] / 64f;    /* Fixed 26.6*/
+                glyph.advanceY = metrics[m + OSFreetype.GM_ADVANCE_Y] / 64f;
+                glyph.userAdvance = metrics[m + OSFreetype.GM_LINEAR_HORI] / 65536.0f; /* Fixed 16.16 */
+                glyph.lcd = lcd;
+                glyph.initialized = true;
+                if (glyph.buffer == null && sink != null) {
+                    sink.addGlyph(codes[done + i], glyph, atlas, atlasWidth,
+                                  metrics[m + OSFreetype.GM_X],
+                                  metrics[m + OSFreetype.GM_Y]);
+                }
+            }
+            if (n == 0) {
+                /* Nothing fits, leave the remaining glyphs to initGlyph() */
+                break;
+            }
+            done += n;
+        }
+    }
 }
@@ -25,15 +25,20 @@
 
 package com.sun.javafx.font.freetype;
 
+import com.sun.javafx.font.CharToGlyphMapper;
+import com.sun.javafx.font.CompositeGlyphMapper;
 import com.sun.javafx.font.DisposerRecord;
 import com.sun.javafx.font.FontStrikeDesc;
 import com.sun.javafx.font.Glyph;
+import com.sun.javafx.font.GlyphSink;
 import com.sun.javafx.font.PrismFontFactory;
 import com.sun.javafx.font.PrismFontStrike;
 import com.sun.javafx.geom.Path2D;
 import com.sun.javafx.geom.transform.BaseTransform;
+import com.sun.javafx.scene.text.GlyphList;
 
 class FTFontStrike extends PrismFontStrike<FTFontFile> {
+    private static final int MAX_BATCH_SIZE = 256;
     FT_Matrix matrix;
 
     protected FTFontStrike(FTFontFile fontResource, float size,
@@ -83,4 +88,51 @@ class FTFontStrike extends PrismFontStrike<FTFontFile> {
         fontResource.initGlyph(glyph, this);
     }
 
+    @Override
+    public void prepareGlyphs(GlyphList gl, int start, GlyphSink sink) {
+        if (drawShapes) return;
+        int count = gl.getGlyphCount() - start;
+        if (count <= 1) return;
+        int[] glyphCodes = new int[count];
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = gl.getGlyphCode(start + i);
+        }
+        prepareGlyphs(glyphCodes, count, sink);
+    }
+
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count, GlyphSink sink) {
+        if (drawShapes) return;
+        FTGlyph[] glyphs = null;
+        int[] codes = null;
+        int pending = 0;
+        for (int i = 0; i < count; i++) {
+            int glyphCode = glyphCodes[i] & CompositeGlyphMapper.GLYPHMASK;
+            if (glyphCode == CharToGlyphMapper.INVISIBLE_GLYPH_ID) continue;
+            FTGlyph glyph = (FTGlyph)getGlyph(glyphCode);
+            if (glyph.initialized) continue;
+            if (glyphs == null) {
+                glyphs = new FTGlyph[Math.min(count - i, MAX_BATCH_SIZE)];
+                codes = new int[glyphs.length];
+            }
+            /* Glyphs repeat within a run, only queue each one once */
+            boolean queued = false;
+            for (int j = 0; j < pending && !queued; j++) {
+                queued = glyphs[j] == glyph;
+            }
+            if (!queued) {
+                codes[pending] = glyphCodes[i];
+                glyphs[pending++] = glyph;
+                if (pending == glyphs.length) {
+                    getFontResource().initGlyphs(glyphs, codes, pending, this, sink);
+                    pending = 0;
+                }
+            }
+        }
+        /* A single glyph is cheaper through initGlyph() */
+        if (pending > 1) {
+            getFontResource().initGlyphs(glyphs, codes, pending, this, sink);
+        }
+    }
+
 }
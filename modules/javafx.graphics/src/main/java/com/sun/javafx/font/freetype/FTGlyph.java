@@ -33,7 +33,9 @@ class FTGlyph implements Glyph {
     FTFontStrike strike;
     int glyphCode;
     byte[] buffer;
-    FT_Bitmap bitmap;
+    int width;
+    int height;
+    boolean initialized;
     int bitmap_left;
     int bitmap_top;
     float advanceX;
@@ -52,10 +54,20 @@ class FTGlyph implements Glyph {
     }
 
     private void init() {
-        if (bitmap != null) return;
+        if (initialized) return;
         strike.initGlyph(this);
     }
 
+    private byte[] getBuffer() {
+        init();
+        /* Bulk rasterized glyphs hand their image to a glyph cache
+         * and only keep the metrics, rasterize again when asked. */
+        if (buffer == null) {
+            strike.initGlyph(this);
+        }
+        return buffer;
+    }
+
     @Override
     public RectBounds getBBox() {
         float[] bb = new float[4];
@@ -77,14 +89,12 @@ class FTGlyph implements Glyph {
 
     @Override
     public byte[] getPixelData() {
-        init();
-        return buffer;
+        return getBuffer();
     }
 
     @Override
     public byte[] getPixelData(int subPixel) {
-        init();
-        return buffer;
+        return getBuffer();
     }
 
     @Override
@@ -103,13 +113,13 @@ class FTGlyph implements Glyph {
     public int getWidth() {
         init();
         /* Note: In Freetype the width is byte based */
-        return bitmap != null ? bitmap.width : 0;
+        return width;
     }
 
     @Override
     public int getHeight() {
         init();
-        return bitmap != null ? bitmap.rows : 0;
+        return height;
     }
 
     @Override
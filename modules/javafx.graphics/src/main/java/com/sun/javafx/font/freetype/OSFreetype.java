@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import com.sun.glass.utils.NativeLibLoader;
@@ -93,6 +94,20 @@ class OSFreetype {
     static final int FT_LCD_FILTER_LIGHT   = 2;
     static final int FT_LCD_FILTER_LEGACY  = 16;
 
+    /* Layout of the per glyph metrics returned by rasterizeGlyphs() */
+    static final int GM_X           = 0;
+    static final int GM_Y           = 1;
+    static final int GM_WIDTH       = 2;
+    static final int GM_HEIGHT      = 3;
+    static final int GM_LEFT        = 4;
+    static final int GM_TOP         = 5;
+    static final int GM_ADVANCE_X   = 6; /* Fixed 26.6 */
+    static final int GM_ADVANCE_Y   = 7; /* Fixed 26.6 */
+    static final int GM_LINEAR_HORI = 8; /* Fixed 16.16 */
+    static final int GM_PIXEL_MODE  = 9; /* GM_STATUS_ERROR on failure */
+    static final int GLYPH_METRICS_SIZE = 10;
+    static final int GM_STATUS_ERROR = -1;
+
     static final int FT_LOAD_TARGET_MODE(int x) {
         return (x >> 16 ) & 15;
     }
@@ -110,6 +125,9 @@ class OSFreetype {
     static final native void FT_Set_Transform(long face, FT_Matrix matrix, long delta_x, long delta_y);
     static final native FT_GlyphSlotRec getGlyphSlot(long face);
     static final native byte[] getBitmapData(long face);
+    static final native int rasterizeGlyphs(long face, int[] glyphCodes, int offset, int count,
+                                            int load_flags, ByteBuffer atlas, int atlasWidth,
+                                            int atlasHeight, int[] metrics);
     static final native boolean isPangoEnabled();
     static final native boolean isHarfbuzzEnabled();
 }
@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.IntBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import com.sun.glass.utils.NativeLibLoader;
@@ -56,6 +57,15 @@ class OSPango {
     static final int PANGO_WEIGHT_NORMAL = 0x190;
     static final int PANGO_DIRECTION_RTL = 1;
 
+    /* Layout of the buffer filled by pango_shape_into(), followed by
+     * SHAPE_GLYPH_SIZE ints (glyph, width, char index) per glyph. */
+    static final int SHAPE_NUM_GLYPHS = 0;
+    static final int SHAPE_OFFSET = 1;
+    static final int SHAPE_LENGTH = 2;
+    static final int SHAPE_NUM_CHARS = 3;
+    static final int SHAPE_HEADER_SIZE = 4;
+    static final int SHAPE_GLYPH_SIZE = 3;
+
     static final native void pango_context_set_base_dir(long context, int direction);
     static final native long pango_ft2_font_map_new();
     static final native long pango_font_map_create_context(long fontmap);
@@ -77,7 +87,8 @@ class OSPango {
     static final native void pango_attr_list_unref(long list);
     static final native void pango_attr_list_insert(long list, long attr);
     static final native long pango_itemize(long context, long text, int start_index, int length, long attrs, long cached_iter);
-    static final native PangoGlyphString pango_shape(long text, long pangoItem);
+    static final native long pango_shape_into(long text, long pangoItem, IntBuffer buffer);
+    static final native void pango_shape_cache_clear();
     static final native void pango_item_free(long item);
 
     /* Miscellaneous (glib, fontconfig) */
@@ -25,6 +25,11 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.util.Arrays;
+
 import com.sun.javafx.font.CompositeFontResource;
 import com.sun.javafx.font.CompositeGlyphMapper;
 import com.sun.javafx.font.FontResource;
@@ -36,14 +41,11 @@ import com.sun.javafx.text.TextRun;
 
 class PangoGlyphLayout extends GlyphLayout {
 
-    private int getSlot(PGFont font, PangoGlyphString glyphString) {
+    private int getSlot(PGFont font, long fallbackFd) {
         CompositeFontResource fr = (CompositeFontResource)font.getFontResource();
-        long fallbackFont = glyphString.font;
-        long fallbackFd = OSPango.pango_font_describe(fallbackFont);
         String fallbackFamily = OSPango.pango_font_description_get_family(fallbackFd);
         int fallbackStyle = OSPango.pango_font_description_get_style(fallbackFd);
         int fallbackWeight = OSPango.pango_font_description_get_weight(fallbackFd);
-        OSPango.pango_font_description_free(fallbackFd);
         boolean bold = fallbackWeight == OSPango.PANGO_WEIGHT_BOLD;
         boolean italic = fallbackStyle != OSPango.PANGO_STYLE_NORMAL;
 
@@ -77,6 +79,37 @@ class PangoGlyphLayout extends GlyphLayout {
     }
 
     private long str = 0L;
+
+    /* Reused across layouts, a GlyphLayout is only used by one thread at a time */
+    private IntBuffer shapeBuffer;
+    private long fallbackFd = 0L;
+
+    /*
+     * Shapes the item into shapeBuffer, growing it as needed. The font
+     * description of the item is stored in fallbackFd and must be freed
+     * by the caller.
+     */
+    private IntBuffer shape(long pangoItem) {
+        if (shapeBuffer == null) {
+            shapeBuffer = newShapeBuffer(256);
+        }
+        fallbackFd = OSPango.pango_shape_into(str, pangoItem, shapeBuffer);
+        if (fallbackFd == 0L) return null;
+        int numGlyphs = shapeBuffer.get(OSPango.SHAPE_NUM_GLYPHS);
+        if (numGlyphs < 0) {
+            /* Too small, the second attempt is served by the shaping cache */
+            OSPango.pango_font_description_free(fallbackFd);
+            shapeBuffer = newShapeBuffer(-numGlyphs);
+            fallbackFd = OSPango.pango_shape_into(str, pangoItem, shapeBuffer);
+            if (fallbackFd == 0L) return null;
+        }
+        return shapeBuffer;
+    }
+
+    private static IntBuffer newShapeBuffer(int glyphCount) {
+        int size = OSPango.SHAPE_HEADER_SIZE + glyphCount * OSPango.SHAPE_GLYPH_SIZE;
+        return ByteBuffer.allocateDirect(size * 4).order(ByteOrder.nativeOrder()).asIntBuffer();
+    }
     public void layout(TextRun run, PGFont font, FontStrike strike, char[] text) {
 
         /* Create the pango font and attribute list */
@@ -136,56 +169,66 @@ class PangoGlyphLayout extends GlyphLayout {
         long runs = OSPango.pango_itemize(context, str, (int)(start - str), (int)(end - start), attrList, 0);
 
         if (runs != 0) {
-            /* Shape all PangoItem into PangoGlyphString */
+            /* Shape all PangoItem, the results are accumulated in the output arrays */
             int runsCount = OSPango.g_list_length(runs);
-            PangoGlyphString[] pangoGlyphs = new PangoGlyphString[runsCount];
-            for (int i = 0; i < runsCount; i++) {
-                long pangoItem = OSPango.g_list_nth_data(runs, i);
-                if (pangoItem != 0) {
-                    pangoGlyphs[i] = OSPango.pango_shape(str, pangoItem);
-                    OSPango.pango_item_free(pangoItem);
-                }
-            }
-            OSPango.g_list_free(runs);
-
-            int glyphCount = 0;
-            for (PangoGlyphString g : pangoGlyphs) {
-                if (g != null) {
-                    glyphCount += g.num_glyphs;
-                }
-            }
-            int[] glyphs = new int[glyphCount];
-            float[] pos = new float[glyphCount * 2 + 2];
-            int[] indices = new int[glyphCount];
+            int capacity = Math.max(run.getLength(), 1);
+            int[] glyphs = new int[capacity];
+            float[] pos = new float[capacity * 2 + 2];
+            int[] indices = new int[capacity];
             int gi = 0;
             int ci = rtl ? run.getLength() : 0;
             int width = 0;
-            for (PangoGlyphString g : pangoGlyphs) {
-                if (g != null) {
-                    int slot = composite ? getSlot(font, g) : 0;
-                    if (rtl) ci -= g.num_chars;
-                    for (int i = 0; i < g.num_glyphs; i++) {
-                        int gii = gi + i;
-                        if (slot != -1) {
-                            int gg = g.glyphs[i];
-
-                            /* Ignoring any glyphs outside the GLYPHMASK range.
-                             * Note that Pango uses PANGO_GLYPH_EMPTY (0x0FFFFFFF), PANGO_GLYPH_INVALID_INPUT (0xFFFFFFFF),
-                             * and other values with special meaning.
-                             */
-                            if (0 <= gg && gg <= CompositeGlyphMapper.GLYPHMASK) {
-                                glyphs[gii] = (slot << 24) | gg;
-                            }
-                        }
-                        if (size != 0) {
-                            width += g.widths[i];
-                            pos[2 + (gii << 1)] = ((float)width) / OSPango.PANGO_SCALE;
+            for (int r = 0; r < runsCount; r++) {
+                long pangoItem = OSPango.g_list_nth_data(runs, r);
+                if (pangoItem == 0) continue;
+                IntBuffer buffer = shape(pangoItem);
+                OSPango.pango_item_free(pangoItem);
+                if (buffer == null) continue;
+                int numGlyphs = buffer.get(OSPango.SHAPE_NUM_GLYPHS);
+                int numChars = buffer.get(OSPango.SHAPE_NUM_CHARS);
+                int slot = composite ? getSlot(font, fallbackFd) : 0;
+                OSPango.pango_font_description_free(fallbackFd);
+                fallbackFd = 0L;
+                if (numGlyphs == 0) continue;
+
+                if (gi + numGlyphs > capacity) {
+                    capacity = Math.max(capacity * 2, gi + numGlyphs);
+                    glyphs = Arrays.copyOf(glyphs, capacity);
+                    pos = Arrays.copyOf(pos, capacity * 2 + 2);
+                    indices = Arrays.copyOf(indices, capacity);
+                }
+                if (rtl) ci -= numChars;
+                int bi = OSPango.SHAPE_HEADER_SIZE;
+                for (int i = 0; i < numGlyphs; i++) {
+                    int gii = gi + i;
+                    if (slot != -1) {
+                        int gg = buffer.get(bi);
+
+                        /* Ignoring any glyphs outside the GLYPHMASK range.
+                         * Note that Pango uses PANGO_GLYPH_EMPTY (0x0FFFFFFF), PANGO_GLYPH_INVALID_INPUT (0xFFFFFFFF),
+                         * and other values with special meaning.
+                         */
+                        if (0 <= gg && gg <= CompositeGlyphMapper.GLYPHMASK) {
+                            glyphs[gii] = (slot << 24) | gg;
                         }
-                        indices[gii] = g.log_clusters[i] + ci;
                     }
-                    if (!rtl) ci += g.num_chars;
-                    gi += g.num_glyphs;
+                    if (size != 0) {
+                        width += buffer.get(bi + 1);
+                        pos[2 + (gii << 1)] = ((float)width) / OSPango.PANGO_SCALE;
+                    }
+                    indices[gii] = buffer.get(bi + 2) + ci;
+                    bi += OSPango.SHAPE_GLYPH_SIZE;
                 }
+                if (!rtl) ci += numChars;
+                gi += numGlyphs;
+            }
+            OSPango.g_list_free(runs);
+
+            int glyphCount = gi;
+            if (glyphCount != capacity) {
+                glyphs = Arrays.copyOf(glyphs, glyphCount);
+                pos = Arrays.copyOf(pos, glyphCount * 2 + 2);
+                indices = Arrays.copyOf(indices, glyphCount);
             }
             run.shape(glyphCount, glyphs, pos, indices);
         }
@@ -177,7 +177,12 @@ final class UploadingPainter extends ViewPainter implements Runnable {
                 /* transparent pixels created and ready for upload */
                 // Copy references, which are volatile, used by upload. Thus
                 // ensure they still exist once event queue is consumed.
-                pixelSource.enqueuePixels(pix);
+                if (rtt == rttexture) {
+                    pixelSource.enqueuePixels(pix, sceneState.getDamageRects(),
+                                              sceneState.getDamageCount());
+                } else {
+                    pixelSource.enqueuePixels(pix);
+                }
                 sceneState.uploadPixels(pixelSource);
             }
 
@@ -103,6 +103,9 @@ abstract class ViewPainter implements Runnable {
     private RectBounds dirtyRegionTemp;
     private DirtyRegionPool dirtyRegionPool;
     private DirtyRegionContainer dirtyRegionContainer;
+    // The painted dirty rectangles in device pixels, handed to the scene state
+    // so that only those parts of the frame need to be presented
+    private int[] damageRects;
     private Affine3D tx;
     private Affine3D scaleTx;
     private GeneralTransform3D viewProjTx;
@@ -136,6 +139,7 @@ abstract class ViewPainter implements Runnable {
             scaleTx = new Affine3D();
             clip = new RectBounds();
             dirtyRect = new Rectangle();
+            damageRects = new int[4 * PrismSettings.dirtyRegionCount];
             dirtyRegionTemp = new RectBounds();
             dirtyRegionPool = new DirtyRegionPool(PrismSettings.dirtyRegionCount);
             dirtyRegionContainer = dirtyRegionPool.checkOut();
@@ -166,6 +170,7 @@ abstract class ViewPainter implements Runnable {
         // We should not be painting anything with a width / height
         // that is <= 0, so we might as well bail right off.
         if (width <= 0 || height <= 0 || backBufferGraphics == null) {
+            sceneState.setDamage(null, 0);
             root.renderForcedContent(backBufferGraphics);
             return;
         }
@@ -304,6 +309,7 @@ abstract class ViewPainter implements Runnable {
             }
 
             // Paint each dirty region
+            int damageCount = 0;
             for (int i = 0; i < dirtyRegionSize; ++i) {
                 final RectBounds dirtyRegion = dirtyRegionContainer.getDirtyRegion(i);
                 // TODO it should be impossible to have ever created a dirty region that was empty...
@@ -319,9 +325,26 @@ abstract class ViewPainter implements Runnable {
                     g.setClipRect(dirtyRect);
                     g.setClipRectIndex(i);
                     doPaint(g, getRootPath(i));
+                    damageRects[4 * damageCount]     = dirtyRect.x;
+                    damageRects[4 * damageCount + 1] = dirtyRect.y;
+                    damageRects[4 * damageCount + 2] = dirtyRect.width;
+                    damageRects[4 * damageCount + 3] = dirtyRect.height;
+                    damageCount++;
                 }
             }
+            // The dirty rectangles are only valid for the presented frame when
+            // it is not rescaled on its way to the screen and nothing is drawn
+            // on top of the whole scene
+            if (!showDirtyOpts &&
+                sceneState.getOutputScaleX() == pixelScaleX &&
+                sceneState.getOutputScaleY() == pixelScaleY)
+            {
+                sceneState.setDamage(damageRects, damageCount);
+            } else {
+                sceneState.setDamage(null, 0);
+            }
         } else {
+            sceneState.setDamage(null, 0);
             // There are no dirty regions, so just paint everything
             g.setHasPreCullingBits(false);
             g.setClipRect(null);
@@ -47,6 +47,21 @@ public interface PixelSource {
      */
     public Pixels getLatestPixels();
 
+    /**
+     * Gets the areas of the {@code Pixels} last returned by
+     * {@link #getLatestPixels()} which changed since the {@code Pixels}
+     * consumed before it.
+     * This method is called by the consumer of Pixels objects, between
+     * the calls to {@code getLatestPixels()} and
+     * {@link #doneWithPixels(com.sun.glass.ui.Pixels) doneWithPixels()}.
+     *
+     * @return the changed areas as (x, y, width, height) quadruples, or null
+     *         if the entire frame must be treated as changed
+     */
+    public default int[] getLatestDamage() {
+        return null;
+    }
+
     /**
      * Indicates that the specified non-null {@code Pixels} object which was
      * obtained from {@link #getLatestPixels()} is done being processed and
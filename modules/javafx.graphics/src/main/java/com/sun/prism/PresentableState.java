@@ -65,6 +65,9 @@ public abstract class PresentableState {
     // to shortcut the queued *Painter task.
     protected boolean isClosed;
     protected final int pixelFormat = Pixels.getNativeFormat();
+    // Areas changed by the most recently painted frame
+    protected int[] damageRects;
+    protected int damageCount;
 
     /** Create a PresentableState based on a View.
      *
@@ -296,6 +299,41 @@ public abstract class PresentableState {
         if (view != null) view.unlock();
     }
 
+    /**
+     * Records the areas changed by the frame that was just painted.
+     * The array is not copied and is only valid until the next frame is
+     * painted.
+     *
+     * @param rects the changed areas as (x, y, width, height) quadruples in
+     *        output pixels, or null if the entire frame changed
+     * @param count the number of rectangles in {@code rects}
+     *
+     * Must be called on Prism renderer thread.
+     */
+    public void setDamage(int[] rects, int count) {
+        damageRects = rects;
+        damageCount = count;
+    }
+
+    /**
+     * @return the areas changed by the most recently painted frame, or null
+     * if the entire frame changed
+     *
+     * Must be called on Prism renderer thread.
+     */
+    public int[] getDamageRects() {
+        return damageRects;
+    }
+
+    /**
+     * @return the number of rectangles returned by {@link #getDamageRects()}
+     *
+     * Must be called on Prism renderer thread.
+     */
+    public int getDamageCount() {
+        return damageCount;
+    }
+
     /**
      * Put the pixels on the screen.
      *
@@ -305,7 +343,7 @@ public abstract class PresentableState {
         Pixels pixels = source.getLatestPixels();
         if (pixels != null) {
             try {
-                view.uploadPixels(pixels);
+                view.uploadPixels(pixels, source.getLatestDamage());
             } finally {
                 source.doneWithPixels(pixels);
             }
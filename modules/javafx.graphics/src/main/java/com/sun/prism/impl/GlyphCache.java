@@ -30,6 +30,7 @@ import com.sun.javafx.font.CompositeGlyphMapper;
 import com.sun.javafx.font.FontResource;
 import com.sun.javafx.font.FontStrike;
 import com.sun.javafx.font.Glyph;
+import com.sun.javafx.font.GlyphSink;
 import com.sun.javafx.geom.BaseBounds;
 import com.sun.javafx.geom.Rectangle;
 import com.sun.javafx.geom.Point2D;
@@ -37,7 +38,6 @@ import com.sun.javafx.geom.transform.BaseTransform;
 import com.sun.javafx.scene.text.GlyphList;
 import com.sun.prism.impl.packrect.RectanglePacker;
 import com.sun.prism.Texture;
-import com.sun.prism.impl.shape.MaskData;
 import com.sun.prism.paint.Color;
 
 import java.nio.ByteBuffer;
@@ -80,6 +80,8 @@ public class GlyphCache {
 
     private boolean isLCDCache;
 
+    private final GlyphSink glyphSink = this::addPreparedGlyph;
+
     /* Share a RectanglePacker and its associated texture cache
      * for all uses on a particular screen.
      */
@@ -132,6 +134,7 @@ public class GlyphCache {
         int len = gl.getGlyphCount();
         Color currentColor = null;
         Point2D pt = new Point2D();
+        boolean prepared = false;
 
         for (int gi = 0; gi < len; gi++) {
             int gc = gl.getGlyphCode(gi);
@@ -145,7 +148,16 @@ public class GlyphCache {
             pt.setLocation(x + gl.getPosX(gi), y + gl.getPosY(gi));
             xform.transform(pt, pt);
             int subPixel = strike.getQuantizedPosition(pt);
-            GlyphData data = getCachedGlyph(gc, subPixel);
+            GlyphData data = lookupCachedGlyph(gc, subPixel);
+            if (data == null) {
+                // Give the strike a chance to rasterize the remaining
+                // glyphs of the list in bulk on the first cache miss.
+                if (!prepared) {
+                    strike.prepareGlyphs(gl, gi, glyphSink);
+                    prepared = true;
+                }
+                data = getCachedGlyph(gc, subPixel);
+            }
             if (data != null) {
                 if (clip != null) {
                     // Always check clipping using user space.
@@ -237,22 +249,35 @@ public class GlyphCache {
         packer.clear();
     }
 
-    private GlyphData getCachedGlyph(int glyphCode, int subPixel) {
+    private GlyphData[] getSegment(int glyphCode, int subPixel, boolean create) {
         int segIndex = glyphCode >> SEGSHIFT;
-        int subIndex = glyphCode % SEGSIZE;
         segIndex |= (subPixel << SUBPIXEL_SHIFT);
         GlyphData[] segment = glyphDataMap.get(segIndex);
-        if (segment != null) {
-            if (segment[subIndex] != null) {
-                return segment[subIndex];
-            }
-        } else {
+        if (segment == null && create) {
             segment = new GlyphData[SEGSIZE];
             glyphDataMap.put(segIndex, segment);
         }
+        return segment;
+    }
+
+    private GlyphData lookupCachedGlyph(int glyphCode, int subPixel) {
+        GlyphData[] segment = getSegment(glyphCode, subPixel, false);
+        return segment != null ? segment[glyphCode % SEGSIZE] : null;
+    }
+
+    private void putCachedGlyph(int glyphCode, int subPixel, GlyphData data) {
+        // Look the segment up after the upload, adding the glyph may have
+        // cleared the whole cache.
+        getSegment(glyphCode, subPixel, true)[glyphCode % SEGSIZE] = data;
+    }
+
+    private GlyphData getCachedGlyph(int glyphCode, int subPixel) {
+        GlyphData data = lookupCachedGlyph(glyphCode, subPixel);
+        if (data != null) {
+            return data;
+        }
 
         // Render the glyph and insert it in the cache
-        GlyphData data = null;
         Glyph glyph = strike.getGlyph(glyphCode);
         if (glyph != null) {
             byte[] glyphImage = glyph.getPixelData(subPixel);
@@ -262,76 +287,98 @@ public class GlyphCache {
                                      glyph.getPixelYAdvance(),
                                      null);
             } else {
-                // Rasterize the glyph
-                // NOTE : if the MaskData can be stored back directly
-                // in the glyph, even as an opaque type, it should save
-                // repeated work next time the glyph is used.
-                MaskData maskData = MaskData.create(glyphImage,
-                                                    glyph.getOriginX(),
-                                                    glyph.getOriginY(),
-                                                    glyph.getWidth(),
-                                                    glyph.getHeight());
-
-                // Make room for the rectangle on the backing store
-                int border = 1;
-                int rectW = maskData.getWidth()  + (2 * border);
-                int rectH = maskData.getHeight() + (2 * border);
-                int originX = maskData.getOriginX();
-                int originY = maskData.getOriginY();
-                Rectangle rect = new Rectangle(0, 0, rectW, rectH);
-                data = new GlyphData(originX, originY, border,
-                                     glyph.getPixelXAdvance(),
-                                     glyph.getPixelYAdvance(),
-                                     rect);
-
-                if (!packer.add(rect)) {
-                    if (PULSE_LOGGING_ENABLED) {
-                        PulseLogger.incrementCounter("Font Glyph Cache Cleared");
-                    }
-                    // If add fails,clear up the cache. Try add again.
-                    clearAll();
-                    packer.add(rect);
-                }
-
-                // We always pass skipFlush=true to backingStore.update()
-                // since we are in control of the contents of the backingStore
-                // texture and explicitly flush the vertex buffer only when
-                // it is truly needed.
-                boolean skipFlush = true;
-
-                // Upload the an empty byte array to ensure the boundary
-                // area is filled with zeros. Note that the rectangle
-                // is already padded on each edge.
-                Texture backingStore = getBackingStore();
-                int emw = rect.width;
-                int emh = rect.height;
-                int bpp = backingStore.getPixelFormat().getBytesPerPixelUnit();
-                int stride = emw * bpp;
-                int size = stride * emh;
-                if (emptyMask == null || size > emptyMask.capacity()) {
-                    emptyMask = BufferUtil.newByteBuffer(size);
-                }
-                // try/catch is a precaution against not fitting into the store.
-                try {
-                    backingStore.update(emptyMask,
-                                        backingStore.getPixelFormat(),
-                                        rect.x, rect.y,
-                                        0, 0, emw, emh, stride,
-                                        skipFlush);
-                } catch (Exception e) {
-                    e.printStackTrace();
+                int bpp = getBackingStore().getPixelFormat().getBytesPerPixelUnit();
+                data = uploadGlyph(glyph, ByteBuffer.wrap(glyphImage), 0, 0,
+                                   glyph.getWidth() * bpp);
+                if (data == null) {
                     return null;
                 }
-                // Upload the glyph
-                maskData.uploadToTexture(backingStore,
-                                         border + rect.x,
-                                         border + rect.y,
-                                         skipFlush);
+            }
+            putCachedGlyph(glyphCode, subPixel, data);
+        }
 
+        return data;
+    }
+
+    /*
+     * Receives the glyphs the strike rasterized in bulk and copies them
+     * from the strike's atlas straight into the backing store.
+     */
+    private void addPreparedGlyph(int glyphCode, Glyph glyph,
+                                  ByteBuffer atlas, int atlasWidth,
+                                  int x, int y) {
+        if (lookupCachedGlyph(glyphCode, 0) != null) {
+            return;
+        }
+        GlyphData data = uploadGlyph(glyph, atlas, x, y, atlasWidth);
+        if (data != null) {
+            putCachedGlyph(glyphCode, 0, data);
+        }
+    }
+
+    /*
+     * Makes room for the glyph on the backing store and uploads its image,
+     * which is the glyph width by glyph height area at srcx, srcy of the
+     * pixels buffer.
+     */
+    private GlyphData uploadGlyph(Glyph glyph, ByteBuffer pixels,
+                                  int srcx, int srcy, int srcscan) {
+        // Make room for the rectangle on the backing store
+        int border = 1;
+        int width = glyph.getWidth();
+        int height = glyph.getHeight();
+        int rectW = width  + (2 * border);
+        int rectH = height + (2 * border);
+        Rectangle rect = new Rectangle(0, 0, rectW, rectH);
+        GlyphData data = new GlyphData(glyph.getOriginX(), glyph.getOriginY(),
+                                       border,
+                                       glyph.getPixelXAdvance(),
+                                       glyph.getPixelYAdvance(),
+                                       rect);
+
+        if (!packer.add(rect)) {
+            if (PULSE_LOGGING_ENABLED) {
+                PulseLogger.incrementCounter("Font Glyph Cache Cleared");
             }
-            segment[subIndex] = data;
+            // If add fails,clear up the cache. Try add again.
+            clearAll();
+            packer.add(rect);
         }
 
+        // We always pass skipFlush=true to backingStore.update()
+        // since we are in control of the contents of the backingStore
+        // texture and explicitly flush the vertex buffer only when
+        // it is truly needed.
+        boolean skipFlush = true;
+
+        // Upload the an empty byte array to ensure the boundary
+        // area is filled with zeros. Note that the rectangle
+        // is already padded on each edge.
+        Texture backingStore = getBackingStore();
+        int emw = rect.width;
+        int emh = rect.height;
+        int bpp = backingStore.getPixelFormat().getBytesPerPixelUnit();
+        int stride = emw * bpp;
+        int size = stride * emh;
+        if (emptyMask == null || size > emptyMask.capacity()) {
+            emptyMask = BufferUtil.newByteBuffer(size);
+        }
+        // try/catch is a precaution against not fitting into the store.
+        try {
+            backingStore.update(emptyMask,
+                                backingStore.getPixelFormat(),
+                                rect.x, rect.y,
+                                0, 0, emw, emh, stride,
+                                skipFlush);
+        } catch (Exception e) {
+            e.printStackTrace();
+            return null;
+        }
+        // Upload the glyph
+        backingStore.update(pixels, backingStore.getPixelFormat(),
+                            border + rect.x, border + rect.y,
+                            srcx, srcy, width, height, srcscan,
+                            skipFlush);
         return data;
     }
 
@@ -27,10 +27,12 @@ package com.sun.prism.impl;
 
 import com.sun.glass.ui.Application;
 import com.sun.glass.ui.Pixels;
+import com.sun.glass.ui.View;
 import com.sun.prism.PixelSource;
 import java.lang.ref.WeakReference;
 import java.nio.IntBuffer;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
 
 /**
@@ -57,6 +59,10 @@ import java.util.List;
  * get really bad with multiple deliveries enqueued during the processing
  * of a single earlier delivery will we end up with three sets of
  * {@code Pixels} objects in play.
+ * <p>
+ * The areas changed by each delivery are accumulated until the consumer
+ * picks up the latest {@code Pixels}, so that deliveries which were
+ * superseded in the queue still have their changes presented.
  */
 public class QueuedPixelSource implements PixelSource {
     private volatile Pixels beingConsumed;
@@ -65,6 +71,13 @@ public class QueuedPixelSource implements PixelSource {
          new ArrayList<WeakReference<Pixels>>(3);
     private final boolean useDirectBuffers;
 
+    // (x, y, width, height) quadruples changed since the consumer last took
+    // pixels, a negative count means the entire frame changed
+    private final int[] pendingDamage = new int[4 * View.MAX_DAMAGE_RECTS];
+    private int pendingDamageCount = -1;
+    private int[] consumedDamage;
+    private int consumedWidth, consumedHeight;
+
     public QueuedPixelSource(boolean useDirectBuffers) {
         this.useDirectBuffers = useDirectBuffers;
     }
@@ -77,16 +90,32 @@ public class QueuedPixelSource implements PixelSource {
         if (enqueued != null) {
             beingConsumed = enqueued;
             enqueued = null;
+            int w = beingConsumed.getWidthUnsafe();
+            int h = beingConsumed.getHeightUnsafe();
+            if (pendingDamageCount < 0 || w != consumedWidth || h != consumedHeight) {
+                consumedDamage = null;
+            } else {
+                consumedDamage = Arrays.copyOf(pendingDamage, 4 * pendingDamageCount);
+            }
+            pendingDamageCount = 0;
+            consumedWidth = w;
+            consumedHeight = h;
         }
         return beingConsumed;
     }
 
+    @Override
+    public synchronized int[] getLatestDamage() {
+        return consumedDamage;
+    }
+
     @Override
     public synchronized void doneWithPixels(Pixels used) {
         if (beingConsumed != used) {
             throw new IllegalStateException("wrong pixels buffer: "+used+" != "+beingConsumed);
         }
         beingConsumed = null;
+        consumedDamage = null;
     }
 
     @Override
@@ -170,6 +199,29 @@ public class QueuedPixelSource implements PixelSource {
      * @param pixels the {@code Pixels} object to be enqueued
      */
     public synchronized void enqueuePixels(Pixels pixels) {
+        enqueuePixels(pixels, null, 0);
+    }
+
+    /**
+     * Place the indicated {@code Pixels} object into the enqueued state,
+     * recording which areas of it changed since the previously enqueued
+     * object.
+     *
+     * @param pixels the {@code Pixels} object to be enqueued
+     * @param rects the changed areas as (x, y, width, height) quadruples,
+     *        or null if the entire frame changed
+     * @param count the number of rectangles in {@code rects}
+     */
+    public synchronized void enqueuePixels(Pixels pixels, int[] rects, int count) {
         enqueued = pixels;
+        if (pendingDamageCount < 0) {
+            return;
+        }
+        if (rects == null || pendingDamageCount + count > View.MAX_DAMAGE_RECTS) {
+            pendingDamageCount = -1;
+            return;
+        }
+        System.arraycopy(rects, 0, pendingDamage, 4 * pendingDamageCount, 4 * count);
+        pendingDamageCount += count;
     }
 }
@@ -70,7 +70,7 @@ final class SWPresentable extends SWRTTexture implements Presentable {
     }
 
     public boolean present() {
-        pixelSource.enqueuePixels(pixels);
+        pixelSource.enqueuePixels(pixels, pState.getDamageRects(), pState.getDamageCount());
         pState.uploadPixels(pixelSource);
         return true;
     }
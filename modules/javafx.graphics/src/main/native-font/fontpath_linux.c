@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
@@ -518,6 +519,103 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
 }
 
 
+/*
+ * Returns the file and the English family and full names of a font listed by
+ * FcFontList(), or false if the font is not usable by JavaFX. The returned
+ * file is stored in pathname, the names are owned by the pattern.
+ */
+static jboolean getFontNames(FcPatternGetStringFuncType FcPatternGetString,
+                             FcPattern *fp, char *pathname,
+                             FcChar8 **fileOut, FcChar8 **familyOut,
+                             FcChar8 **fullNameOut, jboolean debugFC)
+{
+    int n=0, done=0;
+    FcChar8 *family = NULL;
+    FcChar8 *familyEN = NULL;
+    FcChar8 *familyLang = NULL;
+    FcChar8 *fullName = NULL;
+    FcChar8 *fullNameEN = NULL;
+    FcChar8 *fullNameLang = NULL;
+    FcChar8 *file;
+    FcChar8 *format = NULL;
+
+    /* We only want TrueType & OpenType fonts for Java FX */
+    if ((*FcPatternGetString)(fp, FC_FONTFORMAT, 0, &format)
+        != FcResultMatch) {
+        return JNI_FALSE;
+    }
+    if (format == NULL ||
+        ((strcmp((char*)format, "TrueType") != 0) &&
+         (strcmp((char*)format, "CFF") != 0))) {
+        return JNI_FALSE;
+    }
+    if ((*FcPatternGetString)(fp, FC_FILE, 0, &file) != FcResultMatch) {
+        return JNI_FALSE;
+    } else {
+        char* path = realpath((char*)file, pathname);
+        if (path == NULL) {
+            return JNI_FALSE;
+        } else {
+            file = (FcChar8*)path;
+        }
+    }
+    while (!done) {
+        family = NULL;
+        familyLang = NULL;
+        fullName = NULL;
+        fullNameLang = NULL;
+
+        if (((*FcPatternGetString)(fp, FC_FAMILY, n, &family)
+            == FcResultMatch) &&
+            ((*FcPatternGetString)(fp, FC_FAMILYLANG, n, &familyLang)
+            == FcResultMatch) &&
+            (family != NULL && familyLang != NULL) &&
+            (familyEN == NULL || (strcmp((char*)familyLang, "en") == 0)))
+        {
+            familyEN = family;
+        }
+        if (((*FcPatternGetString)(fp, FC_FULLNAME, n, &fullName)
+            == FcResultMatch) &&
+            ((*FcPatternGetString)(fp, FC_FULLNAMELANG, n, &fullNameLang)
+            == FcResultMatch) &&
+            (fullName != NULL && fullNameLang != NULL) &&
+            (fullNameEN == NULL ||
+             (strcmp((char*)fullNameLang,"en") == 0)))
+        {
+            fullNameEN = fullName;
+        }
+        if (family == NULL && fullName == NULL) {
+            done = 1;
+            break;
+        }
+        n++;
+    }
+
+    if (debugFC) {
+        fprintf(stderr,"Read FC font family=%s fullname=%s file=%s\n",
+                (familyEN == NULL) ? "null" : (char*)familyEN,
+                (fullNameEN == NULL) ? "null" : (char*)fullNameEN,
+                (file == NULL) ? "null" : (char*)file);
+        fflush(stderr);
+    }
+
+    /* We set the names from the first found names for a font, updating
+     * to the English ones as they are found. If these are null
+     * we must not have found any name, so we'd better skip.
+     */
+    if (familyEN == NULL || fullNameEN == NULL || file == NULL) {
+        if (debugFC) {
+            fprintf(stderr,"FC: Skipping on error for above font\n");
+            fflush(stderr);
+        }
+        return JNI_FALSE;
+    }
+    *fileOut = file;
+    *familyOut = familyEN;
+    *fullNameOut = fullNameEN;
+    return JNI_TRUE;
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
 (JNIEnv *env, jclass obj,
@@ -647,95 +745,19 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
     }
 
     for (f=0; f < fontSet->nfont; f++) {
-        int n=0, done=0;
         FcPattern *fp = fontSet->fonts[f];
 
-        FcChar8 *family = NULL;
-        FcChar8 *familyEN = NULL;
-        FcChar8 *familyLang = NULL;
-        FcChar8 *fullName = NULL;
-        FcChar8 *fullNameEN = NULL;
-        FcChar8 *fullNameLang = NULL;
         FcChar8 *file;
-        FcResult res;
+        FcChar8 *familyEN;
+        FcChar8 *fullNameEN;
+        char pathname[PATH_MAX+1];
         jstring jFileStr;
         jstring jFamilyStr, jFamilyStrLC;
         jstring jFullNameStr, jFullNameStrLC;
         jobject jList;
-        FcChar8 *format = NULL;
 
-        /* We only want TrueType & OpenType fonts for Java FX */
-        format = NULL;
-        if ((*FcPatternGetString)(fp, FC_FONTFORMAT, 0, &format)
-            != FcResultMatch) {
-            continue;
-        }
-        if (format == NULL ||
-            ((strcmp((char*)format, "TrueType") != 0) &&
-             (strcmp((char*)format, "CFF") != 0))) {
-            continue;
-        }
-        if ((*FcPatternGetString)(fp, FC_FILE, 0, &file) != FcResultMatch) {
-            continue;
-        } else {
-            char pathname[PATH_MAX+1];
-            char* path = realpath((char*)file, pathname);
-            if (path == NULL) {
-                continue;
-            } else {
-                file = (FcChar8*)path;
-            }
-        }
-        n=0;
-        while (!done) {
-            family = NULL;
-            familyLang = NULL;
-            fullName = NULL;
-            fullNameLang = NULL;
-
-            if (((*FcPatternGetString)(fp, FC_FAMILY, n, &family)
-                == FcResultMatch) &&
-                ((*FcPatternGetString)(fp, FC_FAMILYLANG, n, &familyLang)
-                == FcResultMatch) &&
-                (family != NULL && familyLang != NULL) &&
-                (familyEN == NULL || (strcmp((char*)familyLang, "en") == 0)))
-            {
-                familyEN = family;
-            }
-            if (((*FcPatternGetString)(fp, FC_FULLNAME, n, &fullName)
-                == FcResultMatch) &&
-                ((*FcPatternGetString)(fp, FC_FULLNAMELANG, n, &fullNameLang)
-                == FcResultMatch) &&
-                (fullName != NULL && fullNameLang != NULL) &&
-                (fullNameEN == NULL ||
-                 (strcmp((char*)fullNameLang,"en") == 0)))
-            {
-                fullNameEN = fullName;
-            }
-            if (family == NULL && fullName == NULL) {
-                done = 1;
-                break;
-            }
-            n++;
-        }
-
-        if (debugFC) {
-            fprintf(stderr,"Read FC font family=%s fullname=%s file=%s\n",
-                    (familyEN == NULL) ? "null" : (char*)familyEN,
-                    (fullNameEN == NULL) ? "null" : (char*)fullNameEN,
-                    (file == NULL) ? "null" : (char*)file);
-            fflush(stderr);
-        }
-
-        /* We set the names from the first found names for a font, updating
-         * to the English ones as they are found. If these are null
-         * we must not have found any name, so we'd better skip.
-         */
-        if (familyEN == NULL || fullNameEN == NULL || file == NULL) {
-            if (debugFC) {
-                fprintf(stderr,"FC: Skipping on error for above font\n");
-                fflush(stderr);
-            }
+        if (!getFontNames(FcPatternGetString, fp, pathname,
+                          &file, &familyEN, &fullNameEN, debugFC)) {
             continue;
         }
 
@@ -825,4 +847,432 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
 }
 
 
+/*
+ * Persistent cache of the fontconfig enumeration done by populateMapsNative.
+ *
+ * The cache file holds, after a header, the file, family and full name of
+ * every usable font as length prefixed UTF-8 strings. It is validated against
+ * a stamp built from the modification times of the fontconfig configuration
+ * files, cache and font directories, so a valid cache is used without initializing
+ * fontconfig. The file is memory mapped and handed to Java as a direct
+ * ByteBuffer, which FontConfigManager parses without any JNI call per font.
+ *
+ * Layout (native byte order):
+ *   char[8] magic, int stampLength, char[stampLength] stamp, int count,
+ *   count * { int length, char[length] file,
+ *             int length, char[length] family,
+ *             int length, char[length] fullName }
+ */
+#define FC_CACHE_MAGIC "JFXFCC01"
+#define FC_CACHE_MAGIC_LENGTH 8
+
+typedef int (*FcGetVersionFuncType)();
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+    jboolean failed;
+} FcCacheBuffer;
+
+static void appendBytes(FcCacheBuffer *buf, const void *bytes, size_t length) {
+    if (buf->failed) return;
+    if (buf->length + length > buf->capacity) {
+        size_t capacity = buf->capacity ? buf->capacity * 2 : 4096;
+        while (capacity < buf->length + length) capacity *= 2;
+        char *data = (char*)realloc(buf->data, capacity);
+        if (data == NULL) {
+            buf->failed = JNI_TRUE;
+            return;
+        }
+        buf->data = data;
+        buf->capacity = capacity;
+    }
+    memcpy(buf->data + buf->length, bytes, length);
+    buf->length += length;
+}
+
+static void appendInt(FcCacheBuffer *buf, int value) {
+    appendBytes(buf, &value, sizeof(int));
+}
+
+static void appendString(FcCacheBuffer *buf, const char *str) {
+    int length = (int)strlen(str);
+    appendInt(buf, length);
+    appendBytes(buf, str, length);
+}
+
+static void appendPathStamp(FcCacheBuffer *buf, const char *dir, const char *name) {
+    char path[PATH_MAX+1];
+    char entry[PATH_MAX+64];
+    struct stat st;
+    if (dir == NULL || dir[0] == '\0') return;
+    snprintf(path, sizeof(path), "%s%s", dir, name ? name : "");
+    if (stat(path, &st) == 0) {
+        snprintf(entry, sizeof(entry), "%s:%ld.%09ld:%ld;", path,
+                 (long)st.st_mtim.tv_sec, (long)st.st_mtim.tv_nsec,
+                 (long)st.st_size);
+    } else {
+        snprintf(entry, sizeof(entry), "%s:-;", path);
+    }
+    appendBytes(buf, entry, strlen(entry));
+}
+
+#define FC_STAMP_MAX_DEPTH 8
+
+/*
+ * Folds the modification times of dir and of the directories below it into
+ * hash. Adding or removing a font anywhere in the tree changes the time of
+ * the directory it is in. The directories are summed up, so the order
+ * readdir() returns them in does not matter.
+ */
+static void hashDirTree(const char *dir, int depth,
+                        unsigned long long *hash, unsigned long *count) {
+    char path[PATH_MAX+1];
+    struct stat st;
+    DIR *d;
+    struct dirent *e;
+    const char *p;
+    unsigned long long h = 14695981039346656037ULL;
+
+    if (stat(dir, &st) != 0 || !S_ISDIR(st.st_mode)) return;
+    for (p = dir; *p != '\0'; p++) {
+        h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+    }
+    h = (h ^ (unsigned long long)st.st_mtim.tv_sec) * 1099511628211ULL;
+    h = (h ^ (unsigned long long)st.st_mtim.tv_nsec) * 1099511628211ULL;
+    *hash += h;
+    (*count)++;
+
+    if (depth >= FC_STAMP_MAX_DEPTH || (d = opendir(dir)) == NULL) return;
+    while ((e = readdir(d)) != NULL) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) {
+            continue;
+        }
+        if (e->d_type != DT_DIR && e->d_type != DT_LNK && e->d_type != DT_UNKNOWN) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        hashDirTree(path, depth + 1, hash, count);
+    }
+    closedir(d);
+}
+
+/* Stamps a font directory together with all of its subdirectories */
+static void appendTreeStamp(FcCacheBuffer *buf, const char *dir, const char *name) {
+    char path[PATH_MAX+1];
+    char entry[PATH_MAX+64];
+    unsigned long long hash = 0;
+    unsigned long count = 0;
+    if (dir == NULL || dir[0] == '\0') return;
+    snprintf(path, sizeof(path), "%s%s", dir, name ? name : "");
+    hashDirTree(path, 0, &hash, &count);
+    snprintf(entry, sizeof(entry), "%s:%lu.%016llx;", path, count, hash);
+    appendBytes(buf, entry, strlen(entry));
+}
+
+/*
+ * Stamps a fontconfig conf.d directory together with the files in it.
+ * Editing a configuration file in place does not change the time of its
+ * directory, so the time and size of every file are folded in as well.
+ * stat() follows the links most distributions put in conf.d, which also
+ * catches edits to the conf.avail files they point to.
+ */
+static void appendConfDirStamp(FcCacheBuffer *buf, const char *dir, const char *name) {
+    char path[PATH_MAX+1];
+    char file[PATH_MAX+1];
+    char entry[PATH_MAX+64];
+    struct stat st;
+    DIR *d;
+    struct dirent *e;
+    unsigned long long hash = 0;
+    unsigned long count = 0;
+    if (dir == NULL || dir[0] == '\0') return;
+    appendPathStamp(buf, dir, name);
+    snprintf(path, sizeof(path), "%s%s", dir, name ? name : "");
+    if ((d = opendir(path)) == NULL) return;
+    while ((e = readdir(d)) != NULL) {
+        const char *p;
+        unsigned long long h = 14695981039346656037ULL;
+        if (e->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(file, sizeof(file), "%s/%s", path, e->d_name);
+        if (stat(file, &st) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        for (p = e->d_name; *p != '\0'; p++) {
+            h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+        }
+        h = (h ^ (unsigned long long)st.st_mtim.tv_sec) * 1099511628211ULL;
+        h = (h ^ (unsigned long long)st.st_mtim.tv_nsec) * 1099511628211ULL;
+        h = (h ^ (unsigned long long)st.st_size) * 1099511628211ULL;
+        hash += h;
+        count++;
+    }
+    closedir(d);
+    snprintf(entry, sizeof(entry), "%s/*:%lu.%016llx;", path, count, hash);
+    appendBytes(buf, entry, strlen(entry));
+}
+
+/*
+ * The stamp changes when the fontconfig configuration changes, when a font
+ * is added to or removed from the font directories, or when fc-cache (or an
+ * application running fontconfig) rewrites its caches.
+ */
+static void buildStamp(FcCacheBuffer *buf, void *libfontconfig) {
+    char version[32];
+    const char *home = getenv("HOME");
+    const char *xdgConfig = getenv("XDG_CONFIG_HOME");
+    const char *xdgCache = getenv("XDG_CACHE_HOME");
+    const char *xdgData = getenv("XDG_DATA_HOME");
+    const char *fcFile = getenv("FONTCONFIG_FILE");
+    const char *fcPath = getenv("FONTCONFIG_PATH");
+    char dir[PATH_MAX+1];
+
+    FcGetVersionFuncType FcGetVersion =
+        (FcGetVersionFuncType)dlsym(libfontconfig, "FcGetVersion");
+    snprintf(version, sizeof(version), "fc%d;",
+             FcGetVersion != NULL ? (*FcGetVersion)() : 0);
+    appendBytes(buf, version, strlen(version));
+
+    appendPathStamp(buf, fcFile ? fcFile : "/etc/fonts/fonts.conf", NULL);
+    appendConfDirStamp(buf, fcPath ? fcPath : "/etc/fonts", "/conf.d");
+    appendPathStamp(buf, "/var/cache/fontconfig", NULL);
+    appendTreeStamp(buf, "/usr/share/fonts", NULL);
+    appendTreeStamp(buf, "/usr/local/share/fonts", NULL);
+    if (xdgConfig != NULL && xdgConfig[0] != '\0') {
+        snprintf(dir, sizeof(dir), "%s/fontconfig", xdgConfig);
+    } else {
+        snprintf(dir, sizeof(dir), "%s/.config/fontconfig", home ? home : "");
+    }
+    appendPathStamp(buf, dir, "/fonts.conf");
+    appendConfDirStamp(buf, dir, "/conf.d");
+    if (xdgCache != NULL && xdgCache[0] != '\0') {
+        snprintf(dir, sizeof(dir), "%s/fontconfig", xdgCache);
+    } else {
+        snprintf(dir, sizeof(dir), "%s/.cache/fontconfig", home ? home : "");
+    }
+    appendPathStamp(buf, dir, NULL);
+    if (xdgData != NULL && xdgData[0] != '\0') {
+        snprintf(dir, sizeof(dir), "%s/fonts", xdgData);
+    } else {
+        snprintf(dir, sizeof(dir), "%s/.local/share/fonts", home ? home : "");
+    }
+    appendTreeStamp(buf, dir, NULL);
+    if (home != NULL) {
+        appendPathStamp(buf, home, "/.fonts.conf");
+        appendTreeStamp(buf, home, "/.fonts");
+        appendPathStamp(buf, home, "/.fontconfig");
+    }
+}
+
+/* Maps the cache file, returns NULL if it is missing or stale */
+static void* mapFontCache(const char *path, FcCacheBuffer *stamp, size_t *size) {
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0 ||
+        st.st_size < FC_CACHE_MAGIC_LENGTH + 2 * sizeof(int) + stamp->length) {
+        close(fd);
+        return NULL;
+    }
+    void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return NULL;
+
+    const char *data = (const char*)addr;
+    int stampLength;
+    memcpy(&stampLength, data + FC_CACHE_MAGIC_LENGTH, sizeof(int));
+    if (memcmp(data, FC_CACHE_MAGIC, FC_CACHE_MAGIC_LENGTH) != 0 ||
+        stampLength != (int)stamp->length ||
+        memcmp(data + FC_CACHE_MAGIC_LENGTH + sizeof(int),
+               stamp->data, stamp->length) != 0)
+    {
+        munmap(addr, st.st_size);
+        return NULL;
+    }
+    *size = st.st_size;
+    return addr;
+}
+
+/* Creates the parent directories of path, if needed */
+static void makeParentDirs(const char *path) {
+    char dir[PATH_MAX+1];
+    char *slash;
+    snprintf(dir, sizeof(dir), "%s", path);
+    for (slash = strchr(dir + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(dir, 0700);
+        *slash = '/';
+    }
+}
+
+static jboolean writeFontCache(const char *path, FcCacheBuffer *buf) {
+    char tmpPath[PATH_MAX+1];
+    ssize_t written = 0;
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d", path, (int)getpid());
+    makeParentDirs(path);
+    int fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return JNI_FALSE;
+    while ((size_t)written < buf->length) {
+        ssize_t n = write(fd, buf->data + written, buf->length - written);
+        if (n <= 0) break;
+        written += n;
+    }
+    if (close(fd) != 0 || (size_t)written != buf->length ||
+        rename(tmpPath, path) != 0)
+    {
+        unlink(tmpPath);
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+static jboolean enumerateFonts(void *libfontconfig, FcCacheBuffer *buf,
+                               jboolean debugFC) {
+    FcPatternBuildFuncType FcPatternBuild =
+        (FcPatternBuildFuncType)dlsym(libfontconfig, "FcPatternBuild");
+    FcObjectSetFuncType FcObjectSetBuild =
+        (FcObjectSetFuncType)dlsym(libfontconfig, "FcObjectSetBuild");
+    FcFontListFuncType FcFontList =
+        (FcFontListFuncType)dlsym(libfontconfig, "FcFontList");
+    FcPatternGetStringFuncType FcPatternGetString =
+        (FcPatternGetStringFuncType)dlsym(libfontconfig, "FcPatternGetString");
+    FcFontSetDestroyFuncType FcFontSetDestroy =
+        (FcFontSetDestroyFuncType)dlsym(libfontconfig, "FcFontSetDestroy");
+    FcPattern *pattern;
+    FcObjectSet *objset;
+    FcFontSet *fontSet;
+    size_t countPos;
+    int f, count = 0;
+
+    if (FcPatternBuild     == NULL ||
+        FcObjectSetBuild   == NULL ||
+        FcPatternGetString == NULL ||
+        FcFontList         == NULL ||
+        FcFontSetDestroy   == NULL) {
+        if (debugFC) {
+           fprintf(stderr,"Could not find symbols in libfontconfig\n");
+        }
+        return JNI_FALSE;
+    }
+
+    pattern = (*FcPatternBuild)(NULL, FC_OUTLINE, FcTypeBool, FcTrue, NULL);
+    objset = (*FcObjectSetBuild)(FC_FAMILY, FC_FAMILYLANG,
+                                 FC_FULLNAME, FC_FULLNAMELANG,
+                                 FC_FILE, FC_FONTFORMAT, NULL);
+    fontSet = (*FcFontList)(NULL, pattern, objset);
+    if (fontSet == NULL) {
+        return JNI_FALSE;
+    }
+    if (debugFC) {
+        fprintf(stderr,"Fontconfig found %d fonts\n", fontSet->nfont);
+    }
+
+    countPos = buf->length;
+    appendInt(buf, 0);
+    for (f=0; f < fontSet->nfont; f++) {
+        FcChar8 *file, *family, *fullName;
+        char pathname[PATH_MAX+1];
+        if (!getFontNames(FcPatternGetString, fontSet->fonts[f], pathname,
+                          &file, &family, &fullName, debugFC)) {
+            continue;
+        }
+        appendString(buf, (const char*)file);
+        appendString(buf, (const char*)family);
+        appendString(buf, (const char*)fullName);
+        count++;
+    }
+    (*FcFontSetDestroy)(fontSet);
+    if (buf->failed) {
+        return JNI_FALSE;
+    }
+    memcpy(buf->data + countPos, &count, sizeof(int));
+    return JNI_TRUE;
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_sun_javafx_font_FontConfigManager_getFontListNative
+(JNIEnv *env, jclass obj, jstring cachePath)
+{
+    void *libfontconfig;
+    void *addr = NULL;
+    size_t size = 0;
+    const char *path;
+    FcCacheBuffer stamp = { NULL, 0, 0, JNI_FALSE };
+    FcCacheBuffer buf = { NULL, 0, 0, JNI_FALSE };
+    jobject result = NULL;
+    jboolean debugFC = getenv("PRISM_FONTCONFIG_DEBUG") != NULL;
+
+    if (cachePath == NULL) {
+        return NULL;
+    }
+    if ((libfontconfig = openFontConfig()) == NULL) {
+        if (debugFC) {
+            fprintf(stderr,"Could not open libfontconfig\n");
+        }
+        return NULL;
+    }
+    path = (*env)->GetStringUTFChars(env, cachePath, NULL);
+    if (path == NULL) {
+        closeFontConfig(libfontconfig, JNI_FALSE);
+        return NULL;
+    }
+
+    buildStamp(&stamp, libfontconfig);
+    if (!stamp.failed) {
+        addr = mapFontCache(path, &stamp, &size);
+    }
+    if (addr == NULL && !stamp.failed) {
+        if (debugFC) {
+            fprintf(stderr,"Fontconfig cache %s is missing or stale\n", path);
+        }
+        appendBytes(&buf, FC_CACHE_MAGIC, FC_CACHE_MAGIC_LENGTH);
+        appendInt(&buf, (int)stamp.length);
+        appendBytes(&buf, stamp.data, stamp.length);
+        if (enumerateFonts(libfontconfig, &buf, debugFC)) {
+            if (writeFontCache(path, &buf)) {
+                addr = mapFontCache(path, &stamp, &size);
+            }
+            if (addr == NULL) {
+                /* Cache not writable, hand the data over in anonymous memory */
+                addr = mmap(NULL, buf.length, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (addr == MAP_FAILED) {
+                    addr = NULL;
+                } else {
+                    memcpy(addr, buf.data, buf.length);
+                    size = buf.length;
+                }
+            }
+        }
+    }
+    if (addr != NULL) {
+        result = (*env)->NewDirectByteBuffer(env, addr, (jlong)size);
+        if (result == NULL) {
+            munmap(addr, size);
+        }
+    }
+
+    free(buf.data);
+    free(stamp.data);
+    (*env)->ReleaseStringUTFChars(env, cachePath, path);
+    closeFontConfig(libfontconfig, JNI_TRUE);
+    return result;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sun_javafx_font_FontConfigManager_freeFontListNative
+(JNIEnv *env, jclass obj, jobject buffer)
+{
+    if (buffer == NULL) return;
+    void *addr = (*env)->GetDirectBufferAddress(env, buffer);
+    jlong size = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (addr != NULL && size > 0) {
+        munmap(addr, (size_t)size);
+    }
+}
+
+
 #endif /* __linux__ */
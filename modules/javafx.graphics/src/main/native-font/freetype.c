@@ -372,6 +372,101 @@ JNIEXPORT jbyteArray JNICALL OS_NATIVE(getBitmapData)(JNIEnv *env, jclass that,
     return result;
 }
 
+/*
+ * Rasterizes a run of glyphs into a direct buffer laid out as an atlas region
+ * of atlasWidth x atlasHeight bytes (rows packed into shelves, no padding).
+ * For every glyph GLYPH_METRICS_SIZE ints are written into metrics, see
+ * OSFreetype.GM_* for the layout. Returns the number of glyphs processed,
+ * which is less than count when the atlas region is full.
+ */
+#define GLYPH_METRICS_SIZE 10
+#define GLYPH_STATUS_ERROR -1
+JNIEXPORT jint JNICALL OS_NATIVE(rasterizeGlyphs)
+    (JNIEnv *env, jclass that, jlong facePtr, jintArray glyphCodes, jint offset,
+     jint count, jint loadFlags, jobject atlas, jint atlasWidth, jint atlasHeight,
+     jintArray metrics)
+{
+    FT_Face face = (FT_Face)facePtr;
+    unsigned char *dst = NULL;
+    jlong capacity = 0;
+    jint *lpCodes = NULL;
+    jint *lpMetrics = NULL;
+    jint processed = 0;
+    int penX = 0, penY = 0, shelfHeight = 0;
+
+    if (!face || !glyphCodes || !atlas || !metrics) return 0;
+    if (offset < 0 || count <= 0 || atlasWidth <= 0 || atlasHeight <= 0) return 0;
+    if ((*env)->GetArrayLength(env, glyphCodes) < offset + count) return 0;
+    if ((*env)->GetArrayLength(env, metrics) < count * GLYPH_METRICS_SIZE) return 0;
+
+    dst = (unsigned char *)(*env)->GetDirectBufferAddress(env, atlas);
+    capacity = (*env)->GetDirectBufferCapacity(env, atlas);
+    if (!dst || capacity < (jlong)atlasWidth * atlasHeight) return 0;
+
+    if ((lpCodes = (*env)->GetIntArrayElements(env, glyphCodes, NULL)) == NULL) goto fail;
+    if ((lpMetrics = (*env)->GetIntArrayElements(env, metrics, NULL)) == NULL) goto fail;
+
+    for (; processed < count; processed++) {
+        jint *m = lpMetrics + processed * GLYPH_METRICS_SIZE;
+        FT_Error error;
+        FT_GlyphSlot slot;
+        FT_Bitmap *bitmap;
+        int width, height, y;
+
+        memset(m, 0, GLYPH_METRICS_SIZE * sizeof(jint));
+        error = FT_Load_Glyph(face, (FT_UInt)lpCodes[offset + processed], (FT_Int32)loadFlags);
+        slot = face->glyph;
+        if (error || !slot) {
+            m[9] = GLYPH_STATUS_ERROR;
+            continue;
+        }
+        bitmap = &slot->bitmap;
+        width = bitmap->width;
+        height = bitmap->rows;
+        m[9] = bitmap->pixel_mode;
+        if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY && bitmap->pixel_mode != FT_PIXEL_MODE_LCD) {
+            /* Left to the caller, see FTFontFile.initGlyph() */
+            continue;
+        }
+        if (width != 0 && height != 0) {
+            if (!bitmap->buffer || width > atlasWidth || height > atlasHeight) {
+                m[9] = GLYPH_STATUS_ERROR;
+                continue;
+            }
+            if (penX + width > atlasWidth) {
+                penX = 0;
+                penY += shelfHeight;
+                shelfHeight = 0;
+            }
+            if (penY + height > atlasHeight) {
+                /* Atlas region is full, the caller continues in a new one */
+                break;
+            }
+            for (y = 0; y < height; y++) {
+                unsigned char *src = bitmap->pitch >= 0
+                                     ? bitmap->buffer + y * bitmap->pitch
+                                     : bitmap->buffer + (height - 1 - y) * -bitmap->pitch;
+                memcpy(dst + (penY + y) * atlasWidth + penX, src, width);
+            }
+            m[0] = penX;
+            m[1] = penY;
+            penX += width;
+            if (height > shelfHeight) shelfHeight = height;
+        }
+        m[2] = width;
+        m[3] = height;
+        m[4] = slot->bitmap_left;
+        m[5] = slot->bitmap_top;
+        m[6] = (jint)slot->advance.x;
+        m[7] = (jint)slot->advance.y;
+        m[8] = (jint)slot->linearHoriAdvance;
+    }
+fail:
+    if (lpMetrics) (*env)->ReleaseIntArrayElements(env, metrics, lpMetrics, 0);
+    if (lpCodes) (*env)->ReleaseIntArrayElements(env, glyphCodes, lpCodes, JNI_ABORT);
+    return processed;
+}
+
 JNIEXPORT void JNICALL OS_NATIVE(FT_1Set_1Transform)
     (JNIEnv *env, jclass that, jlong arg0, jobject arg1, jlong arg2, jlong arg3)
 {
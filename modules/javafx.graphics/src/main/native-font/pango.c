@@ -26,14 +26,25 @@
 #if defined __linux__
 #if defined _ENABLE_PANGO
 
+/* Exposes the fontconfig pattern of PangoFcFont on older Pango versions */
+#define PANGO_ENABLE_BACKEND
+
 #include <jni.h>
 #include <com_sun_javafx_font_freetype_OSPango.h>
 #include <pango/pango.h>
 #include <pango/pangoft2.h>
 #include <dlfcn.h>
+#include <string.h>
 
 #define OS_NATIVE(func) Java_com_sun_javafx_font_freetype_OSPango_##func
 
+/* Layout of the buffer filled by pango_shape_into(), see OSPango.java */
+#define SHAPE_NUM_GLYPHS 0
+#define SHAPE_OFFSET 1
+#define SHAPE_LENGTH 2
+#define SHAPE_NUM_CHARS 3
+#define SHAPE_HEADER_SIZE 4
+
 extern jboolean checkAndClearException(JNIEnv *env);
 
 jboolean checkAndClearException(JNIEnv *env)
@@ -48,147 +59,252 @@ jboolean checkAndClearException(JNIEnv *env)
 
 /**************************************************************************/
 /*                                                                        */
-/*                            Structs                                     */
+/*                           Functions                                    */
 /*                                                                        */
 /**************************************************************************/
 
-typedef struct PangoGlyphString_FID_CACHE {
-    int cached;
-    jclass clazz;
-    jfieldID num_glyphs, glyphs, widths, log_clusters, offset, length, num_chars, font;
-    jmethodID init;
-} PangoGlyphString_FID_CACHE;
+/** Custom **/
 
-PangoGlyphString_FID_CACHE PangoGlyphStringFc;
+/*
+ * Shaping cache. Pango is expensive and the same runs are shaped over and over
+ * again (e.g. while editing or scrolling long text). Entries are keyed by the
+ * description of the font, the UTF-8 text and the analysis of the item,
+ * including its extra attributes. The font description is used instead of the
+ * PangoFont because each layout creates its own font map, and the fontconfig
+ * pattern of the font stands in for its options (hinting, antialiasing,
+ * resolution and matrix), which change the glyph advances.
+ */
+#define SHAPE_CACHE_MAX_ENTRIES 512
+#define SHAPE_CACHE_MAX_GLYPHS (256 * 1024)
+
+typedef struct _ShapeCacheEntry {
+    PangoFontDescription *desc;
+    gchar *text;
+    gint length;
+    guint8 level;
+    guint8 gravity;
+    guint8 flags;
+    PangoScript script;
+    PangoLanguage *language;
+    GSList *extra_attrs;
+    FcPattern *pattern;
+    guint hash;
+    int num_glyphs;
+    jint *data;     /* glyph, width, cluster triples */
+} ShapeCacheEntry;
+
+G_LOCK_DEFINE_STATIC(shapeCache);
+static GHashTable *shapeCache = NULL;
+static long shapeCacheGlyphs = 0;
+
+static guint shapeCacheHash(gconstpointer key)
+{
+    return ((const ShapeCacheEntry *)key)->hash;
+}
+
+/* Compares the values of the attributes, their ranges cover the item */
+static gboolean shapeCacheAttrsEqual(GSList *l1, GSList *l2)
+{
+    while (l1 && l2) {
+        if (!pango_attribute_equal((PangoAttribute *)l1->data, (PangoAttribute *)l2->data)) {
+            return FALSE;
+        }
+        l1 = l1->next;
+        l2 = l2->next;
+    }
+    return !l1 && !l2;
+}
+
+static gboolean shapeCacheEqual(gconstpointer a, gconstpointer b)
+{
+    const ShapeCacheEntry *e1 = (const ShapeCacheEntry *)a;
+    const ShapeCacheEntry *e2 = (const ShapeCacheEntry *)b;
+    return e1->hash == e2->hash &&
+           e1->length == e2->length &&
+           e1->level == e2->level &&
+           e1->gravity == e2->gravity &&
+           e1->flags == e2->flags &&
+           e1->script == e2->script &&
+           e1->language == e2->language &&
+           memcmp(e1->text, e2->text, e1->length) == 0 &&
+           pango_font_description_equal(e1->desc, e2->desc) &&
+           shapeCacheAttrsEqual(e1->extra_attrs, e2->extra_attrs) &&
+           (e1->pattern == e2->pattern ||
+            (e1->pattern && e2->pattern && FcPatternEqual(e1->pattern, e2->pattern)));
+}
+
+static void shapeCacheFree(gpointer data)
+{
+    ShapeCacheEntry *entry = (ShapeCacheEntry *)data;
+    pango_font_description_free(entry->desc);
+    g_slist_free_full(entry->extra_attrs, (GDestroyNotify)pango_attribute_destroy);
+    if (entry->pattern) FcPatternDestroy(entry->pattern);
+    g_free(entry->text);
+    g_free(entry->data);
+    g_free(entry);
+}
+
+static void shapeCacheInitKey(ShapeCacheEntry *key, PangoFontDescription *desc,
+                              const gchar *text, gint length, PangoAnalysis *analysis)
+{
+    key->desc = desc;
+    key->text = (gchar *)text;
+    key->length = length;
+    key->level = analysis->level;
+    key->gravity = analysis->gravity;
+    key->flags = analysis->flags;
+    key->script = analysis->script;
+    key->language = analysis->language;
+    key->extra_attrs = analysis->extra_attrs;
+    key->pattern = PANGO_IS_FC_FONT(analysis->font)
+                   ? PANGO_FC_FONT(analysis->font)->font_pattern : NULL;
+
+    /* FNV-1a over the text, mixed with the analysis and the font */
+    guint h = 2166136261u;
+    gint i;
+    GSList *attrs;
+    for (i = 0; i < length; i++) {
+        h = (h ^ (guint8)text[i]) * 16777619u;
+    }
+    h = h * 31 + pango_font_description_hash(desc);
+    h = h * 31 + (key->level | (key->gravity << 8) | (key->flags << 16));
+    h = h * 31 + (guint)key->script;
+    h = h * 31 + GPOINTER_TO_UINT(key->language);
+    for (attrs = key->extra_attrs; attrs; attrs = attrs->next) {
+        h = h * 31 + (guint)((PangoAttribute *)attrs->data)->klass->type;
+    }
+    if (key->pattern) h = h * 31 + FcPatternHash(key->pattern);
+    key->hash = h;
+}
 
-void cachePangoGlyphStringFields(JNIEnv *env)
+/* Moves the cursor to the byte index target, returns the char index */
+static glong utf8_offset_seek(const gchar *text, glong *byteCursor, glong *charCursor, glong target)
 {
-    if (PangoGlyphStringFc.cached) return;
-    jclass tmpClass = (*env)->FindClass(env, "com/sun/javafx/font/freetype/PangoGlyphString");
-    if (checkAndClearException(env) || !tmpClass) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or tmpClass == NULL");
-        return;
+    while (*byteCursor < target) {
+        *byteCursor = g_utf8_next_char(text + *byteCursor) - text;
+        (*charCursor)++;
     }
-    PangoGlyphStringFc.clazz =  (jclass)(*env)->NewGlobalRef(env, tmpClass);
-    PangoGlyphStringFc.num_glyphs = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "num_glyphs", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.num_glyphs) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or num_glyphs == NULL");
-        return;
+    while (*byteCursor > target) {
+        *byteCursor = g_utf8_prev_char(text + *byteCursor) - text;
+        (*charCursor)--;
     }
-    PangoGlyphStringFc.glyphs = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "glyphs", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.glyphs) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or glyphs == NULL");
-        return;
+    return *charCursor;
+}
+
+/*
+ * Shapes the item into buffer, a direct IntBuffer. See OSPango.SHAPE_* for
+ * the layout. When the buffer is too small, the negated number of glyphs is
+ * stored in SHAPE_NUM_GLYPHS and no glyphs are written.
+ * Returns the font description of the item, which the caller must free.
+ */
+JNIEXPORT jlong JNICALL OS_NATIVE(pango_1shape_1into)
+    (JNIEnv *env, jclass that, jlong str, jlong pangoItem, jobject buffer)
+{
+    if (!str || !pangoItem || !buffer) return 0;
+    jint *out = (jint *)(*env)->GetDirectBufferAddress(env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (!out || capacity < SHAPE_HEADER_SIZE) return 0;
+
+    PangoItem *item = (PangoItem *)pangoItem;
+    PangoAnalysis analysis = item->analysis;
+    const gchar *text = (const gchar *)(str + item->offset);
+    PangoFontDescription *desc = pango_font_describe(analysis.font);
+    if (!desc) return 0;
+
+    out[SHAPE_NUM_GLYPHS] = 0;
+    out[SHAPE_OFFSET] = item->offset;
+    out[SHAPE_LENGTH] = item->length;
+    out[SHAPE_NUM_CHARS] = item->num_chars;
+
+    ShapeCacheEntry key;
+    shapeCacheInitKey(&key, desc, text, item->length, &analysis);
+
+    G_LOCK(shapeCache);
+    if (!shapeCache) {
+        shapeCache = g_hash_table_new_full(shapeCacheHash, shapeCacheEqual, shapeCacheFree, NULL);
     }
-    PangoGlyphStringFc.widths = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "widths", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.widths) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or widths == NULL");
-        return;
+    ShapeCacheEntry *entry = (ShapeCacheEntry *)g_hash_table_lookup(shapeCache, &key);
+    if (entry) {
+        int count = entry->num_glyphs;
+        if (capacity < SHAPE_HEADER_SIZE + count * 3) {
+            out[SHAPE_NUM_GLYPHS] = -count;
+        } else {
+            out[SHAPE_NUM_GLYPHS] = count;
+            memcpy(out + SHAPE_HEADER_SIZE, entry->data, count * 3 * sizeof(jint));
+        }
     }
-    PangoGlyphStringFc.log_clusters = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "log_clusters", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.log_clusters) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or log_clusters == NULL");
-        return;
+    G_UNLOCK(shapeCache);
+    if (entry) return (jlong)desc;
+
+    PangoGlyphString *glyphString = pango_glyph_string_new();
+    if (!glyphString) {
+        pango_font_description_free(desc);
+        return 0;
     }
-    PangoGlyphStringFc.offset = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "offset", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.offset) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or offset == NULL");
-        return;
+    pango_shape(text, item->length, &analysis, glyphString);
+    int count = glyphString->num_glyphs;
+    jint *data = g_new(jint, count * 3);
+    glong byteCursor = 0, charCursor = 0;
+    int i;
+    for (i = 0; i < count; i++) {
+        data[i * 3] = glyphString->glyphs[i].glyph;
+        data[i * 3 + 1] = glyphString->glyphs[i].geometry.width;
+        /* translate byte index to char index, clusters are monotonic so
+         * seeking from the previous cluster is linear for the whole run */
+        data[i * 3 + 2] = (jint)utf8_offset_seek(text, &byteCursor, &charCursor,
+                                                 glyphString->log_clusters[i]);
     }
-    PangoGlyphStringFc.length = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "length", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.length) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or length == NULL");
-        return;
+    pango_glyph_string_free(glyphString);
+
+    if (capacity < SHAPE_HEADER_SIZE + count * 3) {
+        out[SHAPE_NUM_GLYPHS] = -count;
+    } else {
+        out[SHAPE_NUM_GLYPHS] = count;
+        memcpy(out + SHAPE_HEADER_SIZE, data, count * 3 * sizeof(jint));
     }
-    PangoGlyphStringFc.num_chars = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "num_chars", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.num_chars) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or num_chars == NULL");
-        return;
+
+    if (count > SHAPE_CACHE_MAX_GLYPHS / 16) {
+        /* Too large to be worth caching */
+        g_free(data);
+        return (jlong)desc;
     }
-    PangoGlyphStringFc.font = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "font", "J");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.font) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or font == NULL");
-        return;
+    entry = g_new(ShapeCacheEntry, 1);
+    *entry = key;
+    entry->desc = pango_font_description_copy(desc);
+    entry->extra_attrs = g_slist_copy_deep(key.extra_attrs, (GCopyFunc)pango_attribute_copy, NULL);
+    if (entry->pattern) FcPatternReference(entry->pattern);
+    entry->text = g_malloc(item->length);
+    memcpy(entry->text, text, item->length);
+    entry->num_glyphs = count;
+    entry->data = data;
+
+    G_LOCK(shapeCache);
+    if (g_hash_table_size(shapeCache) >= SHAPE_CACHE_MAX_ENTRIES ||
+        shapeCacheGlyphs + count > SHAPE_CACHE_MAX_GLYPHS) {
+        /* Start over, cheaper than tracking usage on every hit */
+        g_hash_table_remove_all(shapeCache);
+        shapeCacheGlyphs = 0;
     }
-    PangoGlyphStringFc.init = (*env)->GetMethodID(env, PangoGlyphStringFc.clazz, "<init>", "()V");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.init) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or init == NULL");
-        return;
+    if (!g_hash_table_contains(shapeCache, entry)) {
+        g_hash_table_add(shapeCache, entry);
+        shapeCacheGlyphs += count;
+        entry = NULL;
     }
-    PangoGlyphStringFc.cached = 1;
+    G_UNLOCK(shapeCache);
+    /* Another thread cached the same run meanwhile */
+    if (entry) shapeCacheFree(entry);
+    return (jlong)desc;
 }
 
-/**************************************************************************/
-/*                                                                        */
-/*                           Functions                                    */
-/*                                                                        */
-/**************************************************************************/
-
-/** Custom **/
-
-JNIEXPORT jobject JNICALL OS_NATIVE(pango_1shape)
-    (JNIEnv *env, jclass that, jlong str, jlong pangoItem)
+JNIEXPORT void JNICALL OS_NATIVE(pango_1shape_1cache_1clear)
+    (JNIEnv *env, jclass that)
 {
-    if (!str) return NULL;
-    if (!pangoItem) return NULL;
-    PangoItem *item = (PangoItem *)pangoItem;
-    PangoAnalysis analysis = item->analysis;
-    if (!pangoItem) return NULL;
-    const gchar *text= (const gchar *)(str + item->offset);
-    PangoGlyphString *glyphString = pango_glyph_string_new();
-    if (!glyphString) return NULL;
-
-    jobject result = NULL;
-    pango_shape(text, item->length, &analysis, glyphString);
-    int count = glyphString->num_glyphs;
-    if(count == 0) goto fail;
-
-    jintArray glyphsArray = (*env)->NewIntArray(env, count);
-    jintArray widthsArray = (*env)->NewIntArray(env, count);
-    jintArray clusterArray = (*env)->NewIntArray(env, count);
-    if (glyphsArray && widthsArray && clusterArray) {
-        jint glyphs[count];
-        jint widths[count];
-        jint cluster[count];
-        int i;
-        for (i = 0; i < count; i++) {
-            glyphs[i] = glyphString->glyphs[i].glyph;
-            widths[i] = glyphString->glyphs[i].geometry.width;
-            /* translate byte index to char index */
-            cluster[i] = (jint)g_utf8_pointer_to_offset(text, text + glyphString->log_clusters[i]);
-        }
-        (*env)->SetIntArrayRegion(env, glyphsArray, 0, count, glyphs);
-        if ((*env)->ExceptionOccurred(env)) {
-            fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
-        }
-        (*env)->SetIntArrayRegion(env, widthsArray, 0, count, widths);
-        if ((*env)->ExceptionOccurred(env)) {
-            fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
-        }
-        (*env)->SetIntArrayRegion(env, clusterArray, 0, count, cluster);
-        if ((*env)->ExceptionOccurred(env)) {
-            fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
-        }
-        if (!PangoGlyphStringFc.cached) cachePangoGlyphStringFields(env);
-        result = (*env)->NewObject(env, PangoGlyphStringFc.clazz, PangoGlyphStringFc.init);
-        if (result) {
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.num_glyphs, count);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.glyphs, glyphsArray);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.widths, widthsArray);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.log_clusters, clusterArray);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.offset, item->offset);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.length, item->length);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.num_chars, item->num_chars);
-            (*env)->SetLongField(env, result, PangoGlyphStringFc.font, (jlong)analysis.font);
-        }
+    G_LOCK(shapeCache);
+    if (shapeCache) {
+        g_hash_table_remove_all(shapeCache);
+        shapeCacheGlyphs = 0;
     }
-
-fail:
-    pango_glyph_string_free(glyphString);
-    return result;
+    G_UNLOCK(shapeCache);
 }
 
 JNIEXPORT jstring JNICALL OS_NATIVE(pango_1font_1description_1get_1family)
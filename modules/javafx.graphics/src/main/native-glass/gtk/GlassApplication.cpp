@@ -46,10 +46,30 @@
 
 GdkEventFunc process_events_prev;
 static void process_events(GdkEvent*, gpointer);
+static void flush_pending_event();
 
 JNIEnv* mainEnv; // Use only with main loop thread!!!
 
 extern gboolean disableGrab;
+extern gboolean useShmPresentation;
+static gboolean coalesceEvents = TRUE;
+
+/*
+ * Consecutive motion, scroll and configure events of the same kind for the
+ * same window are coalesced, so that a burst of them reaches Java as a single
+ * event. The held event is delivered when any other event arrives, once the
+ * pending events have been drained from the queue, or after it has been held
+ * for a frame interval.
+ */
+#define COALESCE_INTERVAL_USEC 16000
+
+static GdkEvent* pending_event = NULL;
+static jint pending_scroll_clicks = 0;
+static gint64 pending_since = 0;
+static guint pending_source = 0;
+
+static jlong events_coalesced = 0;
+static jlong events_delivered = 0;
 
 static gboolean call_runnable (gpointer data)
 {
@@ -151,13 +171,15 @@ JNIEXPORT jint JNICALL Java_com_sun_glass_ui_gtk_GtkApplication__1queryLibrary
  * Signature: ()V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkApplication__1init
-  (JNIEnv * env, jobject obj, jlong handler, jboolean _disableGrab)
+  (JNIEnv * env, jobject obj, jlong handler, jboolean _disableGrab, jboolean _useShm, jboolean _coalesceEvents)
 {
     (void)obj;
 
     mainEnv = env;
     process_events_prev = (GdkEventFunc) handler;
     disableGrab = (gboolean) _disableGrab;
+    useShmPresentation = (gboolean) _useShm;
+    coalesceEvents = (gboolean) _coalesceEvents;
 
     glass_gdk_x11_display_set_window_scale(gdk_display_get_default(), 1);
     gdk_event_handler_set(process_events, NULL, NULL);
@@ -234,6 +256,7 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkApplication__1terminateLoop
     (void)env;
     (void)obj;
 
+    flush_pending_event();
     gtk_main_quit();
 }
 
@@ -387,6 +410,20 @@ JNIEXPORT jboolean JNICALL Java_com_sun_glass_ui_gtk_GtkApplication__1supportsTr
             && gdk_screen_is_composited(gdk_screen_get_default());
 }
 
+/*
+ * Class:     com_sun_glass_ui_gtk_GtkApplication
+ * Method:    _getEventCounts
+ * Signature: ([J)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkApplication__1getEventCounts
+  (JNIEnv * env, jclass clazz, jlongArray counts)
+{
+    (void)clazz;
+
+    jlong values[] = { events_coalesced, events_delivered };
+    env->SetLongArrayRegion(counts, 0, 2, values);
+}
+
 } // extern "C"
 
 bool is_window_enabled_for_event(GdkWindow * window, WindowContext *ctx, gint event_type) {
@@ -417,7 +454,7 @@ bool is_window_enabled_for_event(GdkWindow * window, WindowContext *ctx, gint ev
     return TRUE;
 }
 
-static void process_events(GdkEvent* event, gpointer data)
+static void dispatch_event(GdkEvent* event, gpointer data, jint scroll_clicks)
 {
     GdkWindow* window = event->any.window;
     WindowContext *ctx = window != NULL ? (WindowContext*)
@@ -448,6 +485,7 @@ static void process_events(GdkEvent* event, gpointer data)
     }
 
     if (ctx != NULL) {
+        events_delivered++;
         EventsCounterHelper helper(ctx);
         try {
             switch (event->type) {
@@ -487,7 +525,7 @@ static void process_events(GdkEvent* event, gpointer data)
                     gdk_event_request_motions(&event->motion);
                     break;
                 case GDK_SCROLL:
-                    ctx->process_mouse_scroll(&event->scroll);
+                    ctx->process_mouse_scroll(&event->scroll, scroll_clicks);
                     break;
                 case GDK_ENTER_NOTIFY:
                 case GDK_LEAVE_NOTIFY:
@@ -537,3 +575,111 @@ static void process_events(GdkEvent* event, gpointer data)
         }
     }
 }
+
+static bool is_coalescable(GdkEvent* event)
+{
+    switch (event->type) {
+        case GDK_MOTION_NOTIFY:
+        case GDK_SCROLL:
+        case GDK_CONFIGURE:
+            break;
+        default:
+            return false;
+    }
+
+    // Events of non-FX windows are passed on as they are
+    GdkWindow* window = event->any.window;
+    return window != NULL
+            && g_object_get_data(G_OBJECT(window), GDK_WINDOW_DATA_CONTEXT) != NULL;
+}
+
+static bool can_coalesce(GdkEvent* pending, GdkEvent* event)
+{
+    if (pending->type != event->type || pending->any.window != event->any.window) {
+        return false;
+    }
+    switch (event->type) {
+        case GDK_MOTION_NOTIFY:
+            return pending->motion.state == event->motion.state
+                    && pending->motion.device == event->motion.device;
+        case GDK_SCROLL:
+#if GTK_CHECK_VERSION(3, 4, 0)
+            if (event->scroll.direction == GDK_SCROLL_SMOOTH) {
+                return false;
+            }
+#endif
+            return pending->scroll.state == event->scroll.state
+                    && pending->scroll.direction == event->scroll.direction;
+        case GDK_CONFIGURE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void flush_pending_event()
+{
+    if (pending_source != 0) {
+        g_source_remove(pending_source);
+        pending_source = 0;
+    }
+    if (pending_event != NULL) {
+        GdkEvent* event = pending_event;
+        pending_event = NULL;
+        dispatch_event(event, NULL, pending_scroll_clicks);
+        gdk_event_free(event);
+    }
+}
+
+void glass_drop_pending_event(GdkWindow* window)
+{
+    if (pending_event != NULL && pending_event->any.window == window) {
+        if (pending_source != 0) {
+            g_source_remove(pending_source);
+            pending_source = 0;
+        }
+        gdk_event_free(pending_event);
+        pending_event = NULL;
+    }
+}
+
+static gboolean flush_pending_event_idle(gpointer data)
+{
+    (void)data;
+
+    pending_source = 0;
+    flush_pending_event();
+    return FALSE;
+}
+
+static void process_events(GdkEvent* event, gpointer data)
+{
+    if (pending_event != NULL) {
+        if (can_coalesce(pending_event, event)
+                && g_get_monotonic_time() - pending_since < COALESCE_INTERVAL_USEC) {
+            // The latest event carries the current position, size and
+            // timestamp; scroll events add up their clicks
+            gdk_event_free(pending_event);
+            pending_event = gdk_event_copy(event);
+            if (event->type == GDK_SCROLL) {
+                pending_scroll_clicks++;
+            }
+            events_coalesced++;
+            return;
+        }
+        flush_pending_event();
+    }
+
+    if (coalesceEvents && is_coalescable(event)) {
+        pending_event = gdk_event_copy(event);
+        pending_scroll_clicks = 1;
+        pending_since = g_get_monotonic_time();
+        // Runs once the events that are already queued have been handled,
+        // but before the runnables posted with a lower priority
+        pending_source = gdk_threads_add_idle_full(G_PRIORITY_HIGH_IDLE,
+                flush_pending_event_idle, NULL, NULL);
+        return;
+    }
+
+    dispatch_event(event, data, 1);
+}
@@ -22,6 +22,7 @@
  * or visit www.oracle.com if you need additional information or have any
  * questions.
  */
+#include <com_sun_glass_ui_View.h>
 #include <com_sun_glass_ui_gtk_GtkView.h>
 #include <com_sun_glass_events_ViewEvent.h>
 
@@ -175,41 +176,70 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1scheduleRepaint
     (void)ptr;
 }
 
+/*
+ * Copies the damaged rectangles passed with an upload into rects and
+ * returns their number, or -1 if the entire frame has to be painted.
+ */
+static jint get_damage_rects(JNIEnv *env, jintArray damage, jint *rects)
+{
+    if (damage == NULL) {
+        return -1;
+    }
+    jsize length = env->GetArrayLength(damage);
+    if (length % 4 != 0 || length > 4 * com_sun_glass_ui_View_MAX_DAMAGE_RECTS) {
+        return -1;
+    }
+    env->GetIntArrayRegion(damage, 0, length, rects);
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        return -1;
+    }
+    return length / 4;
+}
+
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsDirect
- * Signature: (JLjava/nio/Buffer;II)V
+ * Signature: (JLjava/nio/Buffer;II[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsDirect
-(JNIEnv *env, jobject jView, jlong ptr, jobject buffer, jint width, jint height)
+(JNIEnv *env, jobject jView, jlong ptr, jobject buffer, jint width, jint height, jintArray damage)
 {
     (void)jView;
 
     GlassView* view = JLONG_TO_GLASSVIEW(ptr);
     if (view->current_window) {
+        jint rectBuf[4 * com_sun_glass_ui_View_MAX_DAMAGE_RECTS];
+        jint nrects = get_damage_rects(env, damage, rectBuf);
+        const jint *rects = nrects < 0 ? NULL : rectBuf;
+
         void *data = env->GetDirectBufferAddress(buffer);
 
-        view->current_window->paint(data, width, height);
+        view->current_window->paint(data, width, height, rects, nrects);
     }
 }
 
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsIntArray
- * Signature:  (J[IIII)V
+ * Signature:  (J[IIII[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsIntArray
-  (JNIEnv * env, jobject obj, jlong ptr, jintArray array, jint offset, jint width, jint height)
+  (JNIEnv * env, jobject obj, jlong ptr, jintArray array, jint offset, jint width, jint height, jintArray damage)
 {
     (void)obj;
 
     GlassView* view = JLONG_TO_GLASSVIEW(ptr);
     if (view->current_window) {
+        jint rectBuf[4 * com_sun_glass_ui_View_MAX_DAMAGE_RECTS];
+        jint nrects = get_damage_rects(env, damage, rectBuf);
+        const jint *rects = nrects < 0 ? NULL : rectBuf;
+
         int *data = NULL;
         assert((width*height + offset) == env->GetArrayLength(array));
         data = (int*)env->GetPrimitiveArrayCritical(array, 0);
 
-        view->current_window->paint(data + offset, width, height);
+        view->current_window->paint(data + offset, width, height, rects, nrects);
 
         env->ReleasePrimitiveArrayCritical(array, data, JNI_ABORT);
     }
@@ -218,21 +248,25 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsIntArray
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsByteArray
- * Signature:  (J[BIII)V
+ * Signature:  (J[BIII[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsByteArray
-  (JNIEnv * env, jobject obj, jlong ptr, jbyteArray array, jint offset, jint width, jint height)
+  (JNIEnv * env, jobject obj, jlong ptr, jbyteArray array, jint offset, jint width, jint height, jintArray damage)
 {
     (void)obj;
 
     GlassView* view = JLONG_TO_GLASSVIEW(ptr);
     if (view->current_window) {
+        jint rectBuf[4 * com_sun_glass_ui_View_MAX_DAMAGE_RECTS];
+        jint nrects = get_damage_rects(env, damage, rectBuf);
+        const jint *rects = nrects < 0 ? NULL : rectBuf;
+
         unsigned char *data = NULL;
 
         assert((4*width*height + offset) == env->GetArrayLength(array));
         data = (unsigned char*)env->GetPrimitiveArrayCritical(array, 0);
 
-        view->current_window->paint(data + offset, width, height);
+        view->current_window->paint(data + offset, width, height, rects, nrects);
 
         env->ReleasePrimitiveArrayCritical(array, data, JNI_ABORT);
     }
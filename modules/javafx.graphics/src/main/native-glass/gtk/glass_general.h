@@ -120,6 +120,10 @@ private:
 
     extern char const * const GDK_WINDOW_DATA_CONTEXT;
 
+    // Drops a coalesced event that is still held for the window, so that it
+    // is not dispatched to a context that is being destroyed
+    void glass_drop_pending_event(GdkWindow* window);
+
     GdkCursor* get_native_cursor(int type);
 
     // JNI global references
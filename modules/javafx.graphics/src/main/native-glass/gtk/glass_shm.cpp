@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+#include "glass_shm.h"
+
+#include <X11/Xutil.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <string.h>
+
+static bool shm_attach_failed = false;
+
+static int shm_attach_error_handler(Display* display, XErrorEvent* event)
+{
+    (void)display;
+    (void)event;
+    shm_attach_failed = true;
+    return 0;
+}
+
+static bool is_host_byte_order(int byte_order)
+{
+    const unsigned int one = 1;
+    bool little_endian = *(const unsigned char*)&one == 1;
+    return byte_order == (little_endian ? LSBFirst : MSBFirst);
+}
+
+ShmPresenter* ShmPresenter::create(Display* display, Visual* visual, int depth, Drawable drawable)
+{
+    if (display == NULL || visual == NULL || drawable == None) {
+        return NULL;
+    }
+    if (!XShmQueryExtension(display)) {
+        return NULL;
+    }
+    if (visual->c_class != TrueColor || (depth != 24 && depth != 32)
+            || visual->red_mask != 0xff0000
+            || visual->green_mask != 0x00ff00
+            || visual->blue_mask != 0x0000ff) {
+        return NULL;
+    }
+    return new ShmPresenter(display, visual, depth, drawable);
+}
+
+ShmPresenter::ShmPresenter(Display* _display, Visual* _visual, int _depth, Drawable _drawable) :
+        display(_display),
+        visual(_visual),
+        depth(_depth),
+        drawable(_drawable),
+        gc(NULL),
+        current(0),
+        width(0),
+        height(0)
+{
+    memset(buffers, 0, sizeof(buffers));
+}
+
+ShmPresenter::~ShmPresenter()
+{
+    release_buffers();
+    if (gc) {
+        XFreeGC(display, gc);
+    }
+}
+
+bool ShmPresenter::create_buffer(Buffer* buffer, int w, int h)
+{
+    memset(buffer, 0, sizeof(Buffer));
+    buffer->info.shmid = -1;
+
+    XImage* image = XShmCreateImage(display, visual, depth, ZPixmap, NULL, &buffer->info, w, h);
+    if (image == NULL) {
+        return false;
+    }
+    if (image->bits_per_pixel != 32 || !is_host_byte_order(image->byte_order)) {
+        XDestroyImage(image);
+        return false;
+    }
+
+    buffer->info.shmid = shmget(IPC_PRIVATE, image->bytes_per_line * image->height, IPC_CREAT | 0600);
+    if (buffer->info.shmid < 0) {
+        XDestroyImage(image);
+        return false;
+    }
+    buffer->info.shmaddr = image->data = (char*)shmat(buffer->info.shmid, NULL, 0);
+    if (buffer->info.shmaddr == (char*)-1) {
+        shmctl(buffer->info.shmid, IPC_RMID, NULL);
+        image->data = NULL;
+        XDestroyImage(image);
+        return false;
+    }
+    buffer->info.readOnly = True;
+
+    // XShmAttach fails asynchronously when the server can not map the
+    // segment, e.g. on a remote display, so trap the error with a round trip.
+    XSync(display, False);
+    XErrorHandler handler = XSetErrorHandler(shm_attach_error_handler);
+    shm_attach_failed = false;
+    Status attached = XShmAttach(display, &buffer->info);
+    XSync(display, False);
+    XSetErrorHandler(handler);
+
+    // The segment is destroyed once both sides have detached from it
+    shmctl(buffer->info.shmid, IPC_RMID, NULL);
+
+    if (!attached || shm_attach_failed) {
+        shmdt(buffer->info.shmaddr);
+        image->data = NULL;
+        XDestroyImage(image);
+        memset(buffer, 0, sizeof(Buffer));
+        return false;
+    }
+
+    buffer->image = image;
+    return true;
+}
+
+void ShmPresenter::destroy_buffer(Buffer* buffer)
+{
+    if (buffer->image) {
+        XShmDetach(display, &buffer->info);
+        XSync(display, False);
+        shmdt(buffer->info.shmaddr);
+        buffer->image->data = NULL;
+        XDestroyImage(buffer->image);
+    }
+    memset(buffer, 0, sizeof(Buffer));
+}
+
+void ShmPresenter::release_buffers()
+{
+    destroy_buffer(&buffers[0]);
+    destroy_buffer(&buffers[1]);
+    width = height = 0;
+}
+
+bool ShmPresenter::ensure_buffers(int w, int h)
+{
+    if (w == width && h == height && buffers[0].image && buffers[1].image) {
+        return true;
+    }
+    release_buffers();
+    if (!create_buffer(&buffers[0], w, h) || !create_buffer(&buffers[1], w, h)) {
+        release_buffers();
+        return false;
+    }
+    width = w;
+    height = h;
+    current = 0;
+    return true;
+}
+
+bool ShmPresenter::present(const void* data, int w, int h, const int* rects, int nrects)
+{
+    if (data == NULL || w <= 0 || h <= 0) {
+        return false;
+    }
+    if (!ensure_buffers(w, h)) {
+        return false;
+    }
+    if (!gc) {
+        gc = XCreateGC(display, drawable, 0, NULL);
+        if (!gc) {
+            return false;
+        }
+    }
+
+    Buffer* buffer = &buffers[current];
+    // Requests are processed in order, so the server is done reading this
+    // image once it has processed the last put that used it.
+    if (buffer->serial && (long)(LastKnownRequestProcessed(display) - buffer->serial) < 0) {
+        XSync(display, False);
+    }
+
+    int full[4] = { 0, 0, w, h };
+    if (rects == NULL) {
+        rects = full;
+        nrects = 1;
+    }
+
+    const char* src = (const char*)data;
+    const int src_stride = w * 4;
+    const int dst_stride = buffer->image->bytes_per_line;
+    bool put = false;
+    for (int i = 0; i < nrects; i++) {
+        int x0 = rects[4 * i];
+        int y0 = rects[4 * i + 1];
+        int x1 = x0 + rects[4 * i + 2];
+        int y1 = y0 + rects[4 * i + 3];
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        if (x1 > w) x1 = w;
+        if (y1 > h) y1 = h;
+        if (x0 >= x1 || y0 >= y1) {
+            continue;
+        }
+
+        const size_t row_bytes = (size_t)(x1 - x0) * 4;
+        for (int y = y0; y < y1; y++) {
+            memcpy(buffer->image->data + (size_t)y * dst_stride + (size_t)x0 * 4,
+                   src + (size_t)y * src_stride + (size_t)x0 * 4,
+                   row_bytes);
+        }
+        XShmPutImage(display, drawable, gc, buffer->image,
+                x0, y0, x0, y0, x1 - x0, y1 - y0, False);
+        put = true;
+    }
+
+    if (put) {
+        buffer->serial = NextRequest(display) - 1;
+        XFlush(display);
+        current ^= 1;
+    }
+    return true;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+#ifndef GLASS_SHM_H
+#define GLASS_SHM_H
+
+#include <X11/Xlib.h>
+#include <X11/extensions/XShm.h>
+
+/*
+ * Presents premultiplied 32-bit ARGB frames to an X drawable through
+ * MIT-SHM images. Two shared images are used in turn so that a new frame
+ * can be copied while the server may still be reading the previous one.
+ * Only the damaged rectangles are copied and put.
+ */
+class ShmPresenter {
+    struct Buffer {
+        XShmSegmentInfo info;
+        XImage* image;
+        unsigned long serial;
+    };
+
+    Display* display;
+    Visual* visual;
+    int depth;
+    Drawable drawable;
+    GC gc;
+    Buffer buffers[2];
+    int current;
+    int width;
+    int height;
+
+    ShmPresenter(Display*, Visual*, int, Drawable);
+    bool ensure_buffers(int, int);
+    bool create_buffer(Buffer*, int, int);
+    void destroy_buffer(Buffer*);
+    void release_buffers();
+public:
+    /*
+     * Returns a presenter for the drawable, or NULL if the display does not
+     * support shared memory images or the visual is not 32 bits per pixel
+     * with 8-bit RGB channels in host byte order.
+     */
+    static ShmPresenter* create(Display*, Visual*, int depth, Drawable);
+
+    /*
+     * Puts the given rectangles (x, y, width, height quadruples) of a
+     * width x height frame to the drawable. When rects is NULL the entire
+     * frame is put. Returns false if the frame could not be presented, in
+     * which case the caller should fall back to another path.
+     */
+    bool present(const void* data, int width, int height, const int* rects, int nrects);
+
+    ~ShmPresenter();
+};
+
+#endif        /* GLASS_SHM_H */
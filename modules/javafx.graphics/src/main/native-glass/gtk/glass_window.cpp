@@ -187,6 +187,11 @@ void destroy_and_delete_ctx(WindowContext* ctx) {
 }
 
 void WindowContextBase::process_destroy() {
+    if (gdk_window) {
+        glass_drop_pending_event(gdk_window);
+        g_object_set_data(G_OBJECT(gdk_window), GDK_WINDOW_DATA_CONTEXT, NULL);
+    }
+
     if (WindowContextBase::sm_mouse_drag_window == this) {
         ungrab_mouse_drag_focus();
     }
@@ -228,6 +233,7 @@ void WindowContextBase::process_delete() {
 }
 
 void WindowContextBase::process_expose(GdkEventExpose* event) {
+    needs_full_paint = true;
     if (jview) {
         mainEnv->CallVoidMethod(jview, jViewNotifyRepaint, event->area.x, event->area.y, event->area.width, event->area.height);
         CHECK_JNI_EXCEPTION(mainEnv)
@@ -348,7 +354,7 @@ void WindowContextBase::process_mouse_motion(GdkEventMotion* event) {
     }
 }
 
-void WindowContextBase::process_mouse_scroll(GdkEventScroll* event) {
+void WindowContextBase::process_mouse_scroll(GdkEventScroll* event, jint clicks) {
     jdouble dx = 0;
     jdouble dy = 0;
 
@@ -377,6 +383,9 @@ void WindowContextBase::process_mouse_scroll(GdkEventScroll* event) {
         dy = dx;
         dx = t;
     }
+    // scroll events in the same direction may have been coalesced into this one
+    dx *= clicks;
+    dy *= clicks;
     if (jview) {
         mainEnv->CallVoidMethod(jview, jViewNotifyScroll,
                 (jint) event->x, (jint) event->y,
@@ -482,13 +491,61 @@ void WindowContextBase::process_key(GdkEventKey* event) {
     }
 }
 
-void WindowContextBase::paint(void* data, jint width, jint height)
+gboolean useShmPresentation = TRUE;
+
+void WindowContextBase::paint(void* data, jint width, jint height, const jint* rects, jint nrects)
 {
     if (!is_visible()) {
         return;
     }
+
+    // Exposed areas are not part of the damage computed for frames that
+    // were already in flight, so present the next frame entirely.
+    if (needs_full_paint) {
+        rects = NULL;
+        needs_full_paint = false;
+    }
+
+    applyShapeMask(data, width, height);
+
+    if (useShmPresentation && !shm_checked) {
+        shm_checked = true;
+#ifdef GLASS_GTK3
+        GdkVisual* visual = gdk_window_get_visual(gdk_window);
+#else
+        GdkVisual* visual = gdk_drawable_get_visual(gdk_window);
+#endif
+        shm_presenter = ShmPresenter::create(
+                GDK_DISPLAY_XDISPLAY(gdk_window_get_display(gdk_window)),
+                gdk_x11_visual_get_xvisual(visual),
+                glass_gdk_visual_get_depth(visual),
+                GDK_WINDOW_XID(gdk_window));
+        if (gtk_verbose) {
+            fprintf(stderr, "Glass GTK: %s MIT-SHM presentation\n",
+                    shm_presenter ? "using" : "not using");
+        }
+    }
+    if (shm_presenter) {
+        if (shm_presenter->present(data, width, height, rects, nrects)) {
+            return;
+        }
+        delete shm_presenter;
+        shm_presenter = NULL;
+    }
+
 #ifdef GLASS_GTK3
     cairo_region_t *region = gdk_window_get_clip_region(gdk_window);
+    if (rects) {
+        cairo_region_t *damage = cairo_region_create();
+        for (jint i = 0; i < nrects; i++) {
+            cairo_rectangle_int_t rect = {
+                rects[4 * i], rects[4 * i + 1], rects[4 * i + 2], rects[4 * i + 3]
+            };
+            cairo_region_union_rectangle(damage, &rect);
+        }
+        cairo_region_intersect(region, damage);
+        cairo_region_destroy(damage);
+    }
     gdk_window_begin_paint_region(gdk_window, region);
 #endif
     cairo_t* context;
@@ -500,7 +557,13 @@ void WindowContextBase::paint(void* data, jint width, jint height)
             CAIRO_FORMAT_ARGB32,
             width, height, width * 4);
 
-    applyShapeMask(data, width, height);
+    if (rects) {
+        for (jint i = 0; i < nrects; i++) {
+            cairo_rectangle(context, rects[4 * i], rects[4 * i + 1],
+                    rects[4 * i + 2], rects[4 * i + 3]);
+        }
+        cairo_clip(context);
+    }
 
     cairo_set_source_surface(context, cairo_surface, 0, 0);
     cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
@@ -653,6 +716,10 @@ void WindowContextBase::set_background(float r, float g, float b) {
 }
 
 WindowContextBase::~WindowContextBase() {
+    if (shm_presenter) {
+        delete shm_presenter;
+        shm_presenter = NULL;
+    }
     if (xim.ic) {
         XDestroyIC(xim.ic);
         xim.ic = NULL;
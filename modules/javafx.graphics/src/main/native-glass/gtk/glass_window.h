@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "glass_view.h"
+#include "glass_shm.h"
 
 enum WindowFrameType {
     TITLED,
@@ -108,7 +109,7 @@ public:
     virtual bool filterIME(GdkEvent *) = 0;
     virtual void enableOrResetIME() = 0;
     virtual void disableIME() = 0;
-    virtual void paint(void* data, jint width, jint height) = 0;
+    virtual void paint(void* data, jint width, jint height, const jint* rects, jint nrects) = 0;
     virtual WindowFrameExtents get_frame_extents() = 0;
 
     virtual void enter_fullscreen() = 0;
@@ -148,7 +149,7 @@ public:
     virtual void process_expose(GdkEventExpose*) = 0;
     virtual void process_mouse_button(GdkEventButton*) = 0;
     virtual void process_mouse_motion(GdkEventMotion*) = 0;
-    virtual void process_mouse_scroll(GdkEventScroll*) = 0;
+    virtual void process_mouse_scroll(GdkEventScroll*, jint) = 0;
     virtual void process_mouse_cross(GdkEventCrossing*) = 0;
     virtual void process_key(GdkEventKey*) = 0;
     virtual void process_state(GdkEventWindowState*) = 0;
@@ -186,6 +187,10 @@ class WindowContextBase: public WindowContext {
 
     size_t events_processing_cnt;
     bool can_be_deleted;
+
+    ShmPresenter* shm_presenter;
+    bool shm_checked;
+    bool needs_full_paint;
 protected:
     std::set<WindowContextTop*> children;
     jobject jwindow;
@@ -222,7 +227,7 @@ public:
     bool filterIME(GdkEvent *);
     void enableOrResetIME();
     void disableIME();
-    void paint(void*, jint, jint);
+    void paint(void*, jint, jint, const jint*, jint);
     GdkWindow *get_gdk_window();
     jobject get_jwindow();
     jobject get_jview();
@@ -249,7 +254,7 @@ public:
     void process_expose(GdkEventExpose*);
     void process_mouse_button(GdkEventButton*);
     void process_mouse_motion(GdkEventMotion*);
-    void process_mouse_scroll(GdkEventScroll*);
+    void process_mouse_scroll(GdkEventScroll*, jint);
     void process_mouse_cross(GdkEventCrossing*);
     void process_key(GdkEventKey*);
     void process_state(GdkEventWindowState*);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,19 +23,12 @@
  * questions.
  */
 
-package com.sun.javafx.font.freetype;
+package com.sun.glass.ui.gtk;
+
+public class GtkApplicationShim {
+
+    public static long[] getEventCounts() {
+        return GtkApplication.getEventCounts();
+    }
 
-class PangoGlyphString {
-    /* Fields from PangoItem */
-    int offset;
-    int length;
-    int num_chars;
-    /* pangoItem->analysis->font*/
-    long font;
-    int num_glyphs;
-    /* PangoGlyphInfo->glyph */
-    int[] glyphs;
-    /* PangoGlyphInfo->PangoGlyphGeometry->width */
-    int[] widths;
-    int[] log_clusters;
 }
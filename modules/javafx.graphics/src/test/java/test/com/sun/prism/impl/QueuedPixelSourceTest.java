@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.prism.impl;
+
+import com.sun.glass.ui.Pixels;
+import com.sun.glass.ui.View;
+import com.sun.prism.impl.QueuedPixelSource;
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+import org.junit.Before;
+import org.junit.Test;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertNull;
+
+public class QueuedPixelSourceTest {
+
+    private static final int WIDTH = 100;
+    private static final int HEIGHT = 100;
+
+    private static class TestPixels extends Pixels {
+        TestPixels(int w, int h) {
+            super(w, h, IntBuffer.allocate(w * h));
+        }
+
+        @Override protected void _fillDirectByteBuffer(ByteBuffer bb) {}
+        @Override protected void _attachInt(long ptr, int w, int h, IntBuffer ints, int[] array, int offset) {}
+        @Override protected void _attachByte(long ptr, int w, int h, ByteBuffer bytes, byte[] array, int offset) {}
+    }
+
+    private QueuedPixelSource source;
+
+    private static int[] rects(int count, int x) {
+        int[] rects = new int[4 * count];
+        for (int i = 0; i < count; i++) {
+            rects[4 * i] = x + i;
+            rects[4 * i + 1] = i;
+            rects[4 * i + 2] = 1;
+            rects[4 * i + 3] = 1;
+        }
+        return rects;
+    }
+
+    private int[] consume() {
+        Pixels pixels = source.getLatestPixels();
+        int[] damage = source.getLatestDamage();
+        source.doneWithPixels(pixels);
+        return damage;
+    }
+
+    @Before
+    public void setUp() {
+        source = new QueuedPixelSource(false);
+        // The first frame is always presented entirely
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(1, 0), 1);
+        assertNull(consume());
+    }
+
+    @Test
+    public void testDamageOfSingleDelivery() {
+        int[] rects = rects(3, 0);
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects, 3);
+        assertArrayEquals(rects, consume());
+    }
+
+    @Test
+    public void testDamageAccumulatesOverSupersededDeliveries() {
+        int half = View.MAX_DAMAGE_RECTS / 2;
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(half, 0), half);
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(half, 50), half);
+        int[] expected = new int[8 * half];
+        System.arraycopy(rects(half, 0), 0, expected, 0, 4 * half);
+        System.arraycopy(rects(half, 50), 0, expected, 4 * half, 4 * half);
+        assertArrayEquals(expected, consume());
+    }
+
+    @Test
+    public void testTooManyRectanglesFallBackToEntireFrame() {
+        // ViewPainter produces fewer rectangles per frame than the limit,
+        // it is reached by deliveries the consumer did not pick up
+        int count = View.MAX_DAMAGE_RECTS / 2 + 1;
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(count, 0), count);
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(count, 50), count);
+        assertNull(consume());
+        // and the next frame tracks its damage again
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(1, 0), 1);
+        assertArrayEquals(rects(1, 0), consume());
+    }
+
+    @Test
+    public void testEntireFrameDeliveryFallsBack() {
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT), rects(1, 0), 1);
+        source.enqueuePixels(new TestPixels(WIDTH, HEIGHT));
+        assertNull(consume());
+    }
+
+    @Test
+    public void testResizeFallsBack() {
+        source.enqueuePixels(new TestPixels(WIDTH * 2, HEIGHT), rects(1, 0), 1);
+        assertNull(consume());
+    }
+}
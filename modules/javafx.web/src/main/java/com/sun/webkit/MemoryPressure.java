@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.lang.annotation.Native;
+
+/**
+ * A collection of static methods for memory pressure management.
+ * <p>
+ * The web engine cannot see the Java heap, the direct buffer limit or the
+ * budgets of the application, so the application reports memory pressure
+ * and sets a memory budget through this class. The caches, the decoded
+ * image data, the JavaScript heap and the JIT code of the web engine are
+ * shared by all web pages, so the budget covers all of them.
+ * <p>
+ * Memory is released in stages: first the caches (the memory cache, the
+ * page cache and the font cache), then the decoded image data, and last
+ * the JIT code together with a garbage collection.
+ * <p>
+ * All methods must be called on the event thread.
+ */
+public final class MemoryPressure {
+
+    /**
+     * There is no memory pressure. If a budget is set, the caches and the
+     * decoded image data are released until the web engine is within it.
+     * The JIT code is kept and no garbage is collected.
+     */
+    @Native public static final int LEVEL_NONE = 0;
+
+    /**
+     * There is moderate memory pressure. The caches and the decoded image
+     * data are released, or only as much of them as it takes to get
+     * within the budget if one is set.
+     */
+    @Native public static final int LEVEL_MODERATE = 1;
+
+    /**
+     * There is critical memory pressure. Everything that can be released
+     * is released, including the JIT code, and garbage is collected.
+     */
+    @Native public static final int LEVEL_CRITICAL = 2;
+
+    @Native private static final int USAGE_MEMORY_CACHE = 0;
+    @Native private static final int USAGE_DECODED_IMAGES = 1;
+    @Native private static final int USAGE_JAVASCRIPT_HEAP = 2;
+    @Native private static final int USAGE_JIT_CODE = 3;
+    @Native private static final int USAGE_PAGE_CACHE_PAGES = 4;
+    @Native private static final int USAGE_FONT_CACHE_FONTS = 5;
+    @Native private static final int USAGE_COUNT = 6;
+
+    /**
+     * A snapshot of the memory held by the web engine.
+     */
+    public static final class Usage {
+        private final long[] usage;
+
+        private Usage(long[] usage) {
+            this.usage = usage;
+        }
+
+        /**
+         * Returns the size of the memory cache, in bytes. This includes
+         * the decoded image data.
+         */
+        public long getMemoryCacheBytes() {
+            return usage[USAGE_MEMORY_CACHE];
+        }
+
+        /**
+         * Returns the size of the decoded image data in the memory cache,
+         * in bytes.
+         */
+        public long getDecodedImageBytes() {
+            return usage[USAGE_DECODED_IMAGES];
+        }
+
+        /**
+         * Returns the size of the JavaScript heap, in bytes, including
+         * the memory held by array buffers and other JavaScript objects.
+         */
+        public long getJavaScriptHeapBytes() {
+            return usage[USAGE_JAVASCRIPT_HEAP];
+        }
+
+        /**
+         * Returns the size of the JIT code, in bytes.
+         */
+        public long getJITCodeBytes() {
+            return usage[USAGE_JIT_CODE];
+        }
+
+        /**
+         * Returns the number of pages in the page cache.
+         */
+        public long getPageCachePages() {
+            return usage[USAGE_PAGE_CACHE_PAGES];
+        }
+
+        /**
+         * Returns the number of fonts in the font cache.
+         */
+        public long getFontCacheFonts() {
+            return usage[USAGE_FONT_CACHE_FONTS];
+        }
+
+        /**
+         * Returns the memory that is tracked against the budget, in bytes.
+         */
+        public long getTotalBytes() {
+            return getMemoryCacheBytes() + getJavaScriptHeapBytes()
+                    + getJITCodeBytes();
+        }
+
+        @Override
+        public String toString() {
+            return "memoryCache=" + getMemoryCacheBytes()
+                    + ", decodedImages=" + getDecodedImageBytes()
+                    + ", javaScriptHeap=" + getJavaScriptHeapBytes()
+                    + ", jitCode=" + getJITCodeBytes()
+                    + ", pageCachePages=" + getPageCachePages()
+                    + ", fontCacheFonts=" + getFontCacheFonts();
+        }
+    }
+
+    /**
+     * The private default constructor. Ensures non-instantiability.
+     */
+    private MemoryPressure() {
+        throw new AssertionError();
+    }
+
+
+    /**
+     * Reports the memory pressure on the application and releases memory
+     * accordingly.
+     * @param level one of {@link #LEVEL_NONE}, {@link #LEVEL_MODERATE}
+     *        and {@link #LEVEL_CRITICAL}.
+     * @throws IllegalArgumentException if {@code level} is not a level.
+     */
+    public static void setLevel(int level) {
+        if (level < LEVEL_NONE || level > LEVEL_CRITICAL) {
+            throw new IllegalArgumentException(
+                    "level is invalid:" + level);
+        }
+        Invoker.getInvoker().checkEventThread();
+        twkSetLevel(level);
+    }
+
+    /**
+     * Returns the memory budget.
+     * @return the current memory budget, in bytes, or 0 if there is none.
+     */
+    public static long getBudget() {
+        return twkGetBudget();
+    }
+
+    /**
+     * Sets the memory budget. The memory cache is given a share of the
+     * budget and memory is released until the web engine is within it.
+     * @param budget specifies the new memory budget, in bytes, or 0 to
+     *        remove the budget.
+     * @throws IllegalArgumentException if {@code budget} is negative.
+     */
+    public static void setBudget(long budget) {
+        if (budget < 0) {
+            throw new IllegalArgumentException(
+                    "budget is negative:" + budget);
+        }
+        Invoker.getInvoker().checkEventThread();
+        twkSetBudget(budget);
+    }
+
+    /**
+     * Releases the caches and the decoded image data if the web engine is
+     * not within the budget. The JIT code is left alone, so that a budget
+     * that can not be met does not cost a garbage collection and a
+     * recompilation on every page load.
+     */
+    static void checkBudget() {
+        twkCheckBudget();
+    }
+
+    /**
+     * Returns the memory held by the web engine.
+     */
+    public static Usage getUsage() {
+        Invoker.getInvoker().checkEventThread();
+        return new Usage(twkGetUsage());
+    }
+
+    native private static void twkSetLevel(int level);
+    native private static long twkGetBudget();
+    native private static void twkSetBudget(long budget);
+    native private static void twkCheckBudget();
+    native private static long[] twkGetUsage();
+}
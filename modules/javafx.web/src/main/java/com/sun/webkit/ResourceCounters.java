@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.lang.annotation.Native;
+
+/**
+ * A snapshot of the resources that a web page has used since its resource
+ * accounting was enabled, as returned by
+ * {@link WebPage#getResourceCounters()}.
+ * <p>
+ * Times are main thread CPU times. The time of an activity that runs
+ * within another, such as a layout forced by a script, only counts for the
+ * inner activity, so the times of the activities add up. Memory is
+ * measured when the snapshot is taken. A resource that several pages use
+ * counts for each of them.
+ */
+public final class ResourceCounters {
+
+    /** Style resolution. */
+    @Native public static final int ACTIVITY_STYLE = 0;
+    /** Layout. */
+    @Native public static final int ACTIVITY_LAYOUT = 1;
+    /** Painting, including the painting of composited layers. */
+    @Native public static final int ACTIVITY_PAINT = 2;
+    /** JavaScript, including the garbage collections it runs into. */
+    @Native public static final int ACTIVITY_SCRIPT = 3;
+
+    @Native private static final int ACTIVITY_COUNT = 4;
+    @Native private static final int INDEX_TIME = 0;
+    @Native private static final int INDEX_COUNT = INDEX_TIME + ACTIVITY_COUNT;
+    @Native private static final int INDEX_GC_TIME = INDEX_COUNT + ACTIVITY_COUNT;
+    @Native private static final int INDEX_EVICTIONS = INDEX_GC_TIME + 1;
+    @Native private static final int INDEX_RESOURCE_BYTES = INDEX_EVICTIONS + 1;
+    @Native private static final int INDEX_DECODED_IMAGE_BYTES = INDEX_RESOURCE_BYTES + 1;
+    @Native private static final int INDEX_PAGE_CACHE_BYTES = INDEX_DECODED_IMAGE_BYTES + 1;
+    @Native private static final int INDEX_PAGE_CACHE_PAGES = INDEX_PAGE_CACHE_BYTES + 1;
+    @Native private static final int SIZE = INDEX_PAGE_CACHE_PAGES + 1;
+
+    private final long[] counters;
+
+    ResourceCounters(long[] counters) {
+        if (counters.length != SIZE) {
+            throw new IllegalArgumentException(
+                    "unexpected number of counters:" + counters.length);
+        }
+        this.counters = counters;
+    }
+
+    private static int checkActivity(int activity) {
+        if (activity < 0 || activity >= ACTIVITY_COUNT) {
+            throw new IllegalArgumentException(
+                    "activity is invalid:" + activity);
+        }
+        return activity;
+    }
+
+    /**
+     * Returns the CPU time spent in an activity, in microseconds.
+     * @param activity one of the {@code ACTIVITY_} constants.
+     */
+    public long getTime(int activity) {
+        return counters[INDEX_TIME + checkActivity(activity)];
+    }
+
+    /**
+     * Returns the number of times an activity ran.
+     * @param activity one of the {@code ACTIVITY_} constants.
+     */
+    public long getCount(int activity) {
+        return counters[INDEX_COUNT + checkActivity(activity)];
+    }
+
+    /**
+     * Returns the time of the garbage collections that finished while the
+     * JavaScript of the page ran, in microseconds. Collections partly run
+     * on other threads, so this is wall clock time.
+     */
+    public long getGarbageCollectionTime() {
+        return counters[INDEX_GC_TIME];
+    }
+
+    /**
+     * Returns the number of times the page exceeded its soft limit and had
+     * its caches evicted.
+     */
+    public long getEvictionCount() {
+        return counters[INDEX_EVICTIONS];
+    }
+
+    /**
+     * Returns the size of the resources that the documents of the page
+     * use, in bytes, including their decoded data.
+     */
+    public long getResourceBytes() {
+        return counters[INDEX_RESOURCE_BYTES];
+    }
+
+    /**
+     * Returns the size of the decoded image data of the page, in bytes.
+     */
+    public long getDecodedImageBytes() {
+        return counters[INDEX_DECODED_IMAGE_BYTES];
+    }
+
+    /**
+     * Returns the size of the resources that the page cache holds for the
+     * page and that its current documents do not use, in bytes.
+     */
+    public long getPageCacheBytes() {
+        return counters[INDEX_PAGE_CACHE_BYTES];
+    }
+
+    /**
+     * Returns the number of pages that the page cache holds for the page.
+     */
+    public long getPageCachePages() {
+        return counters[INDEX_PAGE_CACHE_PAGES];
+    }
+
+    /**
+     * Returns the memory that is checked against the soft limit, in bytes.
+     */
+    public long getTotalBytes() {
+        return getResourceBytes() + getPageCacheBytes();
+    }
+
+    @Override
+    public String toString() {
+        return "style=" + getTime(ACTIVITY_STYLE) + "us/" + getCount(ACTIVITY_STYLE)
+                + ", layout=" + getTime(ACTIVITY_LAYOUT) + "us/" + getCount(ACTIVITY_LAYOUT)
+                + ", paint=" + getTime(ACTIVITY_PAINT) + "us/" + getCount(ACTIVITY_PAINT)
+                + ", script=" + getTime(ACTIVITY_SCRIPT) + "us/" + getCount(ACTIVITY_SCRIPT)
+                + ", gc=" + getGarbageCollectionTime() + "us"
+                + ", resources=" + getResourceBytes()
+                + ", decodedImages=" + getDecodedImageBytes()
+                + ", pageCache=" + getPageCacheBytes() + "/" + getPageCachePages()
+                + ", evictions=" + getEvictionCount();
+    }
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.lang.annotation.Native;
+import java.nio.BufferUnderflowException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.Date;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * The result of a script evaluated by
+ * {@link WebPage#executeScriptForResult}, serialized by the native code
+ * in a single pass instead of being wrapped in a {@code JSObject} whose
+ * members are then fetched one JNI call at a time.
+ * <p>
+ * The data buffer holds one value in native byte order, as a tag byte
+ * followed by the payload of the tag:
+ * <pre>
+ * TAG_UNDEFINED, TAG_NULL, TAG_FALSE, TAG_TRUE, TAG_OPAQUE   (none)
+ * TAG_NUMBER, TAG_DATE                                      double
+ * TAG_STRING                                                int length, length UTF-16 chars
+ * TAG_ARRAY                                                 int count, count values
+ * TAG_OBJECT                                                int count, count (string key, value) pairs
+ * TAG_TYPED_ARRAY                                           int JSTypedArrayType, int buffer index
+ * </pre>
+ * where a string key is encoded like a {@code TAG_STRING} payload.
+ * Functions, cyclic references and values nested deeper than
+ * {@code MAX_DEPTH} are written as {@code TAG_OPAQUE}.
+ * <p>
+ * Typed arrays and array buffers are not copied: the buffer returned by
+ * {@link #getBuffer} for their index is a view of the memory of the
+ * script object, which is kept alive while the buffer is reachable.
+ * Like every other access to the page it must only be used on the
+ * event thread.
+ */
+public final class ScriptResult {
+    @Native public static final int TAG_UNDEFINED = 0;
+    @Native public static final int TAG_NULL = 1;
+    @Native public static final int TAG_FALSE = 2;
+    @Native public static final int TAG_TRUE = 3;
+    @Native public static final int TAG_NUMBER = 4;
+    @Native public static final int TAG_STRING = 5;
+    @Native public static final int TAG_ARRAY = 6;
+    @Native public static final int TAG_OBJECT = 7;
+    @Native public static final int TAG_DATE = 8;
+    @Native public static final int TAG_TYPED_ARRAY = 9;
+    @Native public static final int TAG_OPAQUE = 10;
+
+    @Native public static final int MAX_DEPTH = 512;
+
+    /**
+     * The value {@link #toJava} returns for functions, cyclic references
+     * and values nested too deeply.
+     */
+    public static final Object OPAQUE = new Object() {
+        @Override public String toString() {
+            return "[opaque]";
+        }
+    };
+
+    private final ByteBuffer data;
+    private final ByteBuffer[] buffers;
+
+    ScriptResult(ByteBuffer[] buffers) {
+        this.data = buffers[0].order(ByteOrder.nativeOrder()).asReadOnlyBuffer();
+        this.buffers = new ByteBuffer[buffers.length - 1];
+        for (int i = 1; i < buffers.length; i++) {
+            this.buffers[i - 1] = buffers[i].order(ByteOrder.nativeOrder());
+        }
+    }
+
+    /**
+     * Returns a read-only view of the serialized value, positioned at its
+     * first tag.
+     */
+    public ByteBuffer getData() {
+        return data.duplicate().order(ByteOrder.nativeOrder());
+    }
+
+    public int getBufferCount() {
+        return buffers.length;
+    }
+
+    /**
+     * Returns the memory of the typed array with the given index.
+     */
+    public ByteBuffer getBuffer(int index) {
+        return buffers[index].duplicate().order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Decodes the value into plain Java objects: {@code String},
+     * {@code Boolean}, {@code Integer} or {@code Double} for numbers, as
+     * {@code WebEngine.executeScript} does, {@code Date}, or {@code null} for an invalid date, {@code List},
+     * {@code Map} with the properties in enumeration order, and
+     * {@code ByteBuffer} for typed arrays. {@code undefined} is returned
+     * as the string "undefined", also like {@code executeScript}.
+     */
+    public Object toJava() {
+        ByteBuffer in = getData();
+        try {
+            return read(in);
+        } catch (BufferUnderflowException ex) {
+            throw new IllegalStateException("Truncated script result", ex);
+        }
+    }
+
+    private Object read(ByteBuffer in) {
+        int tag = in.get();
+        switch (tag) {
+            case TAG_UNDEFINED:
+                return "undefined";
+            case TAG_NULL:
+                return null;
+            case TAG_FALSE:
+                return Boolean.FALSE;
+            case TAG_TRUE:
+                return Boolean.TRUE;
+            case TAG_NUMBER: {
+                double value = in.getDouble();
+                int intValue = (int) value;
+                if (intValue == value
+                        && (intValue != 0 || Double.doubleToRawLongBits(value) == 0L)) {
+                    return intValue;
+                }
+                return value;
+            }
+            case TAG_STRING:
+                return readString(in);
+            case TAG_ARRAY: {
+                int count = in.getInt();
+                List<Object> list = new ArrayList<>(count);
+                for (int i = 0; i < count; i++) {
+                    list.add(read(in));
+                }
+                return list;
+            }
+            case TAG_OBJECT: {
+                int count = in.getInt();
+                Map<String, Object> map = new LinkedHashMap<>();
+                for (int i = 0; i < count; i++) {
+                    String key = readString(in);
+                    map.put(key, read(in));
+                }
+                return map;
+            }
+            case TAG_DATE: {
+                double time = in.getDouble();
+                return Double.isNaN(time) ? null : new Date((long) time);
+            }
+            case TAG_TYPED_ARRAY:
+                in.getInt();
+                return getBuffer(in.getInt());
+            case TAG_OPAQUE:
+                return OPAQUE;
+            default:
+                throw new IllegalStateException("Unknown tag: " + tag);
+        }
+    }
+
+    private static String readString(ByteBuffer in) {
+        int length = in.getInt();
+        char[] chars = new char[length];
+        in.asCharBuffer().get(chars);
+        in.position(in.position() + length * 2);
+        return new String(chars);
+    }
+}
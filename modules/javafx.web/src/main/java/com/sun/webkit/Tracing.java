@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.io.IOException;
+import java.lang.annotation.Native;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * A collection of static methods for tracing the work of the web engine.
+ * <p>
+ * While tracing is enabled, the web engine records the phases of every
+ * frame it updates (the style recalculation, the layout, the painting and
+ * the layer synchronization of each {@link WebPage}), as well as the
+ * JavaScript it runs, the images it decodes and the size of every buffer
+ * it flushes to the rendering queue. The events are recorded into a fixed
+ * size ring buffer, which the application drains and may export in the
+ * Chrome trace event format. Events that do not fit into the buffer are
+ * dropped and counted, so the buffer should be drained at least every few
+ * frames.
+ * <p>
+ * While tracing is disabled the recording costs next to nothing, so it
+ * can be enabled and disabled at any time.
+ * <p>
+ * All methods that access the web engine must be called on the event
+ * thread.
+ */
+public final class Tracing {
+
+    @Native private static final int RECORD_TIMESTAMP = 0;
+    @Native private static final int RECORD_CODE = 1;
+    @Native private static final int RECORD_THREAD = 2;
+    @Native private static final int RECORD_DATA = 3;
+    @Native private static final int RECORD_SIZE = 4;
+
+    /**
+     * The phase of an event that begins an interval.
+     */
+    @Native public static final char PHASE_BEGIN = 'B';
+
+    /**
+     * The phase of an event that ends an interval.
+     */
+    @Native public static final char PHASE_END = 'E';
+
+    /**
+     * The phase of an event that samples a counter, such as the size of
+     * a rendering queue flush.
+     */
+    @Native public static final char PHASE_COUNTER = 'C';
+
+    /**
+     * The phase of an event that marks an instant.
+     */
+    @Native public static final char PHASE_INSTANT = 'i';
+
+    private static final Map<Integer, Description> descriptions =
+            new HashMap<>();
+
+    private static boolean enabled;
+
+    private static final class Description {
+        private final String name;
+        private final char phase;
+
+        private Description(int code) {
+            String name = twkGetName(code);
+            this.name = name != null ? name : "TracePoint" + code;
+            this.phase = twkGetPhase(code);
+        }
+    }
+
+    /**
+     * A traced event.
+     */
+    public static final class Event {
+        private final long timestamp;
+        private final Description description;
+        private final int thread;
+        private final long data;
+
+        private Event(long timestamp, Description description, int thread,
+                      long data) {
+            this.timestamp = timestamp;
+            this.description = description;
+            this.thread = thread;
+            this.data = data;
+        }
+
+        /**
+         * Returns the time of the event, in nanoseconds. The time is
+         * monotonic and only meaningful relative to other events.
+         */
+        public long getTimestamp() {
+            return timestamp;
+        }
+
+        /**
+         * Returns the name of the event. The events that begin and end an
+         * interval have the same name.
+         */
+        public String getName() {
+            return description.name;
+        }
+
+        /**
+         * Returns the phase of the event, one of {@link #PHASE_BEGIN},
+         * {@link #PHASE_END}, {@link #PHASE_COUNTER} and
+         * {@link #PHASE_INSTANT}.
+         */
+        public char getPhase() {
+            return description.phase;
+        }
+
+        /**
+         * Returns the identifier of the thread the event occurred on.
+         */
+        public int getThread() {
+            return thread;
+        }
+
+        /**
+         * Returns the value of a counter event, such as the number of
+         * bytes of a rendering queue flush, or 0 for the other events.
+         */
+        public long getData() {
+            return data;
+        }
+
+        @Override
+        public String toString() {
+            return getPhase() + " " + getName() + " @" + getTimestamp()
+                    + (getPhase() == PHASE_COUNTER ? " " + getData() : "");
+        }
+    }
+
+    /**
+     * The private default constructor. Ensures non-instantiability.
+     */
+    private Tracing() {
+        throw new AssertionError();
+    }
+
+
+    /**
+     * Returns whether tracing is enabled.
+     */
+    public static boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Enables or disables tracing. The events recorded so far are kept
+     * until they are drained.
+     */
+    public static void setEnabled(boolean enabled) {
+        Invoker.getInvoker().checkEventThread();
+        Tracing.enabled = enabled;
+        twkSetEnabled(enabled);
+    }
+
+    /**
+     * Removes the recorded events from the buffer and returns them, in
+     * the order they were recorded in.
+     */
+    public static List<Event> drain() {
+        Invoker.getInvoker().checkEventThread();
+        long[] records = twkDrain();
+        if (records.length == 0) {
+            return Collections.emptyList();
+        }
+        List<Event> events = new ArrayList<>(records.length / RECORD_SIZE);
+        for (int i = 0; i < records.length; i += RECORD_SIZE) {
+            int code = (int) records[i + RECORD_CODE];
+            events.add(new Event(
+                    records[i + RECORD_TIMESTAMP],
+                    descriptions.computeIfAbsent(code, Description::new),
+                    (int) records[i + RECORD_THREAD],
+                    records[i + RECORD_DATA]));
+        }
+        return events;
+    }
+
+    /**
+     * Returns the number of events that were dropped because the buffer
+     * was full since the last call.
+     */
+    public static long takeDroppedCount() {
+        Invoker.getInvoker().checkEventThread();
+        return twkTakeDroppedCount();
+    }
+
+    /**
+     * Writes events in the Chrome trace event format, which can be loaded
+     * into about:tracing and similar tools.
+     * @param events the events to write, as returned by {@link #drain}.
+     * @param out the destination to write the trace to.
+     * @throws IOException if writing to {@code out} fails.
+     */
+    public static void writeChromeTrace(List<Event> events, Appendable out)
+            throws IOException {
+        long pid = ProcessHandle.current().pid();
+        out.append("{\"traceEvents\":[");
+        boolean first = true;
+        for (Event event : events) {
+            if (!first) {
+                out.append(',');
+            }
+            first = false;
+            out.append("\n{\"name\":\"").append(event.getName())
+                    .append("\",\"cat\":\"webkit\",\"ph\":\"")
+                    .append(event.getPhase())
+                    .append("\",\"ts\":")
+                    .append(Double.toString(event.getTimestamp() / 1000.0))
+                    .append(",\"pid\":").append(Long.toString(pid))
+                    .append(",\"tid\":")
+                    .append(Integer.toString(event.getThread()));
+            switch (event.getPhase()) {
+                case PHASE_COUNTER:
+                    out.append(",\"args\":{\"bytes\":")
+                            .append(Long.toString(event.getData()))
+                            .append('}');
+                    break;
+                case PHASE_INSTANT:
+                    out.append(",\"s\":\"t\"");
+                    break;
+            }
+            out.append('}');
+        }
+        out.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+    }
+
+    native private static void twkSetEnabled(boolean enabled);
+    native private static long[] twkDrain();
+    native private static long twkTakeDroppedCount();
+    native private static String twkGetName(int code);
+    native private static char twkGetPhase(int code);
+}
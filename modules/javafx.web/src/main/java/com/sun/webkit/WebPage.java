@@ -59,6 +59,7 @@ import java.util.concurrent.locks.ReentrantLock;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 import netscape.javascript.JSException;
+import netscape.javascript.JSObject;
 import org.w3c.dom.Document;
 import org.w3c.dom.Element;
 
@@ -1513,6 +1514,97 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Like {@link #executeScript}, but serializes the result into a
+     * {@link ScriptResult} in one native call.
+     */
+    public ScriptResult executeScriptForResult(long frameID, String script) throws JSException {
+        lockPage();
+        try {
+            log.log(Level.FINE, "execute script for result: \"" + script + "\" in frame = " + frameID);
+            if (isDisposed) {
+                log.log(Level.FINE, "executeScriptForResult() request for a disposed web page.");
+                return null;
+            }
+            if ((frameID == 0) || !frames.contains(frameID)) {
+                return null;
+            }
+            final long pResult = twkExecuteScriptForResult(frameID, script);
+            if (pResult == 0L) {
+                return null;
+            }
+            try {
+                // Each buffer holds a reference to the native result
+                ByteBuffer[] buffers = twkGetScriptResultBuffers(pResult);
+                if (buffers == null) {
+                    throw new OutOfMemoryError("Unable to allocate the script result buffers");
+                }
+                for (ByteBuffer buffer : buffers) {
+                    Disposer.addRecord(buffer, () -> twkReleaseScriptResult(pResult));
+                }
+                return new ScriptResult(buffers);
+            } finally {
+                twkReleaseScriptResult(pResult);
+            }
+        } finally {
+            unlockPage();
+        }
+    }
+
+    /**
+     * Returns a JavaScript ArrayBuffer in the frame over the remaining bytes
+     * of a direct buffer, without copying them. Writes on either side are
+     * visible to the other. The buffer stays reachable for as long as the
+     * ArrayBuffer is, and the ArrayBuffer does not keep anything on the Java
+     * side alive. ArrayBuffers and typed arrays created by scripts can be
+     * viewed from Java the same way through {@link #executeScriptForResult}.
+     *
+     * @throws IllegalArgumentException if the buffer is not direct or is
+     *         read-only
+     */
+    public JSObject createArrayBuffer(long frameID, ByteBuffer buffer) {
+        if (!buffer.isDirect() || buffer.isReadOnly()) {
+            throw new IllegalArgumentException("The buffer must be direct and writable");
+        }
+        lockPage();
+        try {
+            log.log(Level.FINE, "create array buffer in frame = " + frameID);
+            if (isDisposed) {
+                log.log(Level.FINE, "createArrayBuffer() request for a disposed web page.");
+                return null;
+            }
+            if ((frameID == 0) || !frames.contains(frameID)) {
+                return null;
+            }
+            return (JSObject) twkCreateArrayBuffer(frameID, buffer, buffer.position(), buffer.remaining());
+        } finally {
+            unlockPage();
+        }
+    }
+
+    /**
+     * Compiles the script for the frame without running it. A later call
+     * to {@link #executeScript} with the same script text only links the
+     * compiled code, so large injected scripts can be prepared while the
+     * page is still loading. Syntax errors are reported on execution.
+     */
+    public void prepareScript(long frameID, String script) {
+        lockPage();
+        try {
+            log.log(Level.FINE, "prepare script in frame = " + frameID);
+            if (isDisposed) {
+                log.log(Level.FINE, "prepareScript() request for a disposed web page.");
+                return;
+            }
+            if ((frameID == 0) || !frames.contains(frameID)) {
+                return;
+            }
+            twkPrepareScript(frameID, script);
+        } finally {
+            unlockPage();
+        }
+    }
+
     public long getMainFrame() {
         lockPage();
         try {
@@ -2341,6 +2433,12 @@ public final class WebPage {
                 ", progress = " + progress + ", error = " + errorCode);
 
         fireLoadEvent(frameID, state, url, contentType, progress, errorCode);
+
+        // Subframes finish loading on their own, so only the main frame is
+        // checked to keep the check to once per page load
+        if (state == LoadListenerClient.PAGE_FINISHED && frameID == getMainFrame()) {
+            MemoryPressure.checkBudget();
+        }
     }
 
     private void fwkFireResourceLoadEvent(long frameID, int state,
@@ -2465,6 +2563,131 @@ public final class WebPage {
         return result;
     }
 
+    // ---- Profiling support ---- //
+
+    /**
+     * Starts sampling the JavaScript stacks of every page in the process,
+     * once per interval. Returns {@code false} if the sampling profiler is
+     * not available on this platform.
+     */
+    public static boolean startSamplingProfiler(int intervalMicros) {
+        Invoker.getInvoker().checkEventThread();
+        if (intervalMicros <= 0) {
+            throw new IllegalArgumentException("The interval must be positive");
+        }
+        return twkStartSamplingProfiler(intervalMicros);
+    }
+
+    /**
+     * Stops sampling. Samples taken so far are kept until drained.
+     */
+    public static void stopSamplingProfiler() {
+        Invoker.getInvoker().checkEventThread();
+        twkStopSamplingProfiler();
+    }
+
+    /**
+     * Returns the samples taken since the last call as folded stacks, the
+     * input format of flame graph tools, and discards them. Each line is a
+     * distinct stack from the outermost frame to the innermost, separated
+     * by semicolons, followed by a space and the number of samples. A frame
+     * is the function name, then for script functions the URL, line and
+     * column and the tier the code ran in, as in
+     * {@code render http://host/app.js:12:5 [DFG]}. Returns {@code null} if
+     * the profiler was never started.
+     */
+    public static String drainSamplingProfile() {
+        Invoker.getInvoker().checkEventThread();
+        return twkDrainSamplingProfile();
+    }
+
+    /**
+     * Collects garbage and writes a snapshot of the JavaScript heap shared
+     * by every page in the process to the file as it is built, in the
+     * compact binary format of JavaScriptCore's HeapSnapshotBuilder. Unlike
+     * the inspector snapshot, the memory used does not grow with the heap.
+     * JavaScriptCore/Scripts/convert-heap-snapshot.py converts the file to
+     * the JSON format that the Web Inspector reads.
+     *
+     * @return {@code false} if the file could not be written
+     */
+    public static boolean writeHeapSnapshot(String path) {
+        Invoker.getInvoker().checkEventThread();
+        return twkWriteHeapSnapshot(path);
+    }
+
+    /**
+     * Starts or stops attributing CPU time and memory to this page. The
+     * counters start from zero each time accounting is enabled, and the
+     * soft limit is removed when it is disabled.
+     */
+    public void setResourceAccountingEnabled(boolean enabled) {
+        lockPage();
+        try {
+            if (isDisposed) {
+                log.log(Level.FINE, "setResourceAccountingEnabled() request for a disposed web page.");
+                return;
+            }
+            twkSetResourceAccountingEnabled(getPage(), enabled);
+        } finally {
+            unlockPage();
+        }
+    }
+
+    /**
+     * Returns the resources this page has used since resource accounting
+     * was enabled, or {@code null} if it is not enabled.
+     */
+    public ResourceCounters getResourceCounters() {
+        lockPage();
+        try {
+            if (isDisposed) {
+                log.log(Level.FINE, "getResourceCounters() request for a disposed web page.");
+                return null;
+            }
+            long[] counters = twkGetResourceCounters(getPage());
+            return counters != null ? new ResourceCounters(counters) : null;
+        } finally {
+            unlockPage();
+        }
+    }
+
+    /**
+     * Sets the memory this page may hold before its page cache entries
+     * and decoded image data are evicted, leaving other pages alone.
+     * Images that other pages also use keep their decoded data. The
+     * limit is checked now and whenever a load finishes, against
+     * {@link ResourceCounters#getTotalBytes()}. Resource accounting must
+     * be enabled.
+     *
+     * @param bytes the soft limit, or 0 for none
+     */
+    public void setResourceSoftLimit(long bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("The soft limit must not be negative");
+        }
+        lockPage();
+        try {
+            if (isDisposed) {
+                log.log(Level.FINE, "setResourceSoftLimit() request for a disposed web page.");
+                return;
+            }
+            if (!twkSetResourceSoftLimit(getPage(), bytes)) {
+                throw new IllegalStateException("Resource accounting is not enabled");
+            }
+        } finally {
+            unlockPage();
+        }
+    }
+
+    private static native boolean twkStartSamplingProfiler(int intervalMicros);
+    private static native void twkStopSamplingProfiler();
+    private static native String twkDrainSamplingProfile();
+    private static native boolean twkWriteHeapSnapshot(String path);
+    private native void twkSetResourceAccountingEnabled(long page, boolean enabled);
+    private native long[] twkGetResourceCounters(long page);
+    private native boolean twkSetResourceSoftLimit(long page, long bytes);
+
     // ---- DumpRenderTree support ---- //
 
     public static int getWorkerThreadCount() {
@@ -2564,6 +2787,11 @@ public final class WebPage {
     private native void twkSetZoomFactor(long pFrame, float zoomFactor, boolean textOnly);
 
     private native Object twkExecuteScript(long pFrame, String script);
+    private native long twkExecuteScriptForResult(long pFrame, String script);
+    private native void twkPrepareScript(long pFrame, String script);
+    private native Object twkCreateArrayBuffer(long pFrame, ByteBuffer buffer, int offset, int length);
+    private static native ByteBuffer[] twkGetScriptResultBuffers(long pResult);
+    private static native void twkReleaseScriptResult(long pResult);
 
     private native void twkReset(long pFrame);
 
@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+#
+# Converts a binary heap snapshot written by HeapSnapshotBuilder::writeSnapshot
+# to the JSON heap snapshot format that the Web Inspector reads. The formats
+# are described in JavaScriptCore/heap/HeapSnapshotBuilder.cpp.
+
+import json
+import os
+import struct
+import sys
+from array import array
+
+MAGIC = b"JSCHeapSnapshot\0"
+VERSION = 1
+EDGE_TYPES = ["Internal", "Property", "Index", "Variable"]
+PROPERTY, VARIABLE = 1, 3
+
+UINT32 = struct.Struct("<I")
+STRING = struct.Struct("<II")
+NODE = struct.Struct("<QIQIB")
+EDGE = struct.Struct("<QQBI")
+
+
+class SnapshotReader:
+    def __init__(self, stream):
+        self.stream = stream
+
+    def read(self, size):
+        data = self.stream.read(size)
+        if len(data) != size:
+            raise Exception("Truncated heap snapshot")
+        return data
+
+    def unpack(self, layout):
+        return layout.unpack(self.read(layout.size))
+
+
+def read_snapshot(stream):
+    reader = SnapshotReader(stream)
+    if reader.read(len(MAGIC)) != MAGIC:
+        raise Exception("Not a binary heap snapshot")
+    version, = reader.unpack(UINT32)
+    if version != VERSION:
+        raise Exception("Unsupported heap snapshot version %d" % version)
+
+    strings = []
+    # Parallel arrays keep multi-gigabyte heaps within reach of a script.
+    node_cells, node_ids, node_sizes, node_classes, node_internal = array("Q"), array("I"), array("Q"), array("I"), array("B")
+    edge_from, edge_to, edge_types, edge_data = array("Q"), array("Q"), array("B"), array("I")
+    while True:
+        tag = reader.read(1)
+        if tag == b"S":
+            string_id, length = reader.unpack(STRING)
+            if string_id != len(strings):
+                raise Exception("String %d out of order" % string_id)
+            strings.append(reader.read(length).decode("utf-8", "replace"))
+        elif tag == b"N":
+            cell, node_id, size, class_name, internal = reader.unpack(NODE)
+            node_cells.append(cell)
+            node_ids.append(node_id)
+            node_sizes.append(size)
+            node_classes.append(class_name)
+            node_internal.append(internal)
+        elif tag == b"E":
+            from_cell, to_cell, edge_type, data = reader.unpack(EDGE)
+            edge_from.append(from_cell)
+            edge_to.append(to_cell)
+            edge_types.append(edge_type)
+            edge_data.append(data)
+        elif tag == b"Z":
+            break
+        else:
+            raise Exception("Unknown record %r" % tag)
+
+    # Node ids, with the <root> as cell 0.
+    ids = {0: 0}
+    for i in range(len(node_cells)):
+        ids[node_cells[i]] = node_ids[i]
+
+    # The JSON lists class names and edge names separately, each in order of first use.
+    class_indexes = {}
+    class_names = ["<root>"]
+    nodes = [0, 0, 0, 0]
+    for i in range(len(node_cells)):
+        index = class_indexes.get(node_classes[i])
+        if index is None:
+            index = class_indexes[node_classes[i]] = len(class_names)
+            class_names.append(strings[node_classes[i]])
+        nodes.extend((node_ids[i], node_sizes[i], index, node_internal[i]))
+    del node_cells, node_sizes, node_classes, node_internal
+
+    # Drop edges to or from cells without a node, then sort them by source.
+    kept = [i for i in range(len(edge_from)) if edge_from[i] in ids and edge_to[i] in ids]
+    kept.sort(key=lambda i: ids[edge_from[i]])
+    name_indexes = {}
+    edge_names = []
+    edges = []
+    for i in kept:
+        data = edge_data[i]
+        if edge_types[i] in (PROPERTY, VARIABLE):
+            index = name_indexes.get(data)
+            if index is None:
+                index = name_indexes[data] = len(edge_names)
+                edge_names.append(strings[data])
+            data = index
+        edges.extend((ids[edge_from[i]], ids[edge_to[i]], edge_types[i], data))
+
+    return {
+        "version": 1,
+        "nodes": nodes,
+        "nodeClassNames": class_names,
+        "edges": edges,
+        "edgeTypes": EDGE_TYPES,
+        "edgeNames": edge_names,
+    }
+
+
+def main(argv):
+    if len(argv) != 3:
+        print("usage: %s <binary snapshot> <json output>" % os.path.basename(argv[0]))
+        return 1
+    with open(argv[1], "rb") as input:
+        snapshot = read_snapshot(input)
+    with open(argv[2], "w") as output:
+        json.dump(snapshot, output, separators=(",", ":"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -2168,6 +2168,7 @@ void Heap::didFinishCollection()
         m_lastFullGCLength = m_afterGC - m_beforeGC;
     else
         m_lastEdenGCLength = m_afterGC - m_beforeGC;
+    m_totalGCLength += m_afterGC - m_beforeGC;
 
 #if ENABLE(RESOURCE_USAGE)
     ASSERT(externalMemorySize() <= extraMemorySize());
@@ -236,6 +236,7 @@ public:
 
     Seconds lastFullGCLength() const { return m_lastFullGCLength; }
     Seconds lastEdenGCLength() const { return m_lastEdenGCLength; }
+    Seconds totalGCLength() const { return m_totalGCLength; }
     void increaseLastFullGCLength(Seconds amount) { m_lastFullGCLength += amount; }
 
     size_t sizeBeforeLastEdenCollection() const { return m_sizeBeforeLastEdenCollect; }
@@ -581,6 +582,7 @@ private:
     VM* m_vm;
     Seconds m_lastFullGCLength;
     Seconds m_lastEdenGCLength;
+    Seconds m_totalGCLength;
 
     Vector<ExecutableBase*> m_executables;
 
@@ -42,6 +42,49 @@ unsigned HeapSnapshotBuilder::nextAvailableObjectIdentifier = 1;
 unsigned HeapSnapshotBuilder::getNextObjectIdentifier() { return nextAvailableObjectIdentifier++; }
 void HeapSnapshotBuilder::resetNextAvailableObjectIdentifier() { HeapSnapshotBuilder::nextAvailableObjectIdentifier = 1; }
 
+// Heap Snapshot Binary Format:
+//
+//   "JSCHeapSnapshot" NUL, <uint32 version>, then records until an end record.
+//   All integers are little-endian.
+//
+//   String: 'S', <uint32 stringId>, <uint32 byteLength>, <UTF-8 bytes>
+//   Node:   'N', <uint64 cell>, <uint32 nodeId>, <uint64 sizeInBytes>, <uint32 classNameStringId>, <uint8 internal>
+//   Edge:   'E', <uint64 fromCell>, <uint64 toCell>, <uint8 edgeType>, <uint32 edgeExtraData>
+//   End:    'Z'
+//
+// Notes:
+//
+//     Records are written while the collector marks, from several threads,
+//     so they come in no particular order. Edges refer to cells by address
+//     and a converter matches them to node identifiers after reading every
+//     node. A cell of 0 is the <root>.
+//
+//     <stringId>
+//       - strings are numbered from 0 in the order written. A string is
+//         written before its first use. Class names and edge names share
+//         the numbering.
+//
+//     <edgeType>
+//       - 0 = Internal, 1 = Property, 2 = Index, 3 = Variable.
+//
+//     <edgeExtraData>
+//       - for Internal edges this should be ignored (0).
+//       - for Index edges this is the index value.
+//       - for Property or Variable edges this is the string id of the name.
+//
+// JavaScriptCore/Scripts/convert-heap-snapshot.py converts this format to the
+// JSON format below.
+
+static const char binaryMagic[] = "JSCHeapSnapshot";
+static const uint32_t binaryVersion = 1;
+static const size_t streamBufferSize = 64 * KB;
+enum : uint8_t {
+    StringRecord = 'S',
+    NodeRecord = 'N',
+    EdgeRecord = 'E',
+    EndRecord = 'Z',
+};
+
 HeapSnapshotBuilder::HeapSnapshotBuilder(HeapProfiler& profiler)
     : m_profiler(profiler)
 {
@@ -66,11 +109,43 @@ void HeapSnapshotBuilder::buildSnapshot()
     m_profiler.appendSnapshot(WTFMove(m_snapshot));
 }
 
+bool HeapSnapshotBuilder::writeSnapshot(FILE* stream)
+{
+    PreventCollectionScope preventCollectionScope(m_profiler.vm().heap);
+
+    m_stream = stream;
+    m_streamFailed = false;
+    m_streamBuffer.reserveInitialCapacity(streamBufferSize);
+    for (const char* magic = binaryMagic; *magic; ++magic)
+        writeUInt8(*magic);
+    writeUInt8(0);
+    writeUInt32(binaryVersion);
+    {
+        m_profiler.setActiveSnapshotBuilder(this);
+        m_profiler.vm().heap.collectAllGarbage();
+        m_profiler.setActiveSnapshotBuilder(nullptr);
+    }
+    writeUInt8(EndRecord);
+    flushStream();
+    bool succeeded = !m_streamFailed && !fflush(m_stream);
+
+    m_stream = nullptr;
+    m_streamBuffer.clear();
+    m_streamStrings.clear();
+    return succeeded;
+}
+
 void HeapSnapshotBuilder::appendNode(JSCell* cell)
 {
     ASSERT(m_profiler.activeSnapshotBuilder() == this);
     ASSERT(Heap::isMarkedConcurrently(cell));
 
+    if (m_stream) {
+        std::lock_guard<Lock> lock(m_streamMutex);
+        writeNode(cell);
+        return;
+    }
+
     if (hasExistingNodeForCell(cell))
         return;
 
@@ -88,6 +163,12 @@ void HeapSnapshotBuilder::appendEdge(JSCell* from, JSCell* to)
     if (from == to)
         return;
 
+    if (m_stream) {
+        std::lock_guard<Lock> lock(m_streamMutex);
+        writeEdge(from, to, EdgeType::Internal, 0);
+        return;
+    }
+
     std::lock_guard<Lock> lock(m_buildingEdgeMutex);
 
     m_edges.append(HeapSnapshotEdge(from, to));
@@ -98,6 +179,12 @@ void HeapSnapshotBuilder::appendPropertyNameEdge(JSCell* from, JSCell* to, Uniqu
     ASSERT(m_profiler.activeSnapshotBuilder() == this);
     ASSERT(to);
 
+    if (m_stream) {
+        std::lock_guard<Lock> lock(m_streamMutex);
+        writeEdge(from, to, EdgeType::Property, writeString(propertyName));
+        return;
+    }
+
     std::lock_guard<Lock> lock(m_buildingEdgeMutex);
 
     m_edges.append(HeapSnapshotEdge(from, to, EdgeType::Property, propertyName));
@@ -108,6 +195,12 @@ void HeapSnapshotBuilder::appendVariableNameEdge(JSCell* from, JSCell* to, Uniqu
     ASSERT(m_profiler.activeSnapshotBuilder() == this);
     ASSERT(to);
 
+    if (m_stream) {
+        std::lock_guard<Lock> lock(m_streamMutex);
+        writeEdge(from, to, EdgeType::Variable, writeString(variableName));
+        return;
+    }
+
     std::lock_guard<Lock> lock(m_buildingEdgeMutex);
 
     m_edges.append(HeapSnapshotEdge(from, to, EdgeType::Variable, variableName));
@@ -118,6 +211,12 @@ void HeapSnapshotBuilder::appendIndexEdge(JSCell* from, JSCell* to, uint32_t ind
     ASSERT(m_profiler.activeSnapshotBuilder() == this);
     ASSERT(to);
 
+    if (m_stream) {
+        std::lock_guard<Lock> lock(m_streamMutex);
+        writeEdge(from, to, EdgeType::Index, index);
+        return;
+    }
+
     std::lock_guard<Lock> lock(m_buildingEdgeMutex);
 
     m_edges.append(HeapSnapshotEdge(from, to, index));
@@ -390,4 +489,90 @@ String HeapSnapshotBuilder::json(std::function<bool (const HeapSnapshotNode&)> a
     return json.toString();
 }
 
+void HeapSnapshotBuilder::writeNode(JSCell* cell)
+{
+    ASSERT(m_streamMutex.isLocked());
+    VM& vm = m_profiler.vm();
+    unsigned classNameId = writeString(cell->classInfo(vm)->className);
+
+    bool isInternal = false;
+    if (!cell->isString()) {
+        Structure* structure = cell->structure(vm);
+        isInternal = !structure || !structure->globalObject();
+    }
+
+    writeUInt8(NodeRecord);
+    writeUInt64(reinterpret_cast<uintptr_t>(cell));
+    writeUInt32(getNextObjectIdentifier());
+    writeUInt64(cell->estimatedSizeInBytes());
+    writeUInt32(classNameId);
+    writeUInt8(isInternal);
+}
+
+void HeapSnapshotBuilder::writeEdge(JSCell* from, JSCell* to, EdgeType type, uint32_t data)
+{
+    ASSERT(m_streamMutex.isLocked());
+    writeUInt8(EdgeRecord);
+    writeUInt64(reinterpret_cast<uintptr_t>(from));
+    writeUInt64(reinterpret_cast<uintptr_t>(to));
+    writeUInt8(edgeTypeToNumber(type));
+    writeUInt32(data);
+}
+
+unsigned HeapSnapshotBuilder::writeString(const char* string)
+{
+    auto it = m_streamStrings.find(string);
+    if (it != m_streamStrings.end())
+        return it->value;
+    return writeString(string, CString(string));
+}
+
+unsigned HeapSnapshotBuilder::writeString(UniquedStringImpl* string)
+{
+    auto it = m_streamStrings.find(string);
+    if (it != m_streamStrings.end())
+        return it->value;
+    return writeString(string, string->utf8());
+}
+
+unsigned HeapSnapshotBuilder::writeString(const void* key, const CString& string)
+{
+    ASSERT(m_streamMutex.isLocked());
+    auto result = m_streamStrings.add(key, m_streamStrings.size());
+    if (!result.isNewEntry)
+        return result.iterator->value;
+
+    writeUInt8(StringRecord);
+    writeUInt32(result.iterator->value);
+    writeUInt32(string.length());
+    m_streamBuffer.append(reinterpret_cast<const uint8_t*>(string.data()), string.length());
+    return result.iterator->value;
+}
+
+void HeapSnapshotBuilder::writeUInt8(uint8_t value)
+{
+    if (m_streamBuffer.size() >= streamBufferSize)
+        flushStream();
+    m_streamBuffer.append(value);
+}
+
+void HeapSnapshotBuilder::writeUInt32(uint32_t value)
+{
+    for (unsigned i = 0; i < 4; ++i)
+        writeUInt8(value >> (i * 8));
+}
+
+void HeapSnapshotBuilder::writeUInt64(uint64_t value)
+{
+    for (unsigned i = 0; i < 8; ++i)
+        writeUInt8(value >> (i * 8));
+}
+
+void HeapSnapshotBuilder::flushStream()
+{
+    if (!m_streamFailed && fwrite(m_streamBuffer.data(), 1, m_streamBuffer.size(), m_stream) != m_streamBuffer.size())
+        m_streamFailed = true;
+    m_streamBuffer.shrink(0);
+}
+
 } // namespace JSC
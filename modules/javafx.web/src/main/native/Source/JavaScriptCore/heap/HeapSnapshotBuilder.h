@@ -26,8 +26,11 @@
 #pragma once
 
 #include <functional>
+#include <stdio.h>
+#include <wtf/HashMap.h>
 #include <wtf/Lock.h>
 #include <wtf/Vector.h>
+#include <wtf/text/CString.h>
 #include <wtf/text/UniquedStringImpl.h>
 #include <wtf/text/WTFString.h>
 
@@ -111,6 +114,11 @@ public:
     // Performs a garbage collection that builds a snapshot of all live cells.
     void buildSnapshot();
 
+    // Performs a garbage collection that writes a snapshot of all live cells
+    // to the file in the binary format as they are found, without keeping it
+    // in memory or adding it to the profiler. Returns false if a write failed.
+    bool writeSnapshot(FILE*);
+
     // A marked cell.
     void appendNode(JSCell*);
 
@@ -128,6 +136,17 @@ private:
     // for an existing node can be done concurrently without a lock.
     bool hasExistingNodeForCell(JSCell*);
 
+    // Binary snapshot writing, see writeSnapshot().
+    void writeNode(JSCell*);
+    void writeEdge(JSCell* from, JSCell* to, EdgeType, uint32_t data);
+    unsigned writeString(const char*);
+    unsigned writeString(UniquedStringImpl*);
+    unsigned writeString(const void* key, const CString&);
+    void writeUInt8(uint8_t);
+    void writeUInt32(uint32_t);
+    void writeUInt64(uint64_t);
+    void flushStream();
+
     HeapProfiler& m_profiler;
 
     // SlotVisitors run in parallel.
@@ -135,6 +154,13 @@ private:
     std::unique_ptr<HeapSnapshot> m_snapshot;
     Lock m_buildingEdgeMutex;
     Vector<HeapSnapshotEdge> m_edges;
+
+    // Set while writing a binary snapshot, all writes hold m_streamMutex.
+    FILE* m_stream { nullptr };
+    Lock m_streamMutex;
+    Vector<uint8_t> m_streamBuffer;
+    HashMap<const void*, unsigned> m_streamStrings;
+    bool m_streamFailed { false };
 };
 
 } // namespace JSC
@@ -24,6 +24,7 @@
 #include "Completion.h"
 
 #include "CallFrame.h"
+#include "CodeCache.h"
 #include "CodeProfiling.h"
 #include "Exception.h"
 #include "IdentifierInlines.h"
@@ -86,6 +87,20 @@ bool checkModuleSyntax(ExecState* exec, const SourceCode& source, ParserError& e
     return true;
 }
 
+void prepareProgram(ExecState* exec, const SourceCode& source)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+    RELEASE_ASSERT(vm.atomicStringTable() == wtfThreadData().atomicStringTable());
+    RELEASE_ASSERT(!vm.isCollectorBusyOnCurrentThread());
+
+    // Use the same code cache key as ProgramExecutable::initializeGlobalProperties().
+    ProgramExecutable* executable = ProgramExecutable::create(exec, source);
+    DebuggerMode debuggerMode = exec->lexicalGlobalObject()->hasInteractiveDebugger() ? DebuggerOn : DebuggerOff;
+    ParserError error;
+    vm.codeCache()->getUnlinkedProgramCodeBlock(vm, executable, source, JSParserStrictMode::NotStrict, debuggerMode, error);
+}
+
 JSValue evaluate(ExecState* exec, const SourceCode& source, JSValue thisValue, NakedPtr<Exception>& returnedException)
 {
     VM& vm = exec->vm();
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#include "config.h"
+#include "IntlCache.h"
+
+#if ENABLE(INTL)
+
+#include <algorithm>
+#include <unicode/ucol.h>
+#include <unicode/udatpg.h>
+#include <unicode/uset.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+Ref<IntlSharedCollator> IntlSharedCollator::create(UCollator* collator)
+{
+    Ref<IntlSharedCollator> result = adoptRef(*new IntlSharedCollator(collator));
+    result->computeASCIIWeights();
+    return result;
+}
+
+IntlSharedCollator::IntlSharedCollator(UCollator* collator)
+    : m_collator(collator)
+{
+    std::fill_n(m_primaryWeights, 128, 0);
+    std::fill_n(m_tieWeights, 128, 0);
+}
+
+IntlSharedCollator::~IntlSharedCollator()
+{
+    ucol_close(m_collator);
+}
+
+// Single ASCII characters have short sort keys: the primary weights, then
+// a separator before the weights of each further level, then a 0.
+static const unsigned maxASCIISortKeyLength = 32;
+static const char sortKeyLevelSeparator = 1;
+
+struct SortKeyLevel {
+    const char* weights;
+    size_t length;
+
+    bool operator==(const SortKeyLevel& other) const { return length == other.length && !memcmp(weights, other.weights, length); }
+    bool operator!=(const SortKeyLevel& other) const { return !(*this == other); }
+};
+
+// Returns the weights of a level of a sort key, 0 being the primary level,
+// or null weights if the key has no such level.
+static SortKeyLevel sortKeyLevel(const uint8_t* key, unsigned level)
+{
+    const char* weights = reinterpret_cast<const char*>(key);
+    for (unsigned i = 0; i < level && weights; ++i) {
+        weights = strchr(weights, sortKeyLevelSeparator);
+        if (weights)
+            ++weights;
+    }
+    if (!weights)
+        return { nullptr, 0 };
+    const char* end = strchr(weights, sortKeyLevelSeparator);
+    return { weights, end ? static_cast<size_t>(end - weights) : strlen(weights) };
+}
+
+void IntlSharedCollator::computeASCIIWeights()
+{
+    // Numeric collation compares digits as numbers and shifted punctuation
+    // is ignorable, so neither compares character by character.
+    UErrorCode status = U_ZERO_ERROR;
+    if (ucol_getAttribute(m_collator, UCOL_NUMERIC_COLLATION, &status) == UCOL_ON
+        || ucol_getAttribute(m_collator, UCOL_ALTERNATE_HANDLING, &status) == UCOL_SHIFTED
+        || U_FAILURE(status))
+        return;
+
+    uint8_t keys[128][maxASCIISortKeyLength];
+    Vector<UChar, 128> characters;
+    for (UChar character = 0; character < 128; ++character) {
+        int32_t length = ucol_getSortKey(m_collator, &character, 1, keys[character], maxASCIISortKeyLength);
+        if (length <= 0 || length > static_cast<int32_t>(maxASCIISortKeyLength))
+            return;
+        // Characters without a primary weight are ignorable and left to ICU.
+        if (sortKeyLevel(keys[character], 0).length)
+            characters.append(character);
+    }
+    if (characters.isEmpty())
+        return;
+
+    // ICU compares the strings level by level, so a character by character
+    // comparison can only break ties between equal primary weights if at
+    // most one further level tells the characters apart.
+    unsigned varyingLevels = 0;
+    for (unsigned level = 1; sortKeyLevel(keys[characters[0]], level).weights; ++level) {
+        SortKeyLevel first = sortKeyLevel(keys[characters[0]], level);
+        bool varies = std::any_of(characters.begin(), characters.end(), [&](UChar character) {
+            return sortKeyLevel(keys[character], level) != first;
+        });
+        if (varies && ++varyingLevels > 1)
+            return;
+    }
+
+    // Contractions and expansions map several characters to one collation
+    // element or the other way around, so they have to be left to ICU.
+    USet* contractions = uset_openEmpty();
+    USet* expansions = uset_openEmpty();
+    ucol_getContractionsAndExpansions(m_collator, contractions, expansions, true, &status);
+    bool mapsASCIISequences = U_FAILURE(status);
+    for (UChar32 character = 0; character < 128 && !mapsASCIISequences; ++character)
+        mapsASCIISequences = uset_contains(expansions, character);
+    int32_t itemCount = uset_getItemCount(contractions);
+    for (int32_t i = 0; i < itemCount && !mapsASCIISequences; ++i) {
+        UChar32 start;
+        UChar32 end;
+        UChar string[16];
+        status = U_ZERO_ERROR;
+        int32_t length = uset_getItem(contractions, i, &start, &end, string, WTF_ARRAY_LENGTH(string), &status);
+        if (length <= 0)
+            continue;
+        mapsASCIISequences = U_FAILURE(status) || std::all_of(string, string + length, [](UChar character) { return character < 128; });
+    }
+    uset_close(contractions);
+    uset_close(expansions);
+    if (mapsASCIISequences)
+        return;
+
+    std::sort(characters.begin(), characters.end(), [&keys](UChar a, UChar b) {
+        return strcmp(reinterpret_cast<const char*>(keys[a]), reinterpret_cast<const char*>(keys[b])) < 0;
+    });
+    uint8_t primaryWeight = 1;
+    uint8_t tieWeight = 0;
+    for (size_t i = 0; i < characters.size(); ++i) {
+        UChar character = characters[i];
+        if (i) {
+            UChar previous = characters[i - 1];
+            if (sortKeyLevel(keys[character], 0) != sortKeyLevel(keys[previous], 0)) {
+                ++primaryWeight;
+                tieWeight = 0;
+            } else if (strcmp(reinterpret_cast<const char*>(keys[character]), reinterpret_cast<const char*>(keys[previous])))
+                ++tieWeight;
+        }
+        m_primaryWeights[character] = primaryWeight;
+        m_tieWeights[character] = tieWeight;
+    }
+    m_canCompareASCII = true;
+}
+
+template<typename CharacterType>
+bool IntlSharedCollator::hasASCIIWeights(const CharacterType* characters, unsigned length) const
+{
+    for (unsigned i = 0; i < length; ++i) {
+        if (characters[i] >= 128 || !m_primaryWeights[characters[i]])
+            return false;
+    }
+    return true;
+}
+
+template<typename CharacterType1, typename CharacterType2>
+int IntlSharedCollator::compareASCII(const CharacterType1* characters1, unsigned length1, const CharacterType2* characters2, unsigned length2) const
+{
+    int tieResult = 0;
+    unsigned length = std::min(length1, length2);
+    for (unsigned i = 0; i < length; ++i) {
+        unsigned character1 = characters1[i];
+        unsigned character2 = characters2[i];
+        if (character1 == character2)
+            continue;
+        if (m_primaryWeights[character1] != m_primaryWeights[character2])
+            return m_primaryWeights[character1] < m_primaryWeights[character2] ? -1 : 1;
+        if (!tieResult && m_tieWeights[character1] != m_tieWeights[character2])
+            tieResult = m_tieWeights[character1] < m_tieWeights[character2] ? -1 : 1;
+    }
+    if (length1 != length2)
+        return length1 < length2 ? -1 : 1;
+    return tieResult;
+}
+
+bool IntlSharedCollator::compareASCII(StringView x, StringView y, int& result) const
+{
+    if (!m_canCompareASCII)
+        return false;
+
+    bool hasWeights = x.is8Bit() ? hasASCIIWeights(x.characters8(), x.length()) : hasASCIIWeights(x.characters16(), x.length());
+    if (!hasWeights)
+        return false;
+    hasWeights = y.is8Bit() ? hasASCIIWeights(y.characters8(), y.length()) : hasASCIIWeights(y.characters16(), y.length());
+    if (!hasWeights)
+        return false;
+
+    if (x.is8Bit()) {
+        result = y.is8Bit()
+            ? compareASCII(x.characters8(), x.length(), y.characters8(), y.length())
+            : compareASCII(x.characters8(), x.length(), y.characters16(), y.length());
+    } else {
+        result = y.is8Bit()
+            ? compareASCII(x.characters16(), x.length(), y.characters8(), y.length())
+            : compareASCII(x.characters16(), x.length(), y.characters16(), y.length());
+    }
+    return true;
+}
+
+void IntlCache::addCollator(const String& key, IntlSharedCollator& collator)
+{
+    if (m_collators.size() >= capacity)
+        m_collators.clear();
+    m_collators.set(key, &collator);
+}
+
+void IntlCache::addNumberFormat(const String& key, IntlSharedNumberFormat& numberFormat)
+{
+    if (m_numberFormats.size() >= capacity)
+        m_numberFormats.clear();
+    m_numberFormats.set(key, &numberFormat);
+}
+
+void IntlCache::addDateFormat(const String& key, IntlSharedDateFormat& dateFormat)
+{
+    if (m_dateFormats.size() >= capacity)
+        m_dateFormats.clear();
+    m_dateFormats.set(key, &dateFormat);
+}
+
+String IntlCache::bestDatePattern(const String& locale, const String& skeleton)
+{
+    StringBuilder keyBuilder;
+    keyBuilder.append(locale);
+    keyBuilder.append(' ');
+    keyBuilder.append(skeleton);
+    String key = keyBuilder.toString();
+    auto iterator = m_datePatterns.find(key);
+    if (iterator != m_datePatterns.end())
+        return iterator->value;
+
+    UErrorCode status = U_ZERO_ERROR;
+    UDateTimePatternGenerator* generator = udatpg_open(locale.utf8().data(), &status);
+    if (U_FAILURE(status))
+        return String();
+
+    StringView skeletonView(skeleton);
+    Vector<UChar, 32> patternBuffer(32);
+    auto patternLength = udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternBuffer.size(), &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+        status = U_ZERO_ERROR;
+        patternBuffer.grow(patternLength);
+        udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternLength, &status);
+    }
+    udatpg_close(generator);
+    if (U_FAILURE(status))
+        return String();
+
+    String pattern(patternBuffer.data(), patternLength);
+    if (m_datePatterns.size() >= capacity)
+        m_datePatterns.clear();
+    m_datePatterns.set(key, pattern);
+    return pattern;
+}
+
+} // namespace JSC
+
+#endif // ENABLE(INTL)
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#if ENABLE(INTL)
+
+#include <unicode/udat.h>
+#include <unicode/unum.h>
+#include <wtf/HashMap.h>
+#include <wtf/RefCounted.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/StringView.h>
+#include <wtf/text/WTFString.h>
+
+struct UCollator;
+
+namespace JSC {
+
+// An ICU object that is configured once and then only used, so that the
+// Intl objects of a VM that resolve to the same locale and options can
+// share it instead of each opening their own.
+template<typename ICUType, void (*closeFunction)(ICUType*)>
+class IntlSharedObject : public RefCounted<IntlSharedObject<ICUType, closeFunction>> {
+public:
+    static Ref<IntlSharedObject> create(ICUType* object) { return adoptRef(*new IntlSharedObject(object)); }
+    ~IntlSharedObject() { closeFunction(m_object); }
+
+    ICUType* get() const { return m_object; }
+
+private:
+    explicit IntlSharedObject(ICUType* object)
+        : m_object(object)
+    {
+    }
+
+    ICUType* m_object;
+};
+
+typedef IntlSharedObject<UNumberFormat, unum_close> IntlSharedNumberFormat;
+typedef IntlSharedObject<UDateFormat, udat_close> IntlSharedDateFormat;
+
+class IntlSharedCollator : public RefCounted<IntlSharedCollator> {
+public:
+    static Ref<IntlSharedCollator> create(UCollator*);
+    ~IntlSharedCollator();
+
+    UCollator* get() const { return m_collator; }
+
+    // Compares two strings the way the collator would, if both are ASCII
+    // and the collator orders ASCII character by character. Returns false
+    // if ICU has to compare them.
+    bool compareASCII(StringView, StringView, int& result) const;
+
+private:
+    explicit IntlSharedCollator(UCollator*);
+
+    void computeASCIIWeights();
+    template<typename CharacterType> bool hasASCIIWeights(const CharacterType*, unsigned length) const;
+    template<typename CharacterType1, typename CharacterType2>
+    int compareASCII(const CharacterType1*, unsigned length1, const CharacterType2*, unsigned length2) const;
+
+    UCollator* m_collator;
+    bool m_canCompareASCII { false };
+    // The rank of the primary weight of each ASCII character, 0 for the
+    // characters that the ASCII comparison does not handle, and its rank
+    // among the characters with the same primary weight.
+    uint8_t m_primaryWeights[128];
+    uint8_t m_tieWeights[128];
+};
+
+// Caches the ICU objects of the Intl objects of a VM by resolved locale
+// and options. Opening an ICU collator or formatter loads and parses
+// locale data, which dominates creating Intl objects and calling
+// localeCompare or toLocaleString with explicit locales.
+class IntlCache {
+    WTF_MAKE_NONCOPYABLE(IntlCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    IntlCache() = default;
+
+    RefPtr<IntlSharedCollator> collator(const String& key) const { return m_collators.get(key); }
+    void addCollator(const String& key, IntlSharedCollator&);
+
+    RefPtr<IntlSharedNumberFormat> numberFormat(const String& key) const { return m_numberFormats.get(key); }
+    void addNumberFormat(const String& key, IntlSharedNumberFormat&);
+
+    RefPtr<IntlSharedDateFormat> dateFormat(const String& key) const { return m_dateFormats.get(key); }
+    void addDateFormat(const String& key, IntlSharedDateFormat&);
+
+    // The best date pattern for a skeleton, from the date time pattern
+    // generator of the locale. Returns a null string on failure.
+    String bestDatePattern(const String& locale, const String& skeleton);
+
+private:
+    // Entries in use stay alive with the Intl objects that use them, so a
+    // full map is simply cleared.
+    static const unsigned capacity = 32;
+
+    HashMap<String, RefPtr<IntlSharedCollator>> m_collators;
+    HashMap<String, RefPtr<IntlSharedNumberFormat>> m_numberFormats;
+    HashMap<String, RefPtr<IntlSharedDateFormat>> m_dateFormats;
+    HashMap<String, String> m_datePatterns;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(INTL)
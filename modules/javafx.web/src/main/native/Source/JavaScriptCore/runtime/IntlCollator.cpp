@@ -39,6 +39,7 @@
 #include "SlotVisitorInlines.h"
 #include "StructureInlines.h"
 #include <unicode/ucol.h>
+#include <wtf/text/StringConcatenate.h>
 #include <wtf/unicode/Collator.h>
 
 namespace JSC {
@@ -326,6 +327,13 @@ void IntlCollator::createCollator(ExecState& state)
         ASSERT_UNUSED(scope, !scope.exception());
     }
 
+    // Collators that resolve to the same locale and options share one ICU collator.
+    IntlCache& cache = vm.intlCache();
+    String key = makeString(m_locale, ' ', sensitivityString(m_sensitivity), m_numeric ? " numeric" : "", m_ignorePunctuation ? " ignorePunctuation" : "");
+    m_collator = cache.collator(key);
+    if (m_collator)
+        return;
+
     UErrorCode status = U_ZERO_ERROR;
     auto collator = std::unique_ptr<UCollator, UCollatorDeleter>(ucol_open(m_locale.utf8().data(), &status));
     if (U_FAILURE(status))
@@ -363,7 +371,8 @@ void IntlCollator::createCollator(ExecState& state)
     if (U_FAILURE(status))
         return;
 
-    m_collator = WTFMove(collator);
+    m_collator = IntlSharedCollator::create(collator.release());
+    cache.addCollator(key, *m_collator);
 }
 
 JSValue IntlCollator::compareStrings(ExecState& state, StringView x, StringView y)
@@ -378,10 +387,14 @@ JSValue IntlCollator::compareStrings(ExecState& state, StringView x, StringView
             return throwException(&state, scope, createError(&state, ASCIILiteral("Failed to compare strings.")));
     }
 
+    int asciiResult;
+    if (m_collator->compareASCII(x, y, asciiResult))
+        return jsNumber(asciiResult);
+
     UErrorCode status = U_ZERO_ERROR;
     UCharIterator iteratorX = createIterator(x);
     UCharIterator iteratorY = createIterator(y);
-    auto result = ucol_strcollIter(m_collator.get(), &iteratorX, &iteratorY, &status);
+    auto result = ucol_strcollIter(m_collator->get(), &iteratorX, &iteratorY, &status);
     if (U_FAILURE(status))
         return throwException(&state, scope, createError(&state, ASCIILiteral("Failed to compare strings.")));
     return jsNumber(result);
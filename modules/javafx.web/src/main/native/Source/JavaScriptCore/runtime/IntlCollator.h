@@ -27,10 +27,9 @@
 
 #if ENABLE(INTL)
 
+#include "IntlCache.h"
 #include "JSDestructibleObject.h"
 
-struct UCollator;
-
 namespace JSC {
 
 class IntlCollatorConstructor;
@@ -75,7 +74,7 @@ private:
     String m_collation;
     Sensitivity m_sensitivity;
     WriteBarrier<JSBoundFunction> m_boundCompare;
-    std::unique_ptr<UCollator, UCollatorDeleter> m_collator;
+    RefPtr<IntlSharedCollator> m_collator;
     bool m_numeric;
     bool m_ignorePunctuation;
     bool m_initializedCollator { false };
@@ -37,9 +37,9 @@
 #include "JSCInlines.h"
 #include "ObjectConstructor.h"
 #include <unicode/ucal.h>
-#include <unicode/udatpg.h>
 #include <unicode/uenum.h>
 #include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringConcatenate.h>
 
 namespace JSC {
 
@@ -49,12 +49,6 @@ static const char* const relevantExtensionKeys[2] = { "ca", "nu" };
 static const size_t indexOfExtensionKeyCa = 0;
 static const size_t indexOfExtensionKeyNu = 1;
 
-void IntlDateTimeFormat::UDateFormatDeleter::operator()(UDateFormat* dateFormat) const
-{
-    if (dateFormat)
-        udat_close(dateFormat);
-}
-
 IntlDateTimeFormat* IntlDateTimeFormat::create(VM& vm, Structure* structure)
 {
     IntlDateTimeFormat* format = new (NotNull, allocateCell<IntlDateTimeFormat>(vm.heap)) IntlDateTimeFormat(vm, structure);
@@ -622,38 +616,29 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
 
     // Always use ICU date format generator, rather than our own pattern list and matcher.
     // Covers steps 28-36.
-    UErrorCode status = U_ZERO_ERROR;
-    UDateTimePatternGenerator* generator = udatpg_open(dataLocale.utf8().data(), &status);
-    if (U_FAILURE(status)) {
-        throwTypeError(&exec, scope, ASCIILiteral("failed to initialize DateTimeFormat"));
-        return;
-    }
-
-    String skeleton = skeletonBuilder.toString();
-    StringView skeletonView(skeleton);
-    Vector<UChar, 32> patternBuffer(32);
-    status = U_ZERO_ERROR;
-    auto patternLength = udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternBuffer.size(), &status);
-    if (status == U_BUFFER_OVERFLOW_ERROR) {
-        status = U_ZERO_ERROR;
-        patternBuffer.grow(patternLength);
-        udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternLength, &status);
-    }
-    udatpg_close(generator);
-    if (U_FAILURE(status)) {
+    IntlCache& cache = vm.intlCache();
+    String pattern = cache.bestDatePattern(dataLocale, skeletonBuilder.toString());
+    if (pattern.isNull()) {
         throwTypeError(&exec, scope, ASCIILiteral("failed to initialize DateTimeFormat"));
         return;
     }
 
-    StringView pattern(patternBuffer.data(), patternLength);
     setFormatsFromPattern(pattern);
 
-    status = U_ZERO_ERROR;
-    StringView timeZoneView(m_timeZone);
-    m_dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), pattern.upconvertedCharacters(), pattern.length(), &status));
-    if (U_FAILURE(status)) {
-        throwTypeError(&exec, scope, ASCIILiteral("failed to initialize DateTimeFormat"));
-        return;
+    // Date formats with the same locale, time zone and pattern share one ICU formatter.
+    String key = makeString(m_locale, ' ', m_timeZone, ' ', pattern);
+    m_dateFormat = cache.dateFormat(key);
+    if (!m_dateFormat) {
+        UErrorCode status = U_ZERO_ERROR;
+        StringView timeZoneView(m_timeZone);
+        StringView patternView(pattern);
+        UDateFormat* dateFormat = udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), patternView.upconvertedCharacters(), patternView.length(), &status);
+        if (U_FAILURE(status)) {
+            throwTypeError(&exec, scope, ASCIILiteral("failed to initialize DateTimeFormat"));
+            return;
+        }
+        m_dateFormat = IntlSharedDateFormat::create(dateFormat);
+        cache.addDateFormat(key, *m_dateFormat);
     }
 
     // 37. Set dateTimeFormat.[[boundFormat]] to undefined.
@@ -879,11 +864,11 @@ JSValue IntlDateTimeFormat::format(ExecState& exec, double value)
     // Delegate remaining steps to ICU.
     UErrorCode status = U_ZERO_ERROR;
     Vector<UChar, 32> result(32);
-    auto resultLength = udat_format(m_dateFormat.get(), value, result.data(), result.size(), nullptr, &status);
+    auto resultLength = udat_format(m_dateFormat->get(), value, result.data(), result.size(), nullptr, &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         status = U_ZERO_ERROR;
         result.grow(resultLength);
-        udat_format(m_dateFormat.get(), value, result.data(), resultLength, nullptr, &status);
+        udat_format(m_dateFormat->get(), value, result.data(), resultLength, nullptr, &status);
     }
     if (U_FAILURE(status))
         return throwTypeError(&exec, scope, ASCIILiteral("failed to format date value"));
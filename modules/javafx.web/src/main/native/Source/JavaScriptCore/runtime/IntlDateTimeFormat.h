@@ -27,6 +27,7 @@
 
 #if ENABLE(INTL)
 
+#include "IntlCache.h"
 #include "JSDestructibleObject.h"
 #include <unicode/udat.h>
 
@@ -68,10 +69,6 @@ private:
     enum class Second { None, TwoDigit, Numeric };
     enum class TimeZoneName { None, Short, Long };
 
-    struct UDateFormatDeleter {
-        void operator()(UDateFormat*) const;
-    };
-
     void setFormatsFromPattern(const StringView&);
     static const char* weekdayString(Weekday);
     static const char* eraString(Era);
@@ -85,7 +82,7 @@ private:
 
     bool m_initializedDateTimeFormat { false };
     WriteBarrier<JSBoundFunction> m_boundFormat;
-    std::unique_ptr<UDateFormat, UDateFormatDeleter> m_dateFormat;
+    RefPtr<IntlSharedDateFormat> m_dateFormat;
 
     String m_locale;
     String m_calendar;
@@ -36,6 +36,7 @@
 #include "JSBoundFunction.h"
 #include "JSCInlines.h"
 #include "ObjectConstructor.h"
+#include <wtf/text/StringBuilder.h>
 
 namespace JSC {
 
@@ -388,6 +389,29 @@ void IntlNumberFormat::createNumberFormat(ExecState& state)
         ASSERT_NOT_REACHED();
     }
 
+    // Number formats that resolve to the same locale and options share one ICU formatter.
+    StringBuilder keyBuilder;
+    keyBuilder.append(m_locale);
+    keyBuilder.append(' ');
+    keyBuilder.append(styleString(m_style));
+    if (m_style == Style::Currency) {
+        keyBuilder.append(' ');
+        keyBuilder.append(m_currency);
+        keyBuilder.append(' ');
+        keyBuilder.append(currencyDisplayString(m_currencyDisplay));
+    }
+    for (unsigned digits : { m_minimumIntegerDigits, m_minimumFractionDigits, m_maximumFractionDigits, m_minimumSignificantDigits, m_maximumSignificantDigits }) {
+        keyBuilder.append(' ');
+        keyBuilder.appendNumber(digits);
+    }
+    if (m_useGrouping)
+        keyBuilder.appendLiteral(" grouping");
+    String key = keyBuilder.toString();
+    IntlCache& cache = vm.intlCache();
+    m_numberFormat = cache.numberFormat(key);
+    if (m_numberFormat)
+        return;
+
     UErrorCode status = U_ZERO_ERROR;
     auto numberFormat = std::unique_ptr<UNumberFormat, UNumberFormatDeleter>(unum_open(style, nullptr, 0, m_locale.utf8().data(), nullptr, &status));
     if (U_FAILURE(status))
@@ -409,7 +433,8 @@ void IntlNumberFormat::createNumberFormat(ExecState& state)
     if (U_FAILURE(status))
         return;
 
-    m_numberFormat = WTFMove(numberFormat);
+    m_numberFormat = IntlSharedNumberFormat::create(numberFormat.release());
+    cache.addNumberFormat(key, *m_numberFormat);
 }
 
 JSValue IntlNumberFormat::formatNumber(ExecState& state, double number)
@@ -430,11 +455,11 @@ JSValue IntlNumberFormat::formatNumber(ExecState& state, double number)
 
     UErrorCode status = U_ZERO_ERROR;
     Vector<UChar, 32> buffer(32);
-    auto length = unum_formatDouble(m_numberFormat.get(), number, buffer.data(), buffer.size(), nullptr, &status);
+    auto length = unum_formatDouble(m_numberFormat->get(), number, buffer.data(), buffer.size(), nullptr, &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         buffer.grow(length);
         status = U_ZERO_ERROR;
-        unum_formatDouble(m_numberFormat.get(), number, buffer.data(), length, nullptr, &status);
+        unum_formatDouble(m_numberFormat->get(), number, buffer.data(), length, nullptr, &status);
     }
     if (U_FAILURE(status))
         return throwException(&state, scope, createError(&state, ASCIILiteral("Failed to format a number.")));
@@ -27,6 +27,7 @@
 
 #if ENABLE(INTL)
 
+#include "IntlCache.h"
 #include "JSDestructibleObject.h"
 #include <unicode/unum.h>
 
@@ -79,7 +80,7 @@ private:
     unsigned m_maximumFractionDigits { 3 };
     unsigned m_minimumSignificantDigits { 0 };
     unsigned m_maximumSignificantDigits { 0 };
-    std::unique_ptr<UNumberFormat, UNumberFormatDeleter> m_numberFormat;
+    RefPtr<IntlSharedNumberFormat> m_numberFormat;
     WriteBarrier<JSBoundFunction> m_boundFormat;
     bool m_useGrouping { true };
     bool m_initializedNumberFormat { false };
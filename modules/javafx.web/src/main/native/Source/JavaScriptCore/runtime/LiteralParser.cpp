@@ -37,6 +37,7 @@
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
+#include <wtf/text/ASCIIFastPath.h>
 
 namespace JSC {
 
@@ -48,6 +49,40 @@ static ALWAYS_INLINE bool isJSONWhiteSpace(const CharType& c)
     return c == ' ' || c == 0x9 || c == 0xA || c == 0xD;
 }
 
+template <typename CharType>
+static ALWAYS_INLINE const CharType* skipJSONWhiteSpace(const CharType* ptr, const CharType* end)
+{
+#if CPU(X86_SSE2)
+    if (ptr < end && isJSONWhiteSpace(*ptr)) {
+        ++ptr;
+        // Indentation in pretty-printed JSON comes in long runs, skip them 16 bytes at a time.
+        const size_t charactersPerLoad = 16 / sizeof(CharType);
+        if (ptr < end && *ptr == ' ' && static_cast<size_t>(end - ptr) >= charactersPerLoad) {
+            const __m128i space = sizeof(CharType) == 1 ? _mm_set1_epi8(' ') : _mm_set1_epi16(' ');
+            const __m128i tab = sizeof(CharType) == 1 ? _mm_set1_epi8('\t') : _mm_set1_epi16('\t');
+            const __m128i newline = sizeof(CharType) == 1 ? _mm_set1_epi8('\n') : _mm_set1_epi16('\n');
+            const __m128i carriageReturn = sizeof(CharType) == 1 ? _mm_set1_epi8('\r') : _mm_set1_epi16('\r');
+            for (const CharType* loadEnd = end - charactersPerLoad; ptr <= loadEnd; ptr += charactersPerLoad) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+                __m128i whiteSpace;
+                if (sizeof(CharType) == 1) {
+                    whiteSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, carriageReturn)));
+                } else {
+                    whiteSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, space), _mm_cmpeq_epi16(chunk, tab)),
+                        _mm_or_si128(_mm_cmpeq_epi16(chunk, newline), _mm_cmpeq_epi16(chunk, carriageReturn)));
+                }
+                if (_mm_movemask_epi8(whiteSpace) != 0xFFFF)
+                    break;
+            }
+        }
+    }
+#endif
+    while (ptr < end && isJSONWhiteSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
 template <typename CharType>
 bool LiteralParser<CharType>::tryJSONPParse(Vector<JSONPData>& results, bool needsFullSourceInfo)
 {
@@ -175,8 +210,7 @@ template <ParserMode mode> TokenType LiteralParser<CharType>::Lexer::lex(Literal
     m_currentTokenID++;
 #endif
 
-    while (m_ptr < m_end && isJSONWhiteSpace(*m_ptr))
-        ++m_ptr;
+    m_ptr = skipJSONWhiteSpace(m_ptr, m_end);
 
     ASSERT(m_ptr <= m_end);
     if (m_ptr >= m_end) {
@@ -348,13 +382,24 @@ template <ParserMode mode, typename CharType, UChar terminator> static ALWAYS_IN
     return (c >= ' ' && (mode == StrictJSON || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && mode != StrictJSON);
 }
 
+template <typename CharType>
+template <ParserMode mode, char terminator> ALWAYS_INLINE void LiteralParser<CharType>::Lexer::skipSafeStringCharacters()
+{
+    // In strict JSON the safe characters are exactly those that JSON.stringify leaves unescaped.
+    if (mode == StrictJSON && terminator == '"') {
+        m_ptr = WTF::findJSONStringSpecialCharacter(m_ptr, m_end);
+        return;
+    }
+    while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
+        ++m_ptr;
+}
+
 template <typename CharType>
 template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token)
 {
     ++m_ptr;
     const CharType* runStart = m_ptr;
-    while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
-        ++m_ptr;
+    skipSafeStringCharacters<mode, terminator>();
     if (LIKELY(m_ptr < m_end && *m_ptr == terminator)) {
         setParserTokenString<CharType>(token, runStart);
         token.stringLength = m_ptr - runStart;
@@ -372,8 +417,7 @@ template <ParserMode mode, char terminator> TokenType LiteralParser<CharType>::L
     goto slowPathBegin;
     do {
         runStart = m_ptr;
-        while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
-            ++m_ptr;
+        skipSafeStringCharacters<mode, terminator>();
         if (!m_builder.isEmpty())
             m_builder.append(runStart, m_ptr - runStart);
 
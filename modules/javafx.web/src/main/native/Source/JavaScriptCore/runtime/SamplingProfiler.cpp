@@ -911,6 +911,86 @@ String SamplingProfiler::stackTracesAsJSON()
     return json.toString();
 }
 
+static void appendFoldedText(StringBuilder& folded, const String& text)
+{
+    // Semicolons separate frames and a line break ends the stack.
+    for (unsigned i = 0; i < text.length(); ++i) {
+        UChar c = text[i];
+        folded.append(c == ';' || c == '\n' || c == '\r' ? '_' : c);
+    }
+}
+
+static void appendFoldedFrame(VM& vm, StringBuilder& folded, SamplingProfiler::StackFrame& frame)
+{
+    String name = frame.displayName(vm);
+    if (name.isEmpty())
+        name = ASCIILiteral("(anonymous function)");
+    appendFoldedText(folded, name);
+    if (frame.frameType != SamplingProfiler::FrameType::Executable || frame.executable->isHostFunction())
+        return;
+
+    folded.append(' ');
+    appendFoldedText(folded, frame.url());
+    folded.append(':');
+    if (frame.hasExpressionInfo()) {
+        folded.appendNumber(frame.lineNumber());
+        folded.append(':');
+        folded.appendNumber(frame.columnNumber());
+    } else
+        folded.appendNumber(frame.functionStartLine());
+
+    // An inlined frame runs in the tier of the frame it was inlined into.
+    folded.appendLiteral(" [");
+    if (frame.machineLocation) {
+        folded.append(JITCode::typeName(frame.machineLocation->first.jitType));
+        folded.appendLiteral(" inlined");
+    } else
+        folded.append(JITCode::typeName(frame.semanticLocation.jitType));
+    folded.append(']');
+}
+
+String SamplingProfiler::stackTracesAsFoldedStacks()
+{
+    DeferGC deferGC(m_vm.heap);
+    LockHolder locker(m_lock);
+
+    {
+        HeapIterationScope heapIterationScope(m_vm.heap);
+        processUnverifiedStackTraces();
+    }
+
+    HashMap<String, unsigned> counts;
+    Vector<String> stacks;
+    for (StackTrace& stackTrace : m_stackTraces) {
+        if (stackTrace.frames.isEmpty())
+            continue;
+
+        // Frames are sampled innermost first, folded stacks start at the root.
+        StringBuilder stack;
+        for (size_t i = stackTrace.frames.size(); i--;) {
+            appendFoldedFrame(m_vm, stack, stackTrace.frames[i]);
+            if (i)
+                stack.append(';');
+        }
+        auto addResult = counts.add(stack.toString(), 0);
+        if (addResult.isNewEntry)
+            stacks.append(addResult.iterator->key);
+        addResult.iterator->value++;
+    }
+
+    StringBuilder folded;
+    for (const String& stack : stacks) {
+        folded.append(stack);
+        folded.append(' ');
+        folded.appendNumber(counts.get(stack));
+        folded.append('\n');
+    }
+
+    clearData(locker);
+
+    return folded.toString();
+}
+
 void SamplingProfiler::registerForReportAtExit()
 {
     static StaticLock registrationLock;
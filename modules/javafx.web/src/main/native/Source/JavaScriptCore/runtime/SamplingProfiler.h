@@ -169,6 +169,8 @@ public:
     void start(const LockHolder&);
     Vector<StackTrace> releaseStackTraces(const LockHolder&);
     JS_EXPORT_PRIVATE String stackTracesAsJSON();
+    // Drains the samples as folded stacks, one "outer;...;inner count" line per distinct stack.
+    JS_EXPORT_PRIVATE String stackTracesAsFoldedStacks();
     JS_EXPORT_PRIVATE void noticeCurrentThreadAsJSCExecutionThread();
     void noticeCurrentThreadAsJSCExecutionThread(const LockHolder&);
     void processUnverifiedStackTraces(); // You should call this only after acquiring the lock.
@@ -57,6 +57,7 @@
 #include "Identifier.h"
 #include "IncrementalSweeper.h"
 #include "InferredTypeTable.h"
+#include "IntlCache.h"
 #include "Interpreter.h"
 #include "JITCode.h"
 #include "JITWorklist.h"
@@ -481,6 +482,15 @@ HeapProfiler& VM::ensureHeapProfiler()
     return *m_heapProfiler;
 }
 
+#if ENABLE(INTL)
+IntlCache& VM::intlCache()
+{
+    if (!m_intlCache)
+        m_intlCache = std::make_unique<IntlCache>();
+    return *m_intlCache;
+}
+#endif
+
 #if ENABLE(SAMPLING_PROFILER)
 SamplingProfiler& VM::ensureSamplingProfiler(RefPtr<Stopwatch>&& stopwatch)
 {
@@ -98,6 +98,7 @@ class TypeProfilerLog;
 class HasOwnPropertyCache;
 class HeapProfiler;
 class Identifier;
+class IntlCache;
 class Interpreter;
 class JSCustomGetterSetterFunction;
 class JSGlobalObject;
@@ -605,6 +606,10 @@ public:
     ALWAYS_INLINE HasOwnPropertyCache* hasOwnPropertyCache() { return m_hasOwnPropertyCache.get(); }
     HasOwnPropertyCache* ensureHasOwnPropertyCache();
 
+#if ENABLE(INTL)
+    IntlCache& intlCache();
+#endif
+
 #if ENABLE(REGEXP_TRACING)
     typedef ListHashSet<RegExp*> RTTraceList;
     RTTraceList* m_rtTraceList;
@@ -773,6 +778,9 @@ private:
     MallocPtr<EncodedJSValue> m_exceptionFuzzBuffer;
     RefPtr<Watchdog> m_watchdog;
     std::unique_ptr<HeapProfiler> m_heapProfiler;
+#if ENABLE(INTL)
+    std::unique_ptr<IntlCache> m_intlCache;
+#endif
 #if ENABLE(SAMPLING_PROFILER)
     RefPtr<SamplingProfiler> m_samplingProfiler;
 #endif
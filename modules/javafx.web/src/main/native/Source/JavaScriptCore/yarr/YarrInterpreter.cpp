@@ -39,6 +39,48 @@ using namespace WTF;
 
 namespace JSC { namespace Yarr {
 
+static bool testCharacterClass(CharacterClass* characterClass, int ch)
+{
+    // Built-in classes carry a table for every BMP character.
+    if (characterClass->m_table && static_cast<unsigned>(ch) <= 0xffff)
+        return !!characterClass->m_table[ch] != characterClass->m_tableInverted;
+
+    if (!isASCII(ch)) {
+        for (unsigned i = 0; i < characterClass->m_matchesUnicode.size(); ++i)
+            if (ch == characterClass->m_matchesUnicode[i])
+                return true;
+        for (unsigned i = 0; i < characterClass->m_rangesUnicode.size(); ++i)
+            if ((ch >= characterClass->m_rangesUnicode[i].begin) && (ch <= characterClass->m_rangesUnicode[i].end))
+                return true;
+    } else {
+        for (unsigned i = 0; i < characterClass->m_matches.size(); ++i)
+            if (ch == characterClass->m_matches[i])
+                return true;
+        for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i)
+            if ((ch >= characterClass->m_ranges[i].begin) && (ch <= characterClass->m_ranges[i].end))
+                return true;
+    }
+
+    return false;
+}
+
+// Returns the index of the first occurrence of the character at or after
+// index, or length if there is none.
+static unsigned findCharacter(const LChar* characters, unsigned length, unsigned index, UChar character)
+{
+    if (character > 0xff || index >= length)
+        return length;
+    const void* found = memchr(characters + index, character, length - index);
+    return found ? static_cast<const LChar*>(found) - characters : length;
+}
+
+static unsigned findCharacter(const UChar* characters, unsigned length, unsigned index, UChar character)
+{
+    while (index < length && characters[index] != character)
+        ++index;
+    return index;
+}
+
 template<typename CharType>
 class Interpreter {
 public:
@@ -308,6 +350,53 @@ public:
             return (((pos + offset) <= length) && ((pos + offset) >= pos));
         }
 
+        // Consumes up to maxCount characters, read at the negative offset,
+        // while the predicate holds for them. Only for input that is not
+        // decoded as surrogate pairs. Returns the number consumed.
+        template<typename Predicate>
+        unsigned consumeWhile(unsigned negativePositionOffset, unsigned maxCount, const Predicate& predicate)
+        {
+            RELEASE_ASSERT(pos >= negativePositionOffset);
+            ASSERT(!decodeSurrogatePairs);
+            unsigned begin = pos;
+            unsigned end = length - pos < maxCount ? length : pos + maxCount;
+            while (pos < end && predicate(input[pos - negativePositionOffset]))
+                ++pos;
+            return pos - begin;
+        }
+
+        bool containsRequiredCharacter(const BytecodePattern& pattern)
+        {
+            return !pattern.m_requiredCharacter || findCharacter(input, length, pos, *pattern.m_requiredCharacter) < length;
+        }
+
+        // Advances to the next position where the start filter allows a
+        // match to begin. Returns false if there is none.
+        bool skipToPossibleMatchStart(const BytecodePattern& pattern)
+        {
+            const Vector<UChar>& prefix = pattern.m_literalPrefix;
+            if (!prefix.isEmpty()) {
+                while (true) {
+                    pos = findCharacter(input, length, pos, prefix[0]);
+                    if (length - pos < prefix.size())
+                        return false;
+                    unsigned i = 1;
+                    while (i < prefix.size() && input[pos + i] == prefix[i])
+                        ++i;
+                    if (i == prefix.size())
+                        return true;
+                    ++pos;
+                }
+            }
+
+            for (; pos < length; ++pos) {
+                unsigned ch = input[pos];
+                if (ch > 0xff ? pattern.m_startsWithNonLatin1Character : pattern.m_startCharacters.get(ch))
+                    return true;
+            }
+            return false;
+        }
+
     private:
         const CharType* input;
         unsigned pos;
@@ -315,27 +404,6 @@ public:
         bool decodeSurrogatePairs;
     };
 
-    bool testCharacterClass(CharacterClass* characterClass, int ch)
-    {
-        if (!isASCII(ch)) {
-            for (unsigned i = 0; i < characterClass->m_matchesUnicode.size(); ++i)
-                if (ch == characterClass->m_matchesUnicode[i])
-                    return true;
-            for (unsigned i = 0; i < characterClass->m_rangesUnicode.size(); ++i)
-                if ((ch >= characterClass->m_rangesUnicode[i].begin) && (ch <= characterClass->m_rangesUnicode[i].end))
-                    return true;
-        } else {
-            for (unsigned i = 0; i < characterClass->m_matches.size(); ++i)
-                if (ch == characterClass->m_matches[i])
-                    return true;
-            for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i)
-                if ((ch >= characterClass->m_ranges[i].begin) && (ch <= characterClass->m_ranges[i].end))
-                    return true;
-        }
-
-        return false;
-    }
-
     bool checkCharacter(int testChar, unsigned negativeInputOffset)
     {
         return testChar == input.readChecked(negativeInputOffset);
@@ -509,6 +577,15 @@ public:
         case QuantifierGreedy: {
             unsigned position = input.getPos();
             backTrack->begin = position;
+            if (!unicode) {
+                // Every character is a single code unit, scan them in one loop.
+                CharacterClass* characterClass = term.atom.characterClass;
+                bool invert = term.invert();
+                backTrack->matchAmount = input.consumeWhile(term.inputPosition, term.atom.quantityMaxCount, [&] (int ch) {
+                    return testCharacterClass(characterClass, ch) != invert;
+                });
+                return true;
+            }
             unsigned matchAmount = 0;
             while ((matchAmount < term.atom.quantityMaxCount) && input.checkInput(1)) {
                 if (!checkCharacterClass(term.atom.characterClass, term.invert(), term.inputPosition + 1)) {
@@ -1252,6 +1329,13 @@ public:
         }
         case ByteTerm::TypePatternCharacterGreedy: {
             BackTrackInfoPatternCharacter* backTrack = reinterpret_cast<BackTrackInfoPatternCharacter*>(context->frame + currentTerm().frameLocation);
+            if (!unicode) {
+                int patternCharacter = currentTerm().atom.patternCharacter;
+                backTrack->matchAmount = input.consumeWhile(currentTerm().inputPosition, currentTerm().atom.quantityMaxCount, [&] (int ch) {
+                    return ch == patternCharacter;
+                });
+                MATCH_NEXT();
+            }
             unsigned matchAmount = 0;
             unsigned position = input.getPos(); // May need to back out reading a surrogate pair.
             while ((matchAmount < currentTerm().atom.quantityMaxCount) && input.checkInput(1)) {
@@ -1405,6 +1489,8 @@ public:
                 return JSRegExpNoMatch;
 
             input.next();
+            if (pattern->m_hasStartFilter && !input.skipToPossibleMatchStart(*pattern))
+                return JSRegExpNoMatch;
 
             context->matchBegin = input.getPos();
 
@@ -1537,20 +1623,23 @@ public:
         for (unsigned i = 0; i < pattern->m_body->m_numSubpatterns + 1; ++i)
             output[i << 1] = offsetNoMatch;
 
-        allocatorPool = pattern->m_allocator->startAllocator();
-        RELEASE_ASSERT(allocatorPool);
+        JSRegExpResult result = JSRegExpNoMatch;
+        if (input.containsRequiredCharacter(*pattern) && (!pattern->m_hasStartFilter || input.skipToPossibleMatchStart(*pattern))) {
+            allocatorPool = pattern->m_allocator->startAllocator();
+            RELEASE_ASSERT(allocatorPool);
 
-        DisjunctionContext* context = allocDisjunctionContext(pattern->m_body.get());
+            DisjunctionContext* context = allocDisjunctionContext(pattern->m_body.get());
 
-        JSRegExpResult result = matchDisjunction(pattern->m_body.get(), context, false);
-        if (result == JSRegExpMatch) {
-            output[0] = context->matchBegin;
-            output[1] = context->matchEnd;
-        }
+            result = matchDisjunction(pattern->m_body.get(), context, false);
+            if (result == JSRegExpMatch) {
+                output[0] = context->matchBegin;
+                output[1] = context->matchEnd;
+            }
 
-        freeDisjunctionContext(context);
+            freeDisjunctionContext(context);
 
-        pattern->m_allocator->stopAllocator();
+            pattern->m_allocator->stopAllocator();
+        }
 
         ASSERT((result == JSRegExpMatch) == (output[0] != offsetNoMatch));
 
@@ -1603,7 +1692,9 @@ public:
         emitDisjunction(m_pattern.m_body);
         regexEnd();
 
-        return std::make_unique<BytecodePattern>(WTFMove(m_bodyDisjunction), m_allParenthesesInfo, m_pattern, allocator, lock);
+        auto bytecodePattern = std::make_unique<BytecodePattern>(WTFMove(m_bodyDisjunction), m_allParenthesesInfo, m_pattern, allocator, lock);
+        computeMatchFilters(*bytecodePattern);
+        return bytecodePattern;
     }
 
     void checkInput(unsigned count)
@@ -2047,6 +2138,106 @@ public:
     }
 
 private:
+    static bool isFixedCharacterTerm(PatternTerm& term)
+    {
+        return (term.type == PatternTerm::TypePatternCharacter || term.type == PatternTerm::TypeCharacterClass)
+            && term.quantityType == QuantifierFixedCount && term.quantityMaxCount.unsafeGet() >= 1;
+    }
+
+    // Returns the character a pattern character term matches exactly, the
+    // way atomPatternCharacter() compiles it, or nothing if it matches more
+    // than one character or a surrogate pair.
+    std::optional<UChar> exactCharacter(PatternTerm& term)
+    {
+        if (term.type != PatternTerm::TypePatternCharacter || !U_IS_BMP(term.patternCharacter))
+            return std::nullopt;
+        if (m_pattern.ignoreCase() && u_tolower(term.patternCharacter) != u_toupper(term.patternCharacter))
+            return std::nullopt;
+        return static_cast<UChar>(term.patternCharacter);
+    }
+
+    void addStartCharacter(BytecodePattern& bytecodePattern, UChar32 ch)
+    {
+        if (ch > 0xff)
+            bytecodePattern.m_startsWithNonLatin1Character = true;
+        else
+            bytecodePattern.m_startCharacters.set(ch);
+    }
+
+    void addStartCharacters(BytecodePattern& bytecodePattern, PatternTerm& term)
+    {
+        if (term.type == PatternTerm::TypePatternCharacter) {
+            UChar32 ch = term.patternCharacter;
+            if (m_pattern.ignoreCase()) {
+                addStartCharacter(bytecodePattern, u_tolower(ch));
+                addStartCharacter(bytecodePattern, u_toupper(ch));
+            }
+            addStartCharacter(bytecodePattern, ch);
+            return;
+        }
+
+        CharacterClass* characterClass = term.characterClass;
+        for (UChar32 ch = 0; ch <= 0xff; ++ch) {
+            if (testCharacterClass(characterClass, ch) != term.invert())
+                bytecodePattern.m_startCharacters.set(ch);
+        }
+        if (term.invert() || characterClass->m_matchesUnicode.size() || characterClass->m_rangesUnicode.size()) {
+            // Being exact above Latin-1 is not worth it, the filter is for skipping ahead.
+            bytecodePattern.m_startsWithNonLatin1Character = true;
+        }
+    }
+
+    void computeMatchFilters(BytecodePattern& bytecodePattern)
+    {
+        if (m_pattern.sticky())
+            return;
+
+        auto& alternatives = m_pattern.m_body->m_alternatives;
+        bool hasStartFilter = true;
+        for (auto& alternative : alternatives) {
+            if (alternative->m_terms.isEmpty() || !isFixedCharacterTerm(alternative->m_terms[0])) {
+                hasStartFilter = false;
+                break;
+            }
+        }
+        if (hasStartFilter) {
+            for (auto& alternative : alternatives)
+                addStartCharacters(bytecodePattern, alternative->m_terms[0]);
+            bytecodePattern.m_hasStartFilter = true;
+        }
+
+        if (alternatives.size() != 1)
+            return;
+        auto& terms = alternatives[0]->m_terms;
+
+        const unsigned maxLiteralPrefixLength = 64;
+        Vector<UChar> prefix;
+        for (auto& term : terms) {
+            std::optional<UChar> ch = exactCharacter(term);
+            if (!ch || term.quantityType != QuantifierFixedCount)
+                break;
+            for (unsigned i = 0; i < term.quantityMaxCount.unsafeGet() && prefix.size() < maxLiteralPrefixLength; ++i)
+                prefix.append(*ch);
+            if (prefix.size() == maxLiteralPrefixLength)
+                break;
+        }
+        if (prefix.size() > 1) {
+            ASSERT(hasStartFilter);
+            bytecodePattern.m_literalPrefix = WTFMove(prefix);
+        }
+
+        // Prefer punctuation, which tends to be rarer in text than letters.
+        for (auto& term : terms) {
+            std::optional<UChar> ch = exactCharacter(term);
+            if (!ch || !isFixedCharacterTerm(term))
+                continue;
+            if (!bytecodePattern.m_requiredCharacter || !isASCIIAlphanumeric(*ch))
+                bytecodePattern.m_requiredCharacter = ch;
+            if (!isASCIIAlphanumeric(*ch))
+                break;
+        }
+    }
+
     YarrPattern& m_pattern;
     std::unique_ptr<ByteDisjunction> m_bodyDisjunction;
     unsigned m_currentAlternativeIndex;
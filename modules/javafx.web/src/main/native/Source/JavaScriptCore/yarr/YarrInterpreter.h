@@ -27,6 +27,8 @@
 
 #include "ConcurrentJSLock.h"
 #include "YarrPattern.h"
+#include <wtf/Bitmap.h>
+#include <wtf/Optional.h>
 
 namespace WTF {
 class BumpPointerAllocator;
@@ -382,6 +384,16 @@ public:
     CharacterClass* newlineCharacterClass;
     CharacterClass* wordcharCharacterClass;
 
+    // Prefilters set by the byte compiler for patterns that are not sticky.
+    // The interpreter only tries start positions whose character can begin a
+    // match, and gives up at once on input without the required character.
+    bool m_hasStartFilter { false };
+    Bitmap<256> m_startCharacters;
+    bool m_startsWithNonLatin1Character { false };
+    // Characters every match starts with, if more than one is known.
+    Vector<UChar> m_literalPrefix;
+    std::optional<UChar> m_requiredCharacter;
+
 private:
     Vector<std::unique_ptr<ByteDisjunction>> m_allParenthesesInfo;
     Vector<std::unique_ptr<CharacterClass>> m_userCharacterClasses;
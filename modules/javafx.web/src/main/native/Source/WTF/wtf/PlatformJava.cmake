@@ -11,6 +11,7 @@ list(APPEND WTF_SOURCES
     java/StringJava.cpp
     java/MainThreadJava.cpp
     java/JavaEnv.cpp
+    java/TraceBufferJava.cpp
     java/TextBreakIteratorInternalICUJava.cpp #ICU_UNICODE=1 //XXX: make switch for ICU_UNICODE
 )
 
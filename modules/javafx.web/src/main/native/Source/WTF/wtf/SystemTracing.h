@@ -57,8 +57,20 @@ enum TracePointCode {
     RAFDisplayLinkFired,
     RAFCallbackStart,
     RAFCallbackEnd,
+    ImageDecodeStart,
+    ImageDecodeEnd,
+    RenderingQueueFlush,
 
     WebKitRange = 10000,
+    WebPagePrePaintStart,
+    WebPagePrePaintEnd,
+    WebPagePaintStart,
+    WebPagePaintEnd,
+    WebPagePostPaintStart,
+    WebPagePostPaintEnd,
+    WebPageSyncLayersStart,
+    WebPageSyncLayersEnd,
+
     WebKit2Range = 12000,
 
     RAFDidUpdateStart,
@@ -78,12 +90,22 @@ enum TracePointCode {
 
 #ifdef __cplusplus
 
+#if PLATFORM(JAVA)
+#include <wtf/java/TraceBufferJava.h>
+#endif
+
 namespace WTF {
 
 inline void TracePoint(TracePointCode code, uint64_t data1 = 0, uint64_t data2 = 0, uint64_t data3 = 0, uint64_t data4 = 0)
 {
 #if HAVE(KDEBUG_H)
     kdebug_trace(ARIADNEDBG_CODE(WEBKIT_COMPONENT, code), data1, data2, data3, data4);
+#elif PLATFORM(JAVA)
+    if (UNLIKELY(TraceBufferJava::isEnabled()))
+        TraceBufferJava::record(code, data1);
+    UNUSED_PARAM(data2);
+    UNUSED_PARAM(data3);
+    UNUSED_PARAM(data4);
 #else
     UNUSED_PARAM(code);
     UNUSED_PARAM(data1);
@@ -3,11 +3,81 @@
  */
 #include "config.h"
 
+#include <wtf/HashMap.h>
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
 namespace WTF {
 
+// Strings up to this length are copied through a stack buffer
+static const unsigned stackBufferLength = 256;
+
+// Java strings for the atomic strings most recently passed to Java on the
+// main thread. Atomic strings are mostly names and attribute values, which
+// are converted over and over, so the Java string is created once and
+// returned as a new local reference afterwards. Each entry holds a reference
+// to its atomic string, so the key can not be reused for another string.
+// When the cache is full, an entry not used since the clock hand last passed
+// it is replaced, so that the strings in use survive a burst of new ones.
+class JavaStringCache {
+public:
+    static const unsigned capacity = 2048;
+    static const unsigned maxLength = 128;
+
+    jstring get(JNIEnv* env, StringImpl& string)
+    {
+        auto it = m_indices.find(&string);
+        if (it == m_indices.end())
+            return nullptr;
+        Entry& entry = m_entries[it->value];
+        entry.referenced = true;
+        return static_cast<jstring>(env->NewLocalRef(entry.javaString));
+    }
+
+    void add(JNIEnv* env, StringImpl& string, jstring javaString)
+    {
+        jstring globalString = static_cast<jstring>(env->NewGlobalRef(javaString));
+        if (!globalString)
+            return;
+
+        if (m_entries.size() < capacity) {
+            m_indices.add(&string, m_entries.size());
+            m_entries.append(Entry { &string, globalString, false });
+            return;
+        }
+
+        while (m_entries[m_hand].referenced) {
+            m_entries[m_hand].referenced = false;
+            m_hand = (m_hand + 1) % capacity;
+        }
+        Entry& victim = m_entries[m_hand];
+        m_indices.remove(victim.string.get());
+        env->DeleteGlobalRef(victim.javaString);
+        victim = { &string, globalString, false };
+        m_indices.add(&string, m_hand);
+        m_hand = (m_hand + 1) % capacity;
+    }
+
+private:
+    struct Entry {
+        RefPtr<StringImpl> string;
+        jstring javaString;
+        bool referenced;
+    };
+
+    Vector<Entry> m_entries;
+    HashMap<StringImpl*, unsigned> m_indices;
+    unsigned m_hand { 0 };
+};
+
+static JavaStringCache& javaStringCache()
+{
+    static NeverDestroyed<JavaStringCache> cache;
+    return cache;
+}
+
 // String conversions
 String::String(JNIEnv* env, const JLString &s)
 {
@@ -17,10 +87,17 @@ String::String(JNIEnv* env, const JLString &s)
         unsigned int len = env->GetStringLength(s);
         if (!len) {
             m_impl = StringImpl::empty();
+        } else if (len <= stackBufferLength) {
+            // A region copy avoids entering a critical section for short strings
+            UChar buffer[stackBufferLength];
+            env->GetStringRegion(s, 0, len, reinterpret_cast<jchar*>(buffer));
+            m_impl = StringImpl::create8BitIfPossible(buffer, len);
         } else {
             const jchar* str = env->GetStringCritical(s, NULL);
             if (str) {
-                m_impl = StringImpl::create((const UChar*)str, len);
+                // Most strings coming from Java are Latin-1, keep them 8-bit
+                // so that WebCore does not carry them as UTF-16.
+                m_impl = StringImpl::create8BitIfPossible((const UChar*)str, len);
                 env->ReleaseStringCritical(s, str);
             } else {
                 m_impl = StringImpl::create(reinterpret_cast<const UChar*>(L"OME"), 3);
@@ -29,23 +106,44 @@ String::String(JNIEnv* env, const JLString &s)
     }
 }
 
+static jstring newJavaString(JNIEnv* env, const LChar* characters, unsigned length)
+{
+    // ASCII without NUL is valid modified UTF-8 as it is, so it is only
+    // copied to add the terminator. That saves widening it into a UTF-16
+    // copy of twice the size, which the VM would narrow back to Latin-1.
+    Vector<char, stackBufferLength + 1> utf(length + 1);
+    for (unsigned i = 0; i < length; i++) {
+        LChar c = characters[i];
+        if (!c || c >= 0x80) {
+            Vector<jchar, stackBufferLength> jchars(length);
+            StringImpl::copyChars(reinterpret_cast<UChar*>(jchars.data()), characters, length);
+            return env->NewString(jchars.data(), length);
+        }
+        utf[i] = c;
+    }
+    utf[length] = '\0';
+    return env->NewStringUTF(utf.data());
+}
+
 JLString String::toJavaString(JNIEnv *env) const
 {
     if (isNull()) {
         return NULL;
-    } else {
-        const unsigned len = length();
-        if (is8Bit()) {
-            // Convert latin1 chars to unicode.
-            Vector<jchar> jchars(len);
-            for (unsigned i = 0; i < len; i++) {
-                jchars[i] = at(i);
-            }
-            return env->NewString(jchars.data(), len);
-        } else {
-            return env->NewString((jchar*)characters16(), len);
-        }
     }
+
+    const unsigned len = length();
+    bool cacheable = m_impl->isAtomic() && len <= JavaStringCache::maxLength && isMainThread();
+    if (cacheable) {
+        if (jstring cached = javaStringCache().get(env, *m_impl))
+            return cached;
+    }
+
+    jstring result = is8Bit()
+        ? newJavaString(env, characters8(), len)
+        : env->NewString((jchar*)characters16(), len);
+    if (cacheable && result)
+        javaStringCache().add(env, *m_impl, result);
+    return result;
 }
 
 } // namespace WTF
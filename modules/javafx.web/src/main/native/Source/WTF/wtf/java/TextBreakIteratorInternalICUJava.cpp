@@ -10,16 +10,16 @@
 #include <wtf/text/WTFString.h>
 #include <wtf/text/CString.h>
 
+#include <unicode/uloc.h>
 
 namespace WTF {
 
 static const char* UILanguage()
 {
-    // Chrome's UI language can be different from the OS UI language on Windows.
-    // We want to return Chrome's UI language here.
-    // DEPRECATED_DEFINE_STATIC_LOCAL(CString, locale, (WebCore::defaultLanguage().latin1()));
-    // FIXME-java: Get default language from Java using Locale.getDefault()
-    return "en";
+    // ICU derives its default locale from the same user settings the JVM
+    // uses for Locale.getDefault(), without a round trip to Java.
+    static const char* localeID = uloc_getDefault();
+    return localeID && *localeID ? localeID : "en";
 }
 
 const char* currentSearchLocaleID()
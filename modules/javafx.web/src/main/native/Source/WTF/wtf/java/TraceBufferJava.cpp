@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+#include "TraceBufferJava.h"
+
+#include <wtf/FastMalloc.h>
+#include <wtf/MainThread.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/Threading.h>
+
+namespace WTF {
+
+namespace {
+
+const size_t positionMask = TraceBufferJava::capacity - 1;
+
+struct Cell {
+    // The position the cell can next be written at, or that plus one once
+    // it has been written and can be read.
+    std::atomic<size_t> sequence;
+    TraceBufferJava::Record record;
+};
+
+// A bounded multiple producer queue after Dmitry Vyukov's, which only
+// ever has one consumer.
+struct Buffer {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    Buffer()
+    {
+        for (size_t i = 0; i < TraceBufferJava::capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    std::atomic<size_t> enqueuePosition { 0 };
+    std::atomic<uint64_t> droppedCount { 0 };
+    size_t dequeuePosition { 0 };
+    Cell cells[TraceBufferJava::capacity];
+};
+
+// Allocated when tracing is first enabled and never freed, so that a
+// trace point racing with disabling still has a buffer to record into.
+std::atomic<Buffer*> s_buffer;
+
+} // namespace
+
+std::atomic<bool> TraceBufferJava::s_isEnabled;
+
+void TraceBufferJava::setEnabled(bool enabled)
+{
+    ASSERT(isMainThread());
+    if (enabled && !s_buffer.load(std::memory_order_relaxed))
+        s_buffer.store(new Buffer, std::memory_order_release);
+    s_isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceBufferJava::record(uint32_t code, uint64_t data)
+{
+    Buffer* buffer = s_buffer.load(std::memory_order_acquire);
+    if (!buffer)
+        return;
+
+    uint64_t timestamp = static_cast<uint64_t>(MonotonicTime::now().secondsSinceEpoch().nanoseconds());
+    size_t position = buffer->enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &buffer->cells[position & positionMask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (!difference) {
+            if (buffer->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        } else if (difference < 0) {
+            // The cell still holds a record from the previous lap.
+            buffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else
+            position = buffer->enqueuePosition.load(std::memory_order_relaxed);
+    }
+
+    cell->record = Record { timestamp, code, currentThread(), data };
+    cell->sequence.store(position + 1, std::memory_order_release);
+}
+
+size_t TraceBufferJava::drain(Record* records, size_t maxCount)
+{
+    Buffer* buffer = s_buffer.load(std::memory_order_acquire);
+    if (!buffer)
+        return 0;
+
+    size_t count = 0;
+    while (count < maxCount) {
+        size_t position = buffer->dequeuePosition;
+        Cell& cell = buffer->cells[position & positionMask];
+        // Stops at a record that is still being written, which is left
+        // for the next drain.
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+            break;
+        records[count++] = cell.record;
+        cell.sequence.store(position + capacity, std::memory_order_release);
+        buffer->dequeuePosition = position + 1;
+    }
+    return count;
+}
+
+uint64_t TraceBufferJava::takeDroppedCount()
+{
+    Buffer* buffer = s_buffer.load(std::memory_order_acquire);
+    if (!buffer)
+        return 0;
+    return buffer->droppedCount.exchange(0, std::memory_order_relaxed);
+}
+
+} // namespace WTF
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace WTF {
+
+// A fixed size ring buffer that the trace points of WebKit are recorded
+// into while tracing is enabled, for the Java side to drain. Recording is
+// lock free, so trace points may be recorded on any thread, and a record
+// that does not fit is dropped and counted rather than waited for. Only
+// one thread may drain at a time.
+//
+// While tracing is disabled a trace point costs a load and a branch.
+class TraceBufferJava {
+public:
+    struct Record {
+        uint64_t timestamp; // Monotonic, in nanoseconds.
+        uint32_t code;
+        uint32_t thread;
+        uint64_t data;
+    };
+
+    // A power of two, so that positions wrap around with a mask.
+    static const size_t capacity = 1 << 16;
+
+    static bool isEnabled() { return s_isEnabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool);
+
+    static void record(uint32_t code, uint64_t data);
+
+    // Moves up to maxCount of the oldest records into records and returns
+    // the number moved.
+    static size_t drain(Record* records, size_t maxCount);
+
+    // Returns the number of records dropped since the last call.
+    static uint64_t takeDroppedCount();
+
+private:
+    static std::atomic<bool> s_isEnabled;
+};
+
+} // namespace WTF
+
+using WTF::TraceBufferJava;
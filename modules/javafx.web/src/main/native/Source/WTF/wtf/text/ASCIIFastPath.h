@@ -192,6 +192,46 @@ inline void copyLCharsFromUCharSource(LChar* destination, const UChar* source, s
 #endif
 }
 
+inline bool isJSONStringSpecialCharacter(UChar character)
+{
+    return character == '"' || character == '\\' || character < 0x20;
+}
+
+// Returns a pointer to the first character in [characters, end) that can not appear
+// unescaped in a JSON string: a quote, a backslash or a control character. JSON string
+// bodies are mostly long runs of plain characters, so these are skipped 16 bytes at a time.
+template<typename CharacterType>
+inline const CharacterType* findJSONStringSpecialCharacter(const CharacterType* characters, const CharacterType* end)
+{
+#if CPU(X86_SSE2)
+    const size_t charactersPerLoad = 16 / sizeof(CharacterType);
+    if (static_cast<size_t>(end - characters) >= charactersPerLoad) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i quote = sizeof(CharacterType) == 1 ? _mm_set1_epi8('"') : _mm_set1_epi16('"');
+        const __m128i backslash = sizeof(CharacterType) == 1 ? _mm_set1_epi8('\\') : _mm_set1_epi16('\\');
+        const __m128i lastControl = sizeof(CharacterType) == 1 ? _mm_set1_epi8(0x1F) : _mm_set1_epi16(0x1F);
+        const CharacterType* loadEnd = end - charactersPerLoad;
+        for (; characters <= loadEnd; characters += charactersPerLoad) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+            __m128i special;
+            if (sizeof(CharacterType) == 1) {
+                // A saturating subtraction leaves zero for the control characters.
+                special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                    _mm_cmpeq_epi8(_mm_subs_epu8(chunk, lastControl), zero));
+            } else {
+                special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, quote), _mm_cmpeq_epi16(chunk, backslash)),
+                    _mm_cmpeq_epi16(_mm_subs_epu16(chunk, lastControl), zero));
+            }
+            if (_mm_movemask_epi8(special))
+                break;
+        }
+    }
+#endif
+    while (characters != end && !isJSONStringSpecialCharacter(*characters))
+        ++characters;
+    return characters;
+}
+
 } // namespace WTF
 
 #endif // ASCIIFastPath_h
@@ -88,7 +88,7 @@ public:
 
     UBreakIterator* take(const AtomicString& locale, LineBreakIteratorMode mode)
     {
-        auto localeWithOptionalBreakKeyword = makeLocaleWithBreakKeyword(locale, mode);
+        auto localeWithOptionalBreakKeyword = localeWithBreakKeyword(locale, mode);
 
         UBreakIterator* iterator = nullptr;
         for (size_t i = 0; i < m_pool.size(); ++i) {
@@ -123,6 +123,30 @@ public:
 private:
     static constexpr size_t capacity = 4;
 
+    // Layout acquires an iterator for every text run, almost always for the
+    // same few locales, so remember the uloc conversions instead of redoing
+    // them each time.
+    AtomicString localeWithBreakKeyword(const AtomicString& locale, LineBreakIteratorMode mode)
+    {
+        for (auto& entry : m_localeCache) {
+            if (entry.mode == mode && entry.locale == locale)
+                return entry.localeWithBreakKeyword;
+        }
+
+        auto localeWithBreakKeyword = makeLocaleWithBreakKeyword(locale, mode);
+        if (m_localeCache.size() == capacity)
+            m_localeCache.remove(0);
+        m_localeCache.uncheckedAppend({ locale, mode, localeWithBreakKeyword });
+        return localeWithBreakKeyword;
+    }
+
+    struct LocaleCacheEntry {
+        AtomicString locale;
+        LineBreakIteratorMode mode;
+        AtomicString localeWithBreakKeyword;
+    };
+
+    Vector<LocaleCacheEntry, capacity> m_localeCache;
     Vector<std::pair<AtomicString, UBreakIterator*>, capacity> m_pool;
     HashMap<UBreakIterator*, AtomicString> m_vendedIterators;
 
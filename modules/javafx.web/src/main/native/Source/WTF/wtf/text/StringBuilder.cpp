@@ -27,6 +27,7 @@
 #include "config.h"
 #include "StringBuilder.h"
 
+#include "ASCIIFastPath.h"
 #include "IntegerToStringConversion.h"
 #include "MathExtras.h"
 #include "WTFString.h"
@@ -425,12 +426,17 @@ template <typename OutputCharacterType, typename InputCharacterType>
 static void appendQuotedJSONStringInternal(OutputCharacterType*& output, const InputCharacterType* input, unsigned length)
 {
     for (const InputCharacterType* end = input + length; input != end; ++input) {
-        const InputCharacterType character = *input;
-        if (LIKELY(character != '"' && character != '\\' && character > 0x1F)) {
-            *output++ = character;
-            continue;
+        // Copy the run of characters that need no escaping in bulk.
+        const InputCharacterType* runEnd = findJSONStringSpecialCharacter(input, end);
+        if (runEnd != input) {
+            StringImpl::copyChars(output, input, runEnd - input);
+            output += runEnd - input;
+            input = runEnd;
+            if (input == end)
+                break;
         }
 
+        const InputCharacterType character = *input;
         if (character == '"' || character == '\\') {
             *output++ = '\\';
             *output++ = character;
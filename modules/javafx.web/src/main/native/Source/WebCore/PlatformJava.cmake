@@ -58,6 +58,7 @@ list(APPEND WebCore_SOURCES
     bridge/jni/jsc/JavaMethodJSC.cpp
     bridge/jni/jsc/JavaRuntimeObject.cpp
     bridge/jni/jsc/JNIUtilityPrivate.cpp
+    bridge/jni/jsc/ScriptResultJSC.cpp
     editing/java/EditorJava.cpp
     platform/java/ColorChooserJava.cpp
     platform/java/ContextMenuClientJava.cpp
@@ -102,7 +103,9 @@ list(APPEND WebCore_SOURCES
     platform/java/WebPage.cpp
     platform/java/WheelEventJava.cpp
     platform/java/WidgetJava.cpp
+    platform/java/api/MemoryPressureJava.cpp
     platform/java/api/PageCacheJava.cpp
+    platform/java/api/TracingJava.cpp
     platform/graphics/java/BitmapImageJava.cpp
     platform/graphics/java/BufferImageJava.cpp
     platform/graphics/java/ChromiumBridge.cpp
@@ -138,12 +141,16 @@ list(APPEND WebCore_SOURCES
     platform/network/java/ResourceHandleJava.cpp
     platform/network/java/ResourceRequestJava.cpp
 
+    bindings/java/JavaDOMSnapshot.cpp
     bindings/java/JavaDOMUtils.cpp
     bindings/java/JavaEventListener.cpp
+    bindings/java/JavaMutationJournal.cpp
+    bindings/java/JavaNodeIdentifier.cpp
 
     platform/java/ChromeClientJava.cpp
     page/java/DragControllerJava.cpp
     page/java/EventHandlerJava.cpp
+    page/java/ResourceAccountingJava.cpp
 
     # FIXME-java: Move WebKit interface specific files into WebKit dir
     ../WebKit/Storage/StorageAreaImpl.cpp
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+/* bulk DOM access for com.sun.webkit.dom.DOMSnapshot */
+
+#include "config.h"
+
+#include "Attribute.h"
+#include "ContainerNode.h"
+#include "Document.h"
+#include "Element.h"
+#include "JSMainThreadExecState.h"
+#include "NodeList.h"
+#include "NodeTraversal.h"
+#include "RenderObject.h"
+
+#include <wtf/java/JavaEnv.h>
+
+#include "JavaDOMSnapshot.h"
+#include "JavaDOMUtils.h"
+#include "JavaNodeIdentifier.h"
+#include "com_sun_webkit_dom_DOMSnapshot.h"
+
+namespace WebCore {
+
+DOMSnapshotWriter::DOMSnapshotWriter(Vector<uint8_t>& data, unsigned whatToShow, Vector<String>&& attributeNames, bool allAttributes, unsigned flags)
+    : m_data(data)
+    , m_whatToShow(whatToShow)
+    , m_attributeNames(WTFMove(attributeNames))
+    , m_allAttributes(allAttributes)
+    , m_flags(flags)
+{
+}
+
+bool DOMSnapshotWriter::isShown(const Node& node) const
+{
+    return m_whatToShow & (1u << (node.nodeType() - 1));
+}
+
+bool DOMSnapshotWriter::isRendered(const Node& node) const
+{
+    if (node.renderer())
+        return true;
+    return is<Element>(node) && downcast<Element>(node).hasDisplayContents();
+}
+
+bool DOMSnapshotWriter::isAttributeShown(const Attribute& attribute) const
+{
+    if (m_allAttributes)
+        return true;
+    String name = attribute.name().toString();
+    for (auto& attributeName : m_attributeNames) {
+        if (equalIgnoringASCIICase(attributeName, name))
+            return true;
+    }
+    return false;
+}
+
+void DOMSnapshotWriter::appendString(const String& string)
+{
+    unsigned length = string.length();
+    appendInt32(length);
+    if (!length)
+        return;
+    if (!string.is8Bit()) {
+        append(string.characters16(), length * sizeof(UChar));
+        return;
+    }
+    size_t offset = m_data.size();
+    m_data.grow(offset + length * sizeof(UChar));
+    const LChar* characters = string.characters8();
+    UChar* out = reinterpret_cast<UChar*>(m_data.data() + offset);
+    for (unsigned i = 0; i < length; ++i)
+        out[i] = characters[i];
+}
+
+void DOMSnapshotWriter::writeNode(Node& node, uint64_t parentIdentifier)
+{
+    bool hasBox = (m_flags & com_sun_webkit_dom_DOMSnapshot_LAYOUT) && node.renderer() && !node.isDocumentNode();
+
+    appendInt64(javaNodeIdentifier(node));
+    appendInt64(parentIdentifier);
+    appendInt32(node.nodeType());
+    appendInt32(hasBox ? com_sun_webkit_dom_DOMSnapshot_HAS_BOX : 0);
+    appendString(node.nodeName());
+    appendString(node.nodeValue());
+
+    if (is<Element>(node)) {
+        Element& element = downcast<Element>(node);
+        size_t countOffset = m_data.size();
+        int32_t count = 0;
+        appendInt32(0);
+        if (element.hasAttributes()) {
+            for (const Attribute& attribute : element.attributesIterator()) {
+                if (!isAttributeShown(attribute))
+                    continue;
+                appendString(attribute.name().toString());
+                appendString(attribute.value());
+                ++count;
+            }
+        }
+        patchInt32(countOffset, count);
+    } else
+        appendInt32(0);
+
+    if (hasBox) {
+        IntRect box = node.renderer()->absoluteBoundingBoxRect();
+        appendInt32(box.x());
+        appendInt32(box.y());
+        appendInt32(box.width());
+        appendInt32(box.height());
+    }
+}
+
+int32_t DOMSnapshotWriter::writeSubtree(Node& root, uint64_t rootParentIdentifier, HashSet<uint64_t>* written)
+{
+    // The parent of a record is its closest shown ancestor in the
+    // snapshot, so nodes filtered out by type are skipped over.
+    struct Ancestor {
+        Node* node;
+        uint64_t shownIdentifier;
+    };
+    Vector<Ancestor, 64> ancestors;
+    int32_t count = 0;
+
+    bool renderedOnly = m_flags & com_sun_webkit_dom_DOMSnapshot_RENDERED_ONLY;
+    for (Node* node = &root; node;) {
+        while (!ancestors.isEmpty() && ancestors.last().node != node->parentNode())
+            ancestors.removeLast();
+
+        if (node != &root && renderedOnly && !isRendered(*node)) {
+            node = NodeTraversal::nextSkippingChildren(*node, &root);
+            continue;
+        }
+
+        uint64_t parentIdentifier = ancestors.isEmpty() ? rootParentIdentifier : ancestors.last().shownIdentifier;
+        uint64_t shownIdentifier = parentIdentifier;
+        if (isShown(*node)) {
+            writeNode(*node, parentIdentifier);
+            shownIdentifier = javaNodeIdentifier(*node);
+            if (written)
+                written->add(shownIdentifier);
+            ++count;
+        }
+        if (node->hasChildNodes())
+            ancestors.append(Ancestor { node, shownIdentifier });
+        node = NodeTraversal::next(*node, &root);
+    }
+    return count;
+}
+
+Vector<String> attributeNamesFromJava(JNIEnv* env, jobjectArray attributeNames)
+{
+    Vector<String> names;
+    if (!attributeNames)
+        return names;
+    jsize length = env->GetArrayLength(attributeNames);
+    names.reserveInitialCapacity(length);
+    for (jsize i = 0; i < length; i++) {
+        JLString name((jstring) env->GetObjectArrayElement(attributeNames, i));
+        if (name)
+            names.uncheckedAppend(String(env, name));
+    }
+    return names;
+}
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DOMSnapshot_captureImpl(JNIEnv* env, jclass, jlong peer
+    , jint whatToShow
+    , jobjectArray attributeNames
+    , jint flags)
+{
+    WebCore::JSMainThreadNullState state;
+    Node* root = jlong_to_Nodeptr(peer);
+    if (flags & (com_sun_webkit_dom_DOMSnapshot_LAYOUT | com_sun_webkit_dom_DOMSnapshot_RENDERED_ONLY))
+        root->document().updateLayoutIgnorePendingStylesheets();
+
+    Vector<uint8_t>* data = new Vector<uint8_t>;
+    data->reserveInitialCapacity(64 * 1024);
+    DOMSnapshotWriter writer(*data, whatToShow, attributeNamesFromJava(env, attributeNames), !attributeNames, flags);
+    writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_VERSION);
+    writer.appendInt32(0);
+    writer.patchInt32(sizeof(int32_t), writer.writeSubtree(*root, 0));
+    data->shrinkToFit();
+    return ptr_to_jlong(data);
+}
+
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_dom_DOMSnapshot_getBufferImpl(JNIEnv* env, jclass, jlong data)
+{
+    Vector<uint8_t>* buffer = static_cast<Vector<uint8_t>*>(jlong_to_ptr(data));
+    return env->NewDirectByteBuffer(buffer->data(), buffer->size());
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_dom_DOMSnapshot_disposeImpl(JNIEnv*, jclass, jlong data)
+{
+    delete static_cast<Vector<uint8_t>*>(jlong_to_ptr(data));
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DOMSnapshot_getNodeIdImpl(JNIEnv*, jclass, jlong peer)
+{
+    return javaNodeIdentifier(*jlong_to_Nodeptr(peer));
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DOMSnapshot_getNodeImpl(JNIEnv* env, jclass, jlong id)
+{
+    return JavaReturn<Node>(env, nodeForJavaNodeIdentifier(id));
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_dom_DOMSnapshot_querySelectorAllImpl(JNIEnv* env, jclass, jlong peer
+    , jstring selectors)
+{
+    WebCore::JSMainThreadNullState state;
+    Node* node = jlong_to_Nodeptr(peer);
+    if (!is<ContainerNode>(*node)) {
+        raiseNotSupportedErrorException(env);
+        return nullptr;
+    }
+    auto result = downcast<ContainerNode>(*node).querySelectorAll(String(env, selectors));
+    if (result.hasException()) {
+        raiseDOMErrorException(env, result.releaseException());
+        return nullptr;
+    }
+    Ref<NodeList> list = result.releaseReturnValue();
+
+    unsigned length = list->length();
+    jlongArray jArray = env->NewLongArray(length);
+    if (!jArray)
+        return nullptr;
+    jlong* peers = env->GetLongArrayElements(jArray, 0);
+    for (unsigned i = 0; i < length; i++) {
+        // paired deref() calls are made when the Java peers are disposed
+        Node* item = list->item(i);
+        item->ref();
+        peers[i] = ptr_to_jlong(item);
+    }
+    env->ReleaseLongArrayElements(jArray, peers, 0);
+    return jArray;
+}
+
+}
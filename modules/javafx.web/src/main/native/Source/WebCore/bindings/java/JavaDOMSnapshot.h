@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <wtf/HashSet.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class Attribute;
+class Node;
+
+// Writes the binary format described in com.sun.webkit.dom.DOMSnapshot.
+class DOMSnapshotWriter {
+public:
+    DOMSnapshotWriter(Vector<uint8_t>& data, unsigned whatToShow, Vector<String>&& attributeNames, bool allAttributes, unsigned flags);
+
+    // Writes the records for the subtree rooted at root, giving the root
+    // the specified parent, and returns the number of records written. The
+    // identifiers of the written nodes are added to written if not null.
+    int32_t writeSubtree(Node& root, uint64_t rootParentIdentifier, HashSet<uint64_t>* written = nullptr);
+
+    bool isAttributeShown(const Attribute&) const;
+
+    void appendInt32(int32_t value) { append(&value, sizeof(value)); }
+    void appendInt64(int64_t value) { append(&value, sizeof(value)); }
+    void appendString(const String&);
+    void patchInt32(size_t offset, int32_t value) { memcpy(m_data.data() + offset, &value, sizeof(value)); }
+    size_t size() const { return m_data.size(); }
+
+private:
+    bool isShown(const Node&) const;
+    bool isRendered(const Node&) const;
+    void writeNode(Node&, uint64_t parentIdentifier);
+    void append(const void* data, size_t size) { m_data.append(static_cast<const uint8_t*>(data), size); }
+
+    Vector<uint8_t>& m_data;
+    unsigned m_whatToShow;
+    Vector<String> m_attributeNames;
+    bool m_allAttributes;
+    unsigned m_flags;
+};
+
+// Reads the attribute names passed to the DOMSnapshot natives.
+Vector<String> attributeNamesFromJava(JNIEnv*, jobjectArray);
+
+} // namespace WebCore
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#include "config.h"
+#include "JavaMutationJournal.h"
+
+#include "Attribute.h"
+#include "CharacterData.h"
+#include "ContainerNode.h"
+#include "Document.h"
+#include "Element.h"
+#include "JSMainThreadExecState.h"
+
+#include <wtf/HashMap.h>
+#include <wtf/java/JavaEnv.h>
+
+#include "JavaDOMSnapshot.h"
+#include "JavaDOMUtils.h"
+#include "JavaNodeIdentifier.h"
+#include "com_sun_webkit_dom_DOMSnapshot.h"
+
+namespace WebCore {
+
+JavaMutationJournal::JavaMutationJournal(unsigned capacity)
+    : m_records(std::max(capacity, 1u), Record { Kind::Removed, 0, nullQName() })
+{
+}
+
+bool JavaMutationJournal::isObserved(const Node& node)
+{
+    // Shadow trees are not visible through the Java DOM bindings
+    return node.isConnected() && !node.isInShadowTree() && !node.isShadowRoot();
+}
+
+void JavaMutationJournal::append(Kind kind, Node& node, const QualifiedName& attributeName)
+{
+    uint64_t identifier = javaNodeIdentifier(node);
+    if (m_size) {
+        // Values are read when draining, so a repeated change is a no-op
+        const Record& last = m_records[(m_start + m_size - 1) % m_records.size()];
+        if (last.kind == kind && last.node == identifier && last.attributeName == attributeName)
+            return;
+    }
+    if (m_size == m_records.size()) {
+        // Drop the oldest record, the Java side has to take a new snapshot
+        m_overflowed = true;
+        m_start = (m_start + 1) % m_records.size();
+        --m_size;
+    }
+    m_records[(m_start + m_size) % m_records.size()] = Record { kind, identifier, attributeName };
+    ++m_size;
+}
+
+void JavaMutationJournal::childInserted(ContainerNode& parent, Node& child)
+{
+    if (isObserved(parent) && !child.isShadowRoot())
+        append(Kind::Inserted, child);
+}
+
+void JavaMutationJournal::childRemoved(ContainerNode& parent, Node& child)
+{
+    // A node without an identifier was never seen from Java
+    if (isObserved(parent) && child.hasJavaNodeIdentifier())
+        append(Kind::Removed, child);
+}
+
+void JavaMutationJournal::attributeChanged(Element& element, const QualifiedName& name)
+{
+    if (isObserved(element))
+        append(Kind::Attribute, element, name);
+}
+
+void JavaMutationJournal::characterDataChanged(CharacterData& characterData)
+{
+    if (isObserved(characterData))
+        append(Kind::Text, characterData);
+}
+
+void JavaMutationJournal::drain(DOMSnapshotWriter& writer)
+{
+    writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_VERSION);
+    size_t countOffset = writer.size();
+    writer.appendInt32(0);
+    writer.appendInt32(m_overflowed ? com_sun_webkit_dom_DOMSnapshot_JOURNAL_OVERFLOWED : 0);
+
+    // Nodes whose current state has been written in this batch. Later
+    // records for them are redundant until a removal is written, since
+    // the Java side drops the whole removed subtree.
+    HashSet<uint64_t> written;
+    // Insertions not yet written. Such nodes are unknown to the Java side,
+    // so they can not be used to position a sibling.
+    HashMap<uint64_t, unsigned> pendingInsertions;
+    for (unsigned i = 0; i < m_size; ++i) {
+        const Record& record = m_records[(m_start + i) % m_records.size()];
+        if (record.kind == Kind::Inserted)
+            pendingInsertions.add(record.node, 0).iterator->value++;
+    }
+
+    int32_t count = 0;
+    for (unsigned i = 0; i < m_size; ++i) {
+        Record& record = m_records[(m_start + i) % m_records.size()];
+        Node* node = nodeForJavaNodeIdentifier(record.node);
+
+        if (record.kind == Kind::Inserted) {
+            auto pending = pendingInsertions.find(record.node);
+            if (!--pending->value)
+                pendingInsertions.remove(pending);
+        }
+
+        if (record.kind == Kind::Removed) {
+            writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_JOURNAL_REMOVED);
+            writer.appendInt64(record.node);
+            written.clear();
+            ++count;
+            continue;
+        }
+        if (!node || written.contains(record.node))
+            continue;
+
+        switch (record.kind) {
+        case Kind::Inserted: {
+            // A node that is no longer in the tree has a removal recorded
+            // after this insertion, so it can be skipped.
+            ContainerNode* parent = node->parentNode();
+            if (!parent || !isObserved(*node))
+                break;
+            Node* previous = node->previousSibling();
+            while (previous && pendingInsertions.contains(javaNodeIdentifier(*previous)) && !written.contains(javaNodeIdentifier(*previous)))
+                previous = previous->previousSibling();
+            uint64_t parentIdentifier = javaNodeIdentifier(*parent);
+            writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_JOURNAL_INSERTED);
+            writer.appendInt64(record.node);
+            writer.appendInt64(parentIdentifier);
+            writer.appendInt64(previous ? javaNodeIdentifier(*previous) : 0);
+            size_t subtreeCountOffset = writer.size();
+            writer.appendInt32(0);
+            writer.patchInt32(subtreeCountOffset, writer.writeSubtree(*node, parentIdentifier, &written));
+            ++count;
+            break;
+        }
+        case Kind::Attribute: {
+            if (!is<Element>(*node))
+                break;
+            const AtomicString& value = downcast<Element>(*node).getAttribute(record.attributeName);
+            if (!writer.isAttributeShown(Attribute(record.attributeName, value)))
+                break;
+            writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_JOURNAL_ATTRIBUTE);
+            writer.appendInt64(record.node);
+            writer.appendString(record.attributeName.toString());
+            writer.appendInt32(!value.isNull());
+            if (!value.isNull())
+                writer.appendString(value);
+            ++count;
+            break;
+        }
+        case Kind::Text:
+            writer.appendInt32(com_sun_webkit_dom_DOMSnapshot_JOURNAL_TEXT);
+            writer.appendInt64(record.node);
+            writer.appendString(node->nodeValue());
+            ++count;
+            break;
+        case Kind::Removed:
+            break;
+        }
+    }
+    writer.patchInt32(countOffset, count);
+
+    for (unsigned i = 0; i < m_size; ++i)
+        m_records[(m_start + i) % m_records.size()].attributeName = nullQName();
+    m_start = 0;
+    m_size = 0;
+    m_overflowed = false;
+}
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+extern "C" {
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_dom_DOMSnapshot_startJournalImpl(JNIEnv*, jclass, jlong peer
+    , jint capacity)
+{
+    Document& document = downcast<Document>(*jlong_to_Nodeptr(peer));
+    document.setJavaMutationJournal(std::make_unique<JavaMutationJournal>(capacity));
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_dom_DOMSnapshot_stopJournalImpl(JNIEnv*, jclass, jlong peer)
+{
+    Document& document = downcast<Document>(*jlong_to_Nodeptr(peer));
+    document.setJavaMutationJournal(nullptr);
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DOMSnapshot_drainJournalImpl(JNIEnv* env, jclass, jlong peer
+    , jobjectArray attributeNames)
+{
+    WebCore::JSMainThreadNullState state;
+    Document& document = downcast<Document>(*jlong_to_Nodeptr(peer));
+    JavaMutationJournal* journal = document.javaMutationJournal();
+    if (!journal) {
+        raiseNotSupportedErrorException(env);
+        return 0;
+    }
+    Vector<uint8_t>* data = new Vector<uint8_t>;
+    DOMSnapshotWriter writer(*data, ~0u, attributeNamesFromJava(env, attributeNames), !attributeNames, 0);
+    journal->drain(writer);
+    data->shrinkToFit();
+    return ptr_to_jlong(data);
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include "QualifiedName.h"
+
+#include <wtf/FastMalloc.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class CharacterData;
+class ContainerNode;
+class DOMSnapshotWriter;
+class Document;
+class Element;
+class Node;
+
+// Records the changes to the tree of a document in a fixed size ring
+// buffer, to be drained in batches by com.sun.webkit.dom.DOMSnapshot.
+// Records only hold the node identifier; names, values and positions are
+// read when the journal is drained, so that repeated changes to the same
+// node are cheap and a drained batch reflects the current state.
+class JavaMutationJournal {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit JavaMutationJournal(unsigned capacity);
+
+    void childInserted(ContainerNode& parent, Node& child);
+    void childRemoved(ContainerNode& parent, Node& child);
+    void attributeChanged(Element&, const QualifiedName&);
+    void characterDataChanged(CharacterData&);
+
+    // Writes the recorded changes as described in DOMSnapshot and clears
+    // the journal.
+    void drain(DOMSnapshotWriter&);
+
+private:
+    enum class Kind : uint8_t {
+        Inserted = 1,
+        Removed,
+        Attribute,
+        Text
+    };
+
+    struct Record {
+        Kind kind;
+        uint64_t node;
+        QualifiedName attributeName;
+    };
+
+    static bool isObserved(const Node&);
+    void append(Kind, Node&, const QualifiedName& = nullQName());
+
+    Vector<Record> m_records;
+    unsigned m_start { 0 };
+    unsigned m_size { 0 };
+    bool m_overflowed { false };
+};
+
+} // namespace WebCore
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#include "config.h"
+#include "JavaNodeIdentifier.h"
+
+#include "Node.h"
+#include <wtf/HashMap.h>
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+
+namespace WebCore {
+
+static HashMap<const Node*, uint64_t>& identifiersByNode()
+{
+    static NeverDestroyed<HashMap<const Node*, uint64_t>> map;
+    return map;
+}
+
+static HashMap<uint64_t, Node*>& nodesByIdentifier()
+{
+    static NeverDestroyed<HashMap<uint64_t, Node*>> map;
+    return map;
+}
+
+uint64_t javaNodeIdentifier(Node& node)
+{
+    ASSERT(isMainThread());
+    static uint64_t lastIdentifier;
+
+    auto result = identifiersByNode().add(&node, 0);
+    if (result.isNewEntry) {
+        result.iterator->value = ++lastIdentifier;
+        nodesByIdentifier().add(lastIdentifier, &node);
+        node.setHasJavaNodeIdentifier();
+    }
+    return result.iterator->value;
+}
+
+Node* nodeForJavaNodeIdentifier(uint64_t identifier)
+{
+    ASSERT(isMainThread());
+    if (!identifier)
+        return nullptr;
+    return nodesByIdentifier().get(identifier);
+}
+
+void javaNodeIdentifierWillBeDestroyed(Node& node)
+{
+    ASSERT(isMainThread());
+    uint64_t identifier = identifiersByNode().take(&node);
+    if (identifier)
+        nodesByIdentifier().remove(identifier);
+}
+
+} // namespace WebCore
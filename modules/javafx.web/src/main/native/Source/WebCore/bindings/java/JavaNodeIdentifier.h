@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace WebCore {
+
+class Node;
+
+// Identifiers handed out to Java for DOM snapshots and mutation records.
+// An identifier is assigned on first use, stays the same for the lifetime
+// of the node and is never reused, so that a Java side mirror of the DOM
+// can be kept in sync incrementally. Main thread only.
+uint64_t javaNodeIdentifier(Node&);
+Node* nodeForJavaNodeIdentifier(uint64_t);
+
+// Called by ~Node for nodes that were assigned an identifier.
+void javaNodeIdentifierWillBeDestroyed(Node&);
+
+} // namespace WebCore
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+*/
+
+package com.sun.webkit.dom;
+
+import com.sun.webkit.Disposer;
+import com.sun.webkit.DisposerRecord;
+import java.lang.annotation.Native;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import org.w3c.dom.DOMException;
+import org.w3c.dom.Document;
+import org.w3c.dom.Node;
+import org.w3c.dom.traversal.NodeFilter;
+
+/**
+ * Bulk access to the DOM for code that reads large parts of a document.
+ *
+ * A snapshot serializes a subtree in a single call instead of one call per
+ * property per node. The records are written in document order to a direct
+ * buffer in native byte order:
+ *
+ * <pre>
+ * int    VERSION
+ * int    record count
+ * record:
+ *   long   node id
+ *   long   id of the closest ancestor in the snapshot, 0 for none
+ *   int    node type
+ *   int    flags (HAS_BOX)
+ *   string node name
+ *   string node value
+ *   int    attribute count, followed by name and value strings
+ *   int    x, y, width, height of the absolute bounding box, if HAS_BOX
+ * string:
+ *   int    length in UTF-16 code units, followed by the code units
+ * </pre>
+ *
+ * Node ids stay the same for the lifetime of a node and are never reused,
+ * so a snapshot can be diffed against an earlier one, and the node for an
+ * id can be looked up with {@link #getNode}.
+ *
+ * A copy of a document can be kept up to date by starting a mutation
+ * journal with {@link #startJournal}, taking a snapshot of the document with
+ * all node types and applying the records returned by {@link #drainJournal}
+ * in order, for example once per pulse. A drained journal has this format:
+ *
+ * <pre>
+ * int    VERSION
+ * int    record count
+ * int    flags (JOURNAL_OVERFLOWED)
+ * record:
+ *   int    kind
+ *   long   node id
+ *   JOURNAL_INSERTED:
+ *     long   parent id
+ *     long   id of the previous sibling, 0 to insert as the first child
+ *     int    snapshot record count, followed by the snapshot records of
+ *            the inserted subtree
+ *   JOURNAL_REMOVED:
+ *     (the node and its subtree were removed)
+ *   JOURNAL_ATTRIBUTE:
+ *     string name
+ *     int    1 if the attribute is present, followed by the value string
+ *   JOURNAL_TEXT:
+ *     string the new node value
+ * </pre>
+ *
+ * Names, values and positions are those at the time the journal is drained,
+ * so applying a record is idempotent: an inserted node that is already in
+ * the copy is moved and replaced, and records for unknown nodes can be
+ * ignored. When the journal overflows, older records are dropped and
+ * JOURNAL_OVERFLOWED is set; the copy then has to be rebuilt from a new
+ * snapshot.
+ *
+ * All methods must be called on the FX application thread.
+ */
+public final class DOMSnapshot {
+    @Native public static final int VERSION = 1;
+
+    // Flags for capture
+    /** Include the absolute bounding box of rendered nodes. */
+    @Native public static final int LAYOUT = 1;
+    /** Skip nodes that are not rendered, along with their subtrees. */
+    @Native public static final int RENDERED_ONLY = 2;
+
+    // Record flags
+    @Native public static final int HAS_BOX = 1;
+
+    // Journal record kinds
+    @Native public static final int JOURNAL_INSERTED = 1;
+    @Native public static final int JOURNAL_REMOVED = 2;
+    @Native public static final int JOURNAL_ATTRIBUTE = 3;
+    @Native public static final int JOURNAL_TEXT = 4;
+
+    // Journal flags
+    @Native public static final int JOURNAL_OVERFLOWED = 1;
+
+    /** The default number of records a journal holds between drains. */
+    public static final int DEFAULT_JOURNAL_CAPACITY = 16384;
+
+    private static final class SelfDisposer implements DisposerRecord {
+        private final long data;
+        SelfDisposer(final long data) {
+            this.data = data;
+        }
+        public void dispose() {
+            DOMSnapshot.disposeImpl(data);
+        }
+    }
+
+    private DOMSnapshot() {
+    }
+
+    /**
+     * Serializes the subtree rooted at {@code root}.
+     *
+     * @param root the root of the subtree, which is always visited
+     * @param whatToShow the node types to include, as a mask of
+     *        {@code NodeFilter.SHOW_*} constants; children of nodes that
+     *        are not included are still visited
+     * @param attributeNames the names of the attributes to include, or
+     *        {@code null} for all attributes
+     * @param flags a combination of {@link #LAYOUT} and
+     *        {@link #RENDERED_ONLY}
+     * @return a read-only buffer holding the snapshot
+     */
+    public static ByteBuffer capture(Node root, int whatToShow,
+                                     String[] attributeNames, int flags) {
+        return wrap(captureImpl(NodeImpl.getPeer(root), whatToShow,
+                                attributeNames, flags));
+    }
+
+    /**
+     * Serializes the subtree rooted at {@code root} with all node types
+     * and attributes.
+     */
+    public static ByteBuffer capture(Node root) {
+        return capture(root, NodeFilter.SHOW_ALL, null, 0);
+    }
+
+    /**
+     * Starts recording the changes to the tree of the document, replacing
+     * any journal that was already started.
+     *
+     * @param capacity the number of records to keep between drains
+     */
+    public static void startJournal(Document document, int capacity) {
+        if (capacity <= 0) {
+            throw new IllegalArgumentException("capacity: " + capacity);
+        }
+        startJournalImpl(NodeImpl.getPeer(document), capacity);
+    }
+
+    /**
+     * Stops recording changes to the document and drops pending records.
+     */
+    public static void stopJournal(Document document) {
+        stopJournalImpl(NodeImpl.getPeer(document));
+    }
+
+    /**
+     * Returns the changes recorded since the journal was started or last
+     * drained, and clears the journal.
+     *
+     * @param attributeNames the names of the attributes to include, or
+     *        {@code null} for all attributes
+     * @throws DOMException if no journal was started for the document
+     */
+    public static ByteBuffer drainJournal(Document document, String[] attributeNames) {
+        return wrap(drainJournalImpl(NodeImpl.getPeer(document), attributeNames));
+    }
+
+    /**
+     * Returns the snapshot id of the node.
+     */
+    public static long getNodeId(Node node) {
+        return getNodeIdImpl(NodeImpl.getPeer(node));
+    }
+
+    /**
+     * Returns the node with the given snapshot id, or {@code null} if the
+     * node no longer exists.
+     */
+    public static Node getNode(long id) {
+        return NodeImpl.getImpl(getNodeImpl(id));
+    }
+
+    /**
+     * Returns the elements in the subtree rooted at {@code root} that match
+     * the selectors, in document order. Unlike
+     * {@code querySelectorAll(...).item(i)} this makes a single native call.
+     *
+     * @throws DOMException if the selectors are invalid or {@code root}
+     *         can not have children
+     */
+    public static Node[] querySelectorAll(Node root, String selectors) {
+        long[] peers = querySelectorAllImpl(NodeImpl.getPeer(root), selectors);
+        Node[] nodes = new Node[peers.length];
+        for (int i = 0; i < peers.length; i++) {
+            nodes[i] = NodeImpl.getImpl(peers[i]);
+        }
+        return nodes;
+    }
+
+    private static ByteBuffer wrap(long data) {
+        if (data == 0L) {
+            return null;
+        }
+        ByteBuffer buffer = getBufferImpl(data);
+        // The native memory is freed once the buffer and all its views
+        // become unreachable
+        Disposer.addRecord(buffer, new SelfDisposer(data));
+        return buffer.asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+    }
+
+    native private static long captureImpl(long peer, int whatToShow,
+                                           String[] attributeNames, int flags);
+    native private static void startJournalImpl(long peer, int capacity);
+    native private static void stopJournalImpl(long peer);
+    native private static long drainJournalImpl(long peer, String[] attributeNames);
+    native private static ByteBuffer getBufferImpl(long data);
+    native private static void disposeImpl(long data);
+    native private static long getNodeIdImpl(long peer);
+    native private static long getNodeImpl(long id);
+    native private static long[] querySelectorAllImpl(long peer, String selectors);
+}
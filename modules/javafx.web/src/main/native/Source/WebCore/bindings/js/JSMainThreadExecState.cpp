@@ -29,6 +29,11 @@
 #include "Microtasks.h"
 #include "MutationObserver.h"
 
+#if PLATFORM(JAVA)
+#include "Frame.h"
+#include "ScriptState.h"
+#endif
+
 namespace WebCore {
 
 JSC::ExecState* JSMainThreadExecState::s_mainThreadState = 0;
@@ -38,6 +43,14 @@ void JSMainThreadExecState::didLeaveScriptContext()
     MicrotaskQueue::mainThreadQueue().performMicrotaskCheckpoint();
 }
 
+#if PLATFORM(JAVA)
+void JSMainThreadExecState::beginAccounting(JSC::ExecState* exec)
+{
+    Frame* frame = frameFromExecState(exec);
+    ResourceAccountingJava::begin(frame ? frame->page() : nullptr, ResourceAccountingJava::Activity::Script);
+}
+#endif
+
 JSC::JSValue functionCallHandlerFromAnyThread(JSC::ExecState* exec, JSC::JSValue functionObject, JSC::CallType callType, const JSC::CallData& callData, JSC::JSValue thisValue, const JSC::ArgList& args, NakedPtr<JSC::Exception>& returnedException)
 {
     if (isMainThread())
@@ -36,6 +36,10 @@
 #include "WebCoreThread.h"
 #endif
 
+#if PLATFORM(JAVA)
+#include "ResourceAccountingJava.h"
+#endif
+
 namespace WebCore {
 
 class InspectorInstrumentationCookie;
@@ -130,6 +134,12 @@ private:
     {
         ASSERT(isMainThread());
         s_mainThreadState = exec;
+#if PLATFORM(JAVA)
+        if (UNLIKELY(!m_previousState && ResourceAccountingJava::isEnabled())) {
+            m_isAccounting = true;
+            beginAccounting(exec);
+        }
+#endif
     };
 
     ~JSMainThreadExecState()
@@ -143,6 +153,14 @@ private:
 
         s_mainThreadState = m_previousState;
 
+#if PLATFORM(JAVA)
+        // Ends before the microtask checkpoint. Each promise job and
+        // mutation observer callback runs in its own outermost state, so
+        // it is accounted as script time of the page it belongs to.
+        if (UNLIKELY(m_isAccounting))
+            ResourceAccountingJava::end();
+#endif
+
         if (didExitJavaScript)
             didLeaveScriptContext();
     }
@@ -152,6 +170,11 @@ private:
     WEBCORE_EXPORT static JSC::ExecState* s_mainThreadState;
     JSC::ExecState* m_previousState;
     JSC::JSLockHolder m_lock;
+#if PLATFORM(JAVA)
+    bool m_isAccounting { false };
+
+    static void beginAccounting(JSC::ExecState*);
+#endif
 
     static void didLeaveScriptContext();
 };
@@ -189,6 +189,16 @@ JSValue ScriptController::evaluate(const ScriptSourceCode& sourceCode, Exception
     return evaluateInWorld(sourceCode, mainThreadNormalWorld(), exceptionDetails);
 }
 
+void ScriptController::prepare(const ScriptSourceCode& sourceCode)
+{
+    if (!canExecuteScripts(NotAboutToExecuteScript))
+        return;
+
+    JSLockHolder lock(commonVM());
+    JSDOMWindowShell* shell = windowShell(mainThreadNormalWorld());
+    JSC::prepareProgram(shell->window()->globalExec(), sourceCode.jsSourceCode());
+}
+
 void ScriptController::loadModuleScriptInWorld(LoadableModuleScript& moduleScript, const String& moduleName, DOMWrapperWorld& world)
 {
     JSLockHolder lock(world.vm());
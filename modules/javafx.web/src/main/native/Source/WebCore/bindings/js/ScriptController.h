@@ -115,6 +115,8 @@ public:
 
     JSC::JSValue evaluate(const ScriptSourceCode&, ExceptionDetails* = nullptr);
     JSC::JSValue evaluateInWorld(const ScriptSourceCode&, DOMWrapperWorld&, ExceptionDetails* = nullptr);
+    // Generates the bytecode for a script into the code cache without running it.
+    WEBCORE_EXPORT void prepare(const ScriptSourceCode&);
 
     void loadModuleScriptInWorld(LoadableModuleScript&, const String& moduleName, DOMWrapperWorld&);
     void loadModuleScript(LoadableModuleScript&, const String& moduleName);
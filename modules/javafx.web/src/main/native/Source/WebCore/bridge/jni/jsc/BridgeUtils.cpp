@@ -19,10 +19,13 @@
 #include "JSMainThreadExecState.h"
 #include "JSNode.h"
 #include "ScriptController.h"
+#include "ScriptResultJSC.h"
 #include "runtime_array.h"
 #include "runtime_object.h"
 #include "runtime_root.h"
+#include <runtime/ArrayBuffer.h>
 #include <runtime/JSArray.h>
+#include <runtime/JSArrayBuffer.h>
 #include <runtime/JSLock.h>
 #include <wtf/java/JavaRef.h>
 #include <wtf/text/WTFString.h>
@@ -241,6 +244,72 @@ jobject executeScript(
     return WebCore::JSValue_to_Java_Object(value, env, ctx, rootObject);
 }
 
+jlong executeScriptForResult(
+    JNIEnv* env,
+    JSObjectRef object,
+    JSContextRef ctx,
+    JSC::Bindings::RootObject *rootObject,
+    jstring str)
+{
+    if (str == NULL) {
+        throwNullPointerException(env);
+        return 0;
+    }
+    JSStringRef script = asJSStringRef(env, str);
+    JSValueRef exception = 0;
+    JSValueRef value = JSEvaluateScript(ctx, script, object, NULL, 1, &exception);
+    JSStringRelease(script);
+    if (exception) {
+        throwJavaException(env, ctx, exception, rootObject);
+        return 0;
+    }
+
+    JSC::ExecState* exec = toJS(ctx);
+    JSC::JSValue getterException;
+    RefPtr<ScriptResult> result = ScriptResult::create(exec, toJS(exec, value), getterException);
+    if (!result) {
+        throwJavaException(env, ctx, toRef(exec, getterException), rootObject);
+        return 0;
+    }
+    return ptr_to_jlong(result.leakRef());
+}
+
+jobject createArrayBuffer(
+    JNIEnv* env,
+    JSContextRef ctx,
+    JSC::Bindings::RootObject *rootObject,
+    jobject buffer,
+    jint offset,
+    jint length)
+{
+    char* address = static_cast<char*>(env->GetDirectBufferAddress(buffer));
+    if (!address) {
+        return NULL;
+    }
+
+    // The global reference keeps the Java buffer, and so its memory, alive
+    // until the JavaScript collector frees the ArrayBuffer.
+    jobject globalBuffer = env->NewGlobalRef(buffer);
+    if (!globalBuffer) {
+        return NULL;
+    }
+    RefPtr<JSC::ArrayBuffer> arrayBuffer = JSC::ArrayBuffer::createFromBytes(address + offset, length, [globalBuffer](void*) {
+        if (JNIEnv* env = JavaScriptCore_GetJavaEnv()) {
+            env->DeleteGlobalRef(globalBuffer);
+        }
+    });
+    // Transferring a pinned buffer to a worker copies its contents instead,
+    // so the memory is never released from a thread the VM does not know.
+    arrayBuffer->pin();
+
+    JSC::ExecState* exec = toJS(ctx);
+    JSC::JSLockHolder lock(exec);
+    JSC::JSArrayBuffer* jsBuffer = JSC::JSArrayBuffer::create(exec->vm(),
+        exec->lexicalGlobalObject()->arrayBufferStructure(JSC::ArrayBufferSharingMode::Default),
+        WTFMove(arrayBuffer));
+    return WebCore::JSValue_to_Java_Object(toRef(jsBuffer), env, ctx, rootObject);
+}
+
 }
 
 
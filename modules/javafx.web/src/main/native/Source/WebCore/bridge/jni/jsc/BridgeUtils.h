@@ -22,4 +22,18 @@ namespace WebCore {
                           JSContextRef ctx,
                           JSC::Bindings::RootObject* rootPeer,
                           jstring script);
+    /* Returns a ScriptResult, with a reference for the caller. */
+    jlong executeScriptForResult(JNIEnv* env,
+                                 JSObjectRef object,
+                                 JSContextRef ctx,
+                                 JSC::Bindings::RootObject* rootPeer,
+                                 jstring script);
+    /* Returns a JavaScript ArrayBuffer over length bytes of a direct
+       ByteBuffer from offset, which keeps the ByteBuffer reachable. */
+    jobject createArrayBuffer(JNIEnv* env,
+                              JSContextRef ctx,
+                              JSC::Bindings::RootObject* rootPeer,
+                              jobject buffer,
+                              jint offset,
+                              jint length);
 }  // namespace WebCore
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#include "config.h"
+
+#include "ScriptResultJSC.h"
+
+#include <API/APICast.h>
+#include <API/JSTypedArray.h>
+#include <runtime/ArrayBufferView.h>
+#include <runtime/CatchScope.h>
+#include <runtime/DateInstance.h>
+#include <runtime/JSArray.h>
+#include <runtime/JSArrayBuffer.h>
+#include <runtime/JSArrayBufferView.h>
+#include <runtime/JSCInlines.h>
+#include <runtime/PropertyNameArray.h>
+#include <runtime/Uint8Array.h>
+#include <wtf/HashSet.h>
+#include <wtf/java/JavaEnv.h>
+#include <wtf/java/JavaRef.h>
+
+#include "com_sun_webkit_ScriptResult.h"
+
+using namespace JSC;
+
+namespace WebCore {
+
+class ScriptResultWriter {
+public:
+    ScriptResultWriter(ExecState* exec, ScriptResult& result)
+        : m_exec(exec)
+        , m_vm(exec->vm())
+        , m_result(result)
+    {
+    }
+
+    // Returns false if a getter threw, leaving the exception in m_exception.
+    bool write(JSValue, unsigned depth);
+
+    JSValue m_exception;
+
+private:
+    void appendTag(uint8_t tag) { m_result.m_data.append(tag); }
+    void appendInt32(int32_t value) { append(&value, sizeof(value)); }
+    void appendDouble(double value) { append(&value, sizeof(value)); }
+    void appendString(const String&);
+    void append(const void* data, size_t size) { m_result.m_data.append(static_cast<const uint8_t*>(data), size); }
+
+    bool writeTypedArray(JSObject*);
+    bool writeArray(JSArray*, unsigned depth);
+    bool writeObject(JSObject*, unsigned depth);
+    bool checkException();
+
+    ExecState* m_exec;
+    VM& m_vm;
+    ScriptResult& m_result;
+    // Objects being written, to turn cycles into opaque values
+    HashSet<JSObject*> m_stack;
+};
+
+void ScriptResultWriter::appendString(const String& string)
+{
+    unsigned length = string.length();
+    appendInt32(length);
+    if (!string.is8Bit()) {
+        append(string.characters16(), length * sizeof(UChar));
+        return;
+    }
+    Vector<uint8_t>& data = m_result.m_data;
+    size_t offset = data.size();
+    data.grow(offset + length * sizeof(UChar));
+    const LChar* characters = string.characters8();
+    UChar* out = reinterpret_cast<UChar*>(data.data() + offset);
+    for (unsigned i = 0; i < length; ++i)
+        out[i] = characters[i];
+}
+
+bool ScriptResultWriter::checkException()
+{
+    auto scope = DECLARE_CATCH_SCOPE(m_vm);
+    if (LIKELY(!scope.exception()))
+        return true;
+    m_exception = scope.exception()->value();
+    scope.clearException();
+    return false;
+}
+
+bool ScriptResultWriter::writeTypedArray(JSObject* object)
+{
+    RefPtr<ArrayBufferView> view;
+    if (auto* bufferView = jsDynamicCast<JSArrayBufferView*>(m_vm, object))
+        view = bufferView->possiblySharedImpl();
+    else if (auto* buffer = jsDynamicCast<JSArrayBuffer*>(m_vm, object)) {
+        RefPtr<ArrayBuffer> impl = buffer->impl();
+        view = Uint8Array::create(impl.copyRef(), 0, impl->byteLength());
+    }
+    if (!view)
+        return false;
+    JSTypedArrayType type = JSValueGetTypedArrayType(toRef(m_exec), toRef(object), nullptr);
+
+    // Neutering a pinned buffer copies its contents instead, so the
+    // memory stays valid for as long as the Java side holds the view.
+    view->possiblySharedBuffer()->pin();
+    appendTag(com_sun_webkit_ScriptResult_TAG_TYPED_ARRAY);
+    appendInt32(type);
+    appendInt32(m_result.m_views.size());
+    m_result.m_views.append(WTFMove(view));
+    return true;
+}
+
+bool ScriptResultWriter::writeArray(JSArray* array, unsigned depth)
+{
+    unsigned length = array->length();
+    appendTag(com_sun_webkit_ScriptResult_TAG_ARRAY);
+    appendInt32(length);
+    for (unsigned i = 0; i < length; ++i) {
+        JSValue value;
+        if (array->canGetIndexQuickly(i))
+            value = array->getIndexQuickly(i);
+        else {
+            value = array->get(m_exec, i);
+            if (!checkException())
+                return false;
+        }
+        if (!write(value, depth + 1))
+            return false;
+    }
+    return true;
+}
+
+bool ScriptResultWriter::writeObject(JSObject* object, unsigned depth)
+{
+    PropertyNameArray names(m_exec, PropertyNameMode::Strings);
+    object->methodTable()->getOwnPropertyNames(object, m_exec, names, EnumerationMode());
+    if (!checkException())
+        return false;
+
+    appendTag(com_sun_webkit_ScriptResult_TAG_OBJECT);
+    appendInt32(names.size());
+    for (auto& name : names) {
+        JSValue value = object->get(m_exec, name);
+        if (!checkException())
+            return false;
+        appendString(name.string());
+        if (!write(value, depth + 1))
+            return false;
+    }
+    return true;
+}
+
+bool ScriptResultWriter::write(JSValue value, unsigned depth)
+{
+    if (value.isUndefined()) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_UNDEFINED);
+        return true;
+    }
+    if (value.isNull()) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_NULL);
+        return true;
+    }
+    if (value.isBoolean()) {
+        appendTag(value.asBoolean() ? com_sun_webkit_ScriptResult_TAG_TRUE : com_sun_webkit_ScriptResult_TAG_FALSE);
+        return true;
+    }
+    if (value.isNumber()) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_NUMBER);
+        appendDouble(value.asNumber());
+        return true;
+    }
+    if (value.isString()) {
+        String string = asString(value)->value(m_exec);
+        if (!checkException())
+            return false;
+        appendTag(com_sun_webkit_ScriptResult_TAG_STRING);
+        appendString(string);
+        return true;
+    }
+    if (!value.isObject() || value.isFunction() || depth >= com_sun_webkit_ScriptResult_MAX_DEPTH) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_OPAQUE);
+        return true;
+    }
+
+    JSObject* object = asObject(value);
+    if (auto* date = jsDynamicCast<DateInstance*>(m_vm, object)) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_DATE);
+        appendDouble(date->internalNumber());
+        return true;
+    }
+    if (writeTypedArray(object))
+        return true;
+    if (!m_stack.add(object).isNewEntry) {
+        appendTag(com_sun_webkit_ScriptResult_TAG_OPAQUE);
+        return true;
+    }
+    bool result = isJSArray(object)
+        ? writeArray(asArray(object), depth)
+        : writeObject(object, depth);
+    m_stack.remove(object);
+    return result;
+}
+
+RefPtr<ScriptResult> ScriptResult::create(ExecState* exec, JSValue value, JSValue& exception)
+{
+    JSLockHolder lock(exec);
+    RefPtr<ScriptResult> result = adoptRef(new ScriptResult);
+    ScriptResultWriter writer(exec, *result);
+    if (!writer.write(value, 0)) {
+        exception = writer.m_exception;
+        return nullptr;
+    }
+    result->m_data.shrinkToFit();
+    return result;
+}
+
+ScriptResult::~ScriptResult()
+{
+    for (auto& view : m_views)
+        view->possiblySharedBuffer()->unpin();
+}
+
+jobjectArray ScriptResult::toJavaBuffers(JNIEnv* env)
+{
+    static JGClass byteBufferClass(env->FindClass("java/nio/ByteBuffer"));
+
+    jobjectArray buffers = env->NewObjectArray(m_views.size() + 1, byteBufferClass, nullptr);
+    if (!buffers)
+        return nullptr;
+    for (size_t i = 0; i <= m_views.size(); ++i) {
+        void* address = i ? m_views[i - 1]->baseAddress() : m_data.data();
+        jlong capacity = i ? m_views[i - 1]->byteLength() : m_data.size();
+        JLObject buffer(env->NewDirectByteBuffer(address, capacity));
+        if (!buffer)
+            return nullptr;
+        env->SetObjectArrayElement(buffers, i, buffer);
+    }
+    // Only taken once all the buffers exist, so that a failure part way
+    // does not leave references no buffer will release.
+    for (size_t i = 0; i <= m_views.size(); ++i)
+        ref();
+    return buffers;
+}
+
+} // namespace WebCore
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#pragma once
+
+#include <jni.h>
+
+#include <runtime/JSCJSValue.h>
+#include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+class ArrayBufferView;
+class ExecState;
+}
+
+namespace WebCore {
+
+// The value of a script serialized in the format of com.sun.webkit.ScriptResult.
+// Typed arrays are not copied: the serialized value refers to them by index,
+// and their contents are pinned until the result is destroyed.
+class ScriptResult : public RefCounted<ScriptResult> {
+public:
+    // Returns null and sets exception if a getter threw while serializing.
+    static RefPtr<ScriptResult> create(JSC::ExecState*, JSC::JSValue, JSC::JSValue& exception);
+    ~ScriptResult();
+
+    // Returns the serialized value followed by a view of each typed array.
+    // Every buffer holds a reference to the result, released through
+    // com.sun.webkit.WebPage.twkReleaseScriptResult.
+    jobjectArray toJavaBuffers(JNIEnv*);
+
+private:
+    ScriptResult() { }
+
+    friend class ScriptResultWriter;
+    Vector<uint8_t> m_data;
+    Vector<RefPtr<JSC::ArrayBufferView>> m_views;
+};
+
+} // namespace WebCore
@@ -38,6 +38,10 @@
 #include <unicode/ubrk.h>
 #include <wtf/Ref.h>
 
+#if PLATFORM(JAVA)
+#include "JavaMutationJournal.h"
+#endif
+
 namespace WebCore {
 
 static bool canUseSetDataOptimization(const CharacterData& node)
@@ -215,6 +219,11 @@ void CharacterData::notifyParentAfterChange(ContainerNode::ChildChangeSource sou
 
     document().incDOMTreeVersion();
 
+#if PLATFORM(JAVA)
+    if (auto* journal = document().javaMutationJournal())
+        journal->characterDataChanged(*this);
+#endif
+
     if (!parentNode())
         return;
 
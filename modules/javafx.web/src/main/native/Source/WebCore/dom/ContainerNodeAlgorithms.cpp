@@ -32,6 +32,10 @@
 #include "NoEventDispatchAssertion.h"
 #include "ShadowRoot.h"
 
+#if PLATFORM(JAVA)
+#include "JavaMutationJournal.h"
+#endif
+
 namespace WebCore {
 
 static void notifyNodeInsertedIntoTree(ContainerNode& insertionPoint, ContainerNode&, NodeVector& postInsertionNotificationTargets);
@@ -94,6 +98,10 @@ void notifyChildNodeInserted(ContainerNode& insertionPoint, Node& node, NodeVect
     ASSERT_WITH_SECURITY_IMPLICATION(NoEventDispatchAssertion::isEventDispatchAllowedInSubtree(insertionPoint));
 
     InspectorInstrumentation::didInsertDOMNode(node.document(), node);
+#if PLATFORM(JAVA)
+    if (auto* journal = insertionPoint.document().javaMutationJournal())
+        journal->childInserted(insertionPoint, node);
+#endif
 
     Ref<Document> protectDocument(node.document());
     Ref<Node> protectNode(node);
@@ -153,6 +161,10 @@ void notifyNodeRemovedFromTree(ContainerNode& insertionPoint, ContainerNode& nod
 
 void notifyChildNodeRemoved(ContainerNode& insertionPoint, Node& child)
 {
+#if PLATFORM(JAVA)
+    if (auto* journal = insertionPoint.document().javaMutationJournal())
+        journal->childRemoved(insertionPoint, child);
+#endif
     if (!child.isConnected()) {
         if (is<ContainerNode>(child))
             notifyNodeRemovedFromTree(insertionPoint, downcast<ContainerNode>(child));
@@ -193,6 +193,7 @@
 #include "XPathExpression.h"
 #include "XPathNSResolver.h"
 #include "XPathResult.h"
+#include "XPathUtil.h"
 #include "htmlediting.h"
 #include <ctime>
 #include <inspector/ScriptCallStack.h>
@@ -204,6 +205,8 @@
 #include <yarr/RegularExpression.h>
 
 #if PLATFORM(JAVA)
+#include "JavaMutationJournal.h"
+#include "ResourceAccountingJava.h"
 #include <wtf/unicode/java/UnicodeJava.h>
 #endif
 
@@ -1771,6 +1774,9 @@ void Document::recalcStyle(Style::Change change)
         return; // Guard against re-entrancy. -dwh
 
     TraceScope tracingScope(StyleRecalcStart, StyleRecalcEnd);
+#if PLATFORM(JAVA)
+    ResourceAccountingJava::Scope accountingScope(page(), ResourceAccountingJava::Activity::Style);
+#endif
 
     RenderView::RepaintRegionAccumulator repaintRegionAccumulator(renderView());
     AnimationUpdateBlock animationUpdateBlock(&m_frame->animation());
@@ -5092,6 +5098,13 @@ void Document::clearSharedObjectPool()
     m_sharedObjectPoolClearTimer.stop();
 }
 
+#if PLATFORM(JAVA)
+void Document::setJavaMutationJournal(std::unique_ptr<JavaMutationJournal> journal)
+{
+    m_javaMutationJournal = WTFMove(journal);
+}
+#endif
+
 #if ENABLE(TELEPHONE_NUMBER_DETECTION)
 
 // FIXME: Find a better place for this code.
@@ -5134,6 +5147,18 @@ ExceptionOr<Ref<XPathResult>> Document::evaluate(const String& expression, Node*
     return m_xpathEvaluator->evaluate(expression, contextNode, WTFMove(resolver), type, result);
 }
 
+XPath::TagIndex& Document::xpathTagIndex()
+{
+    if (!m_xpathTagIndex)
+        m_xpathTagIndex = std::make_unique<XPath::TagIndex>();
+    return *m_xpathTagIndex;
+}
+
+void Document::clearXPathTagIndex()
+{
+    m_xpathTagIndex = nullptr;
+}
+
 static bool shouldInheritSecurityOriginFromOwner(const URL& url)
 {
     // Paraphrased from <https://html.spec.whatwg.org/multipage/browsers.html#origin> (8 July 2016)
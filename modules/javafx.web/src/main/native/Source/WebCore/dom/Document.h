@@ -122,6 +122,9 @@ class HitTestRequest;
 class HitTestResult;
 class IntPoint;
 class JSNode;
+#if PLATFORM(JAVA)
+class JavaMutationJournal;
+#endif
 class LayoutPoint;
 class LayoutRect;
 class LiveNodeList;
@@ -218,6 +221,10 @@ namespace Style {
 class Scope;
 };
 
+namespace XPath {
+class TagIndex;
+}
+
 const uint64_t HTMLMediaElementInvalidID = 0;
 
 enum PageshowEventPersistence {
@@ -928,13 +935,20 @@ public:
     TransformSource* transformSource() const { return m_transformSource.get(); }
 #endif
 
-    void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
+    void incDOMTreeVersion()
+    {
+        m_domTreeVersion = ++s_globalTreeVersion;
+        if (UNLIKELY(m_xpathTagIndex))
+            clearXPathTagIndex();
+    }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
     // XPathEvaluator methods
     WEBCORE_EXPORT ExceptionOr<Ref<XPathExpression>> createExpression(const String& expression, RefPtr<XPathNSResolver>&&);
     WEBCORE_EXPORT Ref<XPathNSResolver> createNSResolver(Node* nodeResolver);
     WEBCORE_EXPORT ExceptionOr<Ref<XPathResult>> evaluate(const String& expression, Node* contextNode, RefPtr<XPathNSResolver>&&, unsigned short type, XPathResult*);
+    XPath::TagIndex& xpathTagIndex();
+    void clearXPathTagIndex();
 
     enum PendingSheetLayout { NoLayoutWithPendingSheets, DidLayoutWithPendingSheets, IgnoreLayoutWithPendingSheets };
 
@@ -1205,6 +1219,11 @@ public:
 
     DocumentSharedObjectPool* sharedObjectPool() { return m_sharedObjectPool.get(); }
 
+#if PLATFORM(JAVA)
+    JavaMutationJournal* javaMutationJournal() const { return m_javaMutationJournal.get(); }
+    void setJavaMutationJournal(std::unique_ptr<JavaMutationJournal>);
+#endif
+
     void didRemoveAllPendingStylesheet();
     void didClearStyleResolver();
 
@@ -1546,6 +1565,7 @@ private:
     unsigned m_nodeListAndCollectionCounts[numNodeListInvalidationTypes];
 
     RefPtr<XPathEvaluator> m_xpathEvaluator;
+    std::unique_ptr<XPath::TagIndex> m_xpathTagIndex;
 
     std::unique_ptr<SVGDocumentExtensions> m_svgExtensions;
 
@@ -1694,6 +1714,10 @@ private:
 
     std::unique_ptr<DocumentSharedObjectPool> m_sharedObjectPool;
 
+#if PLATFORM(JAVA)
+    std::unique_ptr<JavaMutationJournal> m_javaMutationJournal;
+#endif
+
 #ifndef NDEBUG
     bool m_didDispatchViewportPropertiesChanged;
 #endif
@@ -108,6 +108,10 @@
 #include <wtf/NeverDestroyed.h>
 #include <wtf/text/CString.h>
 
+#if PLATFORM(JAVA)
+#include "JavaMutationJournal.h"
+#endif
+
 namespace WebCore {
 
 using namespace HTMLNames;
@@ -3365,6 +3369,10 @@ void Element::didAddAttribute(const QualifiedName& name, const AtomicString& val
 {
     attributeChanged(name, nullAtom, value);
     InspectorInstrumentation::didModifyDOMAttr(document(), *this, name.localName(), value);
+#if PLATFORM(JAVA)
+    if (auto* journal = document().javaMutationJournal())
+        journal->attributeChanged(*this, name);
+#endif
     dispatchSubtreeModifiedEvent();
 }
 
@@ -3372,6 +3380,10 @@ void Element::didModifyAttribute(const QualifiedName& name, const AtomicString&
 {
     attributeChanged(name, oldValue, newValue);
     InspectorInstrumentation::didModifyDOMAttr(document(), *this, name.localName(), newValue);
+#if PLATFORM(JAVA)
+    if (auto* journal = document().javaMutationJournal())
+        journal->attributeChanged(*this, name);
+#endif
     // Do not dispatch a DOMSubtreeModified event here; see bug 81141.
 }
 
@@ -3379,6 +3391,10 @@ void Element::didRemoveAttribute(const QualifiedName& name, const AtomicString&
 {
     attributeChanged(name, oldValue, nullAtom);
     InspectorInstrumentation::didRemoveDOMAttr(document(), *this, name.localName());
+#if PLATFORM(JAVA)
+    if (auto* journal = document().javaMutationJournal())
+        journal->attributeChanged(*this, name);
+#endif
     dispatchSubtreeModifiedEvent();
 }
 
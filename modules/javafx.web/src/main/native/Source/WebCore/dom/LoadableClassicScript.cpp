@@ -26,6 +26,8 @@
 #include "config.h"
 #include "LoadableClassicScript.h"
 
+#include "Frame.h"
+#include "ScriptController.h"
 #include "ScriptElement.h"
 #include "ScriptSourceCode.h"
 #include <wtf/NeverDestroyed.h>
@@ -107,6 +109,13 @@ void LoadableClassicScript::execute(ScriptElement& scriptElement)
     scriptElement.executeClassicScript(ScriptSourceCode(m_cachedScript.get(), JSC::SourceProviderSourceType::Program, *this));
 }
 
+void LoadableClassicScript::prepare(Frame& frame)
+{
+    if (!isLoaded() || error())
+        return;
+    frame.script().prepare(ScriptSourceCode(m_cachedScript.get(), JSC::SourceProviderSourceType::Program, *this));
+}
+
 bool LoadableClassicScript::load(Document& document, const URL& sourceURL)
 {
     ASSERT(!m_cachedScript);
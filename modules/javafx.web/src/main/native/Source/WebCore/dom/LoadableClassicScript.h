@@ -52,6 +52,7 @@ public:
     bool isModuleScript() const final { return false; }
 
     void execute(ScriptElement&) final;
+    void prepare(Frame&) final;
 
     bool load(Document&, const URL&);
 
@@ -33,6 +33,7 @@
 
 namespace WebCore {
 
+class Frame;
 class LoadableScriptClient;
 class ScriptElement;
 
@@ -62,6 +63,8 @@ public:
     virtual bool wasCanceled() const = 0;
 
     virtual void execute(ScriptElement&) = 0;
+    // Compiles a loaded script ahead of its execution, where supported.
+    virtual void prepare(Frame&) { }
 
     void addClient(LoadableScriptClient&);
     void removeClient(LoadableScriptClient&);
@@ -78,6 +78,10 @@
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuilder.h>
 
+#if PLATFORM(JAVA)
+#include "JavaNodeIdentifier.h"
+#endif
+
 namespace WebCore {
 
 using namespace HTMLNames;
@@ -300,6 +304,11 @@ Node::~Node()
     if (hasEventTargetData())
         clearEventTargetData();
 
+#if PLATFORM(JAVA)
+    if (hasJavaNodeIdentifier())
+        javaNodeIdentifierWillBeDestroyed(*this);
+#endif
+
     document().decrementReferencingNodeCount();
 }
 
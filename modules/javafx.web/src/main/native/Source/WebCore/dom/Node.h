@@ -325,6 +325,11 @@ public:
     bool hasEventTargetData() const { return getFlag(HasEventTargetDataFlag); }
     void setHasEventTargetData(bool flag) { setFlag(flag, HasEventTargetDataFlag); }
 
+#if PLATFORM(JAVA)
+    bool hasJavaNodeIdentifier() const { return getFlag(HasJavaNodeIdentifierFlag); }
+    void setHasJavaNodeIdentifier() { setFlag(HasJavaNodeIdentifierFlag); }
+#endif
+
     enum UserSelectAllTreatment {
         UserSelectAllDoesNotAffectEditability,
         UserSelectAllIsAlwaysNonEditable
@@ -572,6 +577,9 @@ protected:
         IsStyledElementFlag = 1 << 3,
         IsHTMLFlag = 1 << 4,
         IsSVGFlag = 1 << 5,
+#if PLATFORM(JAVA)
+        HasJavaNodeIdentifierFlag = 1 << 6,
+#endif
         ChildNeedsStyleRecalcFlag = 1 << 7,
         IsConnectedFlag = 1 << 8,
         IsLinkFlag = 1 << 9,
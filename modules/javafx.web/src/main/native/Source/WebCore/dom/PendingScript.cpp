@@ -27,6 +27,7 @@
 #include "config.h"
 #include "PendingScript.h"
 
+#include "Frame.h"
 #include "PendingScriptClient.h"
 #include "ScriptElement.h"
 
@@ -69,8 +70,16 @@ void PendingScript::notifyClientFinished()
         m_client->notifyFinished(*this);
 }
 
-void PendingScript::notifyFinished(LoadableScript&)
+void PendingScript::notifyFinished(LoadableScript& loadableScript)
 {
+    // Compile the script as soon as it arrives, so that deferred scripts and scripts
+    // waiting for style sheets or for earlier scripts only have to be linked when they run.
+    // Scripts that were canceled or removed from the document are left to compile on
+    // execution, if they run at all.
+    Element& element = m_element->element();
+    auto* frame = element.document().frame();
+    if (frame && element.isConnected() && !loadableScript.wasCanceled())
+        loadableScript.prepare(*frame);
     notifyClientFinished();
 }
 
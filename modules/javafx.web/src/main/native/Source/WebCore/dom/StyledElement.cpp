@@ -40,6 +40,10 @@
 #include "StyleResolver.h"
 #include <wtf/HashFunctions.h>
 
+#if PLATFORM(JAVA)
+#include "JavaMutationJournal.h"
+#endif
+
 namespace WebCore {
 
 COMPILE_ASSERT(sizeof(StyledElement) == sizeof(Element), styledelement_should_remain_same_size_as_element);
@@ -158,6 +162,10 @@ void StyledElement::inlineStyleChanged()
 {
     invalidateStyleAttribute();
     InspectorInstrumentation::didInvalidateStyleAttr(document(), *this);
+#if PLATFORM(JAVA)
+    if (auto* journal = document().javaMutationJournal())
+        journal->attributeChanged(*this, HTMLNames::styleAttr);
+#endif
 }
 
 bool StyledElement::setInlineStyleProperty(CSSPropertyID propertyID, CSSValueID identifier, bool important)
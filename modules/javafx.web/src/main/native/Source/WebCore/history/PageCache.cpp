@@ -466,6 +466,16 @@ void PageCache::removeAllItemsForPage(Page& page)
     }
 }
 
+#if PLATFORM(JAVA)
+void PageCache::forEachCachedPage(Page& page, const std::function<void(CachedPage&)>& function)
+{
+    for (auto& item : m_items) {
+        if (&item->m_cachedPage->page() == &page)
+            function(*item->m_cachedPage);
+    }
+}
+#endif
+
 CachedPage* PageCache::get(HistoryItem& item, Page* page)
 {
     CachedPage* cachedPage = item.m_cachedPage.get();
@@ -58,6 +58,9 @@ public:
     std::unique_ptr<CachedPage> take(HistoryItem&, Page*);
 
     void removeAllItemsForPage(Page&);
+#if PLATFORM(JAVA)
+    void forEachCachedPage(Page&, const std::function<void(CachedPage&)>&);
+#endif
 
     unsigned pageCount() const { return m_items.size(); }
     WEBCORE_EXPORT unsigned frameCount() const;
@@ -42,6 +42,11 @@ namespace WebCore {
 
 using namespace HTMLNames;
 
+// The number of tokens the preload scanner gets ahead of the parser each
+// time the parser yields, so that a large buffered document is scanned over
+// several yields instead of in one long pass.
+static const unsigned preloadScanTokensPerYield = 512;
+
 HTMLDocumentParser::HTMLDocumentParser(HTMLDocument& document)
     : ScriptableDocumentParser(document)
     , m_options(document)
@@ -248,6 +253,8 @@ bool HTMLDocumentParser::pumpTokenizerLoop(SynchronousMode mode, bool parsingFra
         if (!token)
             return false;
 
+        ++m_tokensParsedSincePreloadScan;
+
         if (!parsingFragment) {
             m_sourceTracker.endToken(m_input.current(), m_tokenizer);
 
@@ -287,16 +294,38 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     if (shouldResume)
         m_parserScheduler->scheduleForResume();
 
-    if (isWaitingForScripts()) {
+    // While the parser yields, scan some of the input it has not reached yet
+    // so that subresource loads start before the tree builder gets to them.
+    // The scanner keeps its position, so each byte is only scanned once.
+    // Outside the data state the input is script or style text, not markup.
+    bool shouldScanAhead = shouldResume && m_tokenizer.isInDataState();
+
+    if (isWaitingForScripts() || shouldScanAhead) {
         ASSERT(m_tokenizer.isInDataState());
         if (!m_preloadScanner) {
             m_preloadScanner = std::make_unique<HTMLPreloadScanner>(m_options, document()->url(), document()->deviceScaleFactor());
             m_preloadScanner->appendToEnd(m_input.current());
+            m_tokensParsedSincePreloadScan = 0;
         }
-        m_preloadScanner->scan(*m_preloader, *document());
+        if (isWaitingForScripts()) {
+            m_preloadScanner->scan(*m_preloader, *document());
+            m_tokensParsedSincePreloadScan = 0;
+        } else
+            scanAheadForPreloads();
     }
 }
 
+void HTMLDocumentParser::scanAheadForPreloads()
+{
+    // A parser slice consumes thousands of tokens, so a fixed budget would
+    // leave the scanner further behind the parser on every yield, scanning
+    // input that was already parsed. Move it on by as many tokens as the
+    // parser consumed since the last scan, plus the look ahead.
+    unsigned budget = m_tokensParsedSincePreloadScan + preloadScanTokensPerYield;
+    m_tokensParsedSincePreloadScan = 0;
+    m_preloadScanner->scan(*m_preloader, *document(), budget);
+}
+
 void HTMLDocumentParser::constructTreeFromHTMLToken(HTMLTokenizer::TokenPtr& rawToken)
 {
     AtomicHTMLToken token(*rawToken);
@@ -372,8 +401,11 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
             m_preloadScanner = nullptr;
         } else {
             m_preloadScanner->appendToEnd(source);
-            if (isWaitingForScripts())
+            if (isWaitingForScripts()) {
                 m_preloadScanner->scan(*m_preloader, *document());
+                m_tokensParsedSincePreloadScan = 0;
+            } else if (isScheduledForResume())
+                scanAheadForPreloads();
         }
     }
 
@@ -514,6 +546,7 @@ void HTMLDocumentParser::appendCurrentInputStreamToPreloadScannerAndScan()
     ASSERT(m_preloadScanner);
     m_preloadScanner->appendToEnd(m_input.current());
     m_preloadScanner->scan(*m_preloader, *document());
+    m_tokensParsedSincePreloadScan = 0;
 }
 
 void HTMLDocumentParser::notifyFinished(PendingScript& pendingScript)
@@ -111,6 +111,8 @@ private:
     void runScriptsForPausedTreeBuilder();
     void resumeParsingAfterScriptExecution();
 
+    void scanAheadForPreloads();
+
     void attemptToEnd();
     void endIfDelayed();
     void attemptToRunDeferredScriptsAndEnd();
@@ -139,6 +141,7 @@ private:
 
     bool m_endWasDelayed { false };
     unsigned m_pumpSessionNestingLevel { 0 };
+    unsigned m_tokensParsedSincePreloadScan { 0 };
 };
 
 inline HTMLTokenizer& HTMLDocumentParser::tokenizer()
@@ -420,7 +420,7 @@ void HTMLPreloadScanner::appendToEnd(const SegmentedString& source)
     m_source.append(source);
 }
 
-void HTMLPreloadScanner::scan(HTMLResourcePreloader& preloader, Document& document)
+void HTMLPreloadScanner::scan(HTMLResourcePreloader& preloader, Document& document, unsigned maxTokens)
 {
     ASSERT(isMainThread()); // HTMLTokenizer::updateStateFor only works on the main thread.
 
@@ -432,7 +432,10 @@ void HTMLPreloadScanner::scan(HTMLResourcePreloader& preloader, Document& docume
 
     PreloadRequestStream requests;
 
-    while (auto token = m_tokenizer.nextToken(m_source)) {
+    for (unsigned count = 0; count < maxTokens; ++count) {
+        auto token = m_tokenizer.nextToken(m_source);
+        if (!token)
+            break;
         if (token->type() == HTMLToken::StartTag)
             m_tokenizer.updateStateFor(AtomicString(token->name()));
         m_scanner.scan(*token, requests, document);
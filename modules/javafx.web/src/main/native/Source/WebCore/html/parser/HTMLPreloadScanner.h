@@ -87,7 +87,9 @@ public:
     HTMLPreloadScanner(const HTMLParserOptions&, const URL& documentURL, float deviceScaleFactor = 1.0);
 
     void appendToEnd(const SegmentedString&);
-    void scan(HTMLResourcePreloader&, Document&);
+    // Scans at most maxTokens tokens; the rest of the input is left for
+    // the next call.
+    void scan(HTMLResourcePreloader&, Document&, unsigned maxTokens = std::numeric_limits<unsigned>::max());
 
 private:
     TokenPreloadScanner m_scanner;
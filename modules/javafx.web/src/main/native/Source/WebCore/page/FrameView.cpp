@@ -115,6 +115,10 @@
 #include "LegacyTileCache.h"
 #endif
 
+#if PLATFORM(JAVA)
+#include "ResourceAccountingJava.h"
+#endif
+
 namespace WebCore {
 
 using namespace HTMLNames;
@@ -1317,6 +1321,9 @@ void FrameView::layout(bool allowSubtree)
     }
 
     TraceScope tracingScope(LayoutStart, LayoutEnd);
+#if PLATFORM(JAVA)
+    ResourceAccountingJava::Scope accountingScope(frame().page(), ResourceAccountingJava::Activity::Layout);
+#endif
 
 #if PLATFORM(IOS)
     if (updateFixedPositionLayoutRect())
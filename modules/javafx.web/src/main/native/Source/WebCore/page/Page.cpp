@@ -132,6 +132,10 @@
 #include "SelectionRect.h"
 #endif
 
+#if PLATFORM(JAVA)
+#include "ResourceAccountingJava.h"
+#endif
+
 namespace WebCore {
 
 static HashSet<Page*>* allPages;
@@ -947,8 +951,20 @@ void Page::didFinishLoad()
 
     if (m_performanceMonitor)
         m_performanceMonitor->didFinishLoad();
+
+#if PLATFORM(JAVA)
+    if (m_resourceAccounting)
+        m_resourceAccounting->didFinishLoad();
+#endif
 }
 
+#if PLATFORM(JAVA)
+void Page::setResourceAccounting(RefPtr<ResourceAccountingJava>&& resourceAccounting)
+{
+    m_resourceAccounting = WTFMove(resourceAccounting);
+}
+#endif
+
 bool Page::isOnlyNonUtilityPage() const
 {
     return !isUtilityPage() && nonUtilityPageCount == 1;
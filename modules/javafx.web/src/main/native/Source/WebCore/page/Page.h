@@ -118,6 +118,9 @@ class RenderObject;
 class RenderTheme;
 class ReplayController;
 class ResourceUsageOverlay;
+#if PLATFORM(JAVA)
+class ResourceAccountingJava;
+#endif
 class VisibleSelection;
 class ScrollableArea;
 class ScrollingCoordinator;
@@ -573,6 +576,11 @@ public:
     bool isOnlyNonUtilityPage() const;
     bool isUtilityPage() const { return m_isUtilityPage; }
 
+#if PLATFORM(JAVA)
+    ResourceAccountingJava* resourceAccounting() const { return m_resourceAccounting.get(); }
+    void setResourceAccounting(RefPtr<ResourceAccountingJava>&&);
+#endif
+
 #if ENABLE(DATA_INTERACTION)
     WEBCORE_EXPORT bool hasDataInteractionAtPosition(const FloatPoint&) const;
 #endif
@@ -782,6 +790,10 @@ private:
 
     std::unique_ptr<PerformanceMonitor> m_performanceMonitor;
 
+#if PLATFORM(JAVA)
+    RefPtr<ResourceAccountingJava> m_resourceAccounting;
+#endif
+
     bool m_isRunningUserScripts { false };
 };
 
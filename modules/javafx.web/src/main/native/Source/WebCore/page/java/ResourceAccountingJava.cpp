@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+#include "ResourceAccountingJava.h"
+
+#include "CachedPage.h"
+#include "CachedResource.h"
+#include "CachedResourceLoader.h"
+#include "CommonVM.h"
+#include "Document.h"
+#include "MainFrame.h"
+#include "Page.h"
+#include "PageCache.h"
+#include <heap/HeapInlines.h>
+#include <runtime/VM.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashSet.h>
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+
+#if OS(LINUX)
+#include <time.h>
+#endif
+
+namespace WebCore {
+
+unsigned ResourceAccountingJava::s_instanceCount;
+
+ResourceAccountingJava::ResourceAccountingJava(Page& page)
+    : m_page(page)
+{
+    ++s_instanceCount;
+}
+
+ResourceAccountingJava::~ResourceAccountingJava()
+{
+    --s_instanceCount;
+}
+
+Vector<ResourceAccountingJava::Entry, 8>& ResourceAccountingJava::stack()
+{
+    static NeverDestroyed<Vector<Entry, 8>> stack;
+    return stack;
+}
+
+// WTF::currentCPUTime() falls back to wall time on Linux. The JSC watchdog
+// keeps using that clock, so the thread CPU clock is only read here.
+static std::chrono::microseconds threadCPUTime()
+{
+#if OS(LINUX)
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(ts.tv_nsec));
+#else
+    return WTF::currentCPUTime();
+#endif
+}
+
+static Seconds totalGarbageCollectionTime()
+{
+    return commonVM().heap.totalGCLength();
+}
+
+void ResourceAccountingJava::begin(Page* page, Activity activity)
+{
+    ASSERT(isMainThread());
+    auto cpuTime = threadCPUTime();
+    auto garbageCollectionTime = totalGarbageCollectionTime();
+    auto& entries = stack();
+    if (!entries.isEmpty())
+        pause(entries.last(), cpuTime, garbageCollectionTime);
+    // Pages without accounting still get an entry, so that their time is
+    // not attributed to an enclosing page.
+    entries.append(Entry { page ? page->resourceAccounting() : nullptr, activity, cpuTime, garbageCollectionTime });
+}
+
+void ResourceAccountingJava::end()
+{
+    ASSERT(isMainThread());
+    auto cpuTime = threadCPUTime();
+    auto garbageCollectionTime = totalGarbageCollectionTime();
+    auto& entries = stack();
+    ASSERT(!entries.isEmpty());
+    Entry entry = entries.takeLast();
+    pause(entry, cpuTime, garbageCollectionTime);
+    if (entry.accounting)
+        ++entry.accounting->m_counters.count[static_cast<unsigned>(entry.activity)];
+    if (!entries.isEmpty()) {
+        entries.last().cpuTimeStart = cpuTime;
+        entries.last().garbageCollectionTimeStart = garbageCollectionTime;
+    }
+}
+
+void ResourceAccountingJava::pause(Entry& entry, std::chrono::microseconds cpuTime, Seconds garbageCollectionTime)
+{
+    if (!entry.accounting)
+        return;
+    auto& counters = entry.accounting->m_counters;
+    counters.time[static_cast<unsigned>(entry.activity)] += cpuTime - entry.cpuTimeStart;
+    // Collections run as the page allocates, which is mostly from its
+    // JavaScript, and partly on other threads, so this is wall clock time.
+    counters.garbageCollectionTime += garbageCollectionTime - entry.garbageCollectionTimeStart;
+}
+
+template<typename Function>
+static void forEachResource(Document& document, HashSet<CachedResource*>& seen, const Function& function)
+{
+    for (auto& resource : document.cachedResourceLoader().allCachedResources().values()) {
+        if (resource && seen.add(resource.get()).isNewEntry)
+            function(*resource);
+    }
+}
+
+ResourceAccountingJava::MemoryUsage ResourceAccountingJava::measureMemoryUsage() const
+{
+    // A resource that several pages use is counted for each of them.
+    MemoryUsage usage;
+    HashSet<CachedResource*> seen;
+    for (Frame* frame = &m_page.mainFrame(); frame; frame = frame->tree().traverseNext()) {
+        if (!frame->document())
+            continue;
+        forEachResource(*frame->document(), seen, [&usage](CachedResource& resource) {
+            usage.resourceBytes += resource.size();
+            if (resource.isImage())
+                usage.decodedImageBytes += resource.decodedSize();
+        });
+    }
+
+    PageCache::singleton().forEachCachedPage(m_page, [&](CachedPage& cachedPage) {
+        ++usage.pageCachePages;
+        if (!cachedPage.document())
+            return;
+        forEachResource(*cachedPage.document(), seen, [&usage](CachedResource& resource) {
+            usage.pageCacheBytes += resource.size();
+        });
+    });
+    return usage;
+}
+
+void ResourceAccountingJava::setSoftLimit(size_t softLimit)
+{
+    m_softLimit = softLimit;
+    enforceSoftLimit();
+}
+
+void ResourceAccountingJava::didFinishLoad()
+{
+    enforceSoftLimit();
+}
+
+void ResourceAccountingJava::enforceSoftLimit()
+{
+    if (!m_softLimit || measureMemoryUsage().totalBytes() <= m_softLimit)
+        return;
+
+    ++m_counters.evictionCount;
+    PageCache::singleton().removeAllItemsForPage(m_page);
+    if (measureMemoryUsage().totalBytes() <= m_softLimit)
+        return;
+
+    // Cached images are shared through the memory cache, so the resources
+    // that the documents of other pages use are marked as seen up front and
+    // keep their decoded data.
+    HashSet<CachedResource*> seen;
+    Page::forEachPage([this, &seen](Page& page) {
+        if (&page == &m_page)
+            return;
+        for (Frame* frame = &page.mainFrame(); frame; frame = frame->tree().traverseNext()) {
+            if (frame->document())
+                forEachResource(*frame->document(), seen, [](CachedResource&) { });
+        }
+    });
+
+    for (Frame* frame = &m_page.mainFrame(); frame; frame = frame->tree().traverseNext()) {
+        if (!frame->document())
+            continue;
+        frame->document()->clearSelectorQueryCache();
+        forEachResource(*frame->document(), seen, [](CachedResource& resource) {
+            if (resource.isImage())
+                resource.destroyDecodedData();
+        });
+    }
+}
+
+} // namespace WebCore
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <wtf/RefCounted.h>
+#include <wtf/Seconds.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Page;
+
+// Attributes the main thread CPU time spent in style resolution, layout,
+// painting and JavaScript to the page it is spent for, along with the
+// garbage collections that finish while the JavaScript of the page runs,
+// and measures the memory held for the page. The time of nested
+// activities is only attributed to the innermost one, so the times add
+// up to the time spent in all of them.
+//
+// A soft limit on the memory held for a page evicts its page cache
+// entries and decoded image data when it is exceeded after a load, without
+// touching the other pages. Images that other pages use keep their
+// decoded data.
+class ResourceAccountingJava : public RefCounted<ResourceAccountingJava> {
+public:
+    // Keep in sync with the activities in ResourceCounters.java.
+    enum class Activity { Style, Layout, Paint, Script };
+    static const unsigned activityCount = 4;
+
+    struct MemoryUsage {
+        size_t resourceBytes { 0 };
+        size_t decodedImageBytes { 0 };
+        size_t pageCacheBytes { 0 };
+        unsigned pageCachePages { 0 };
+
+        size_t totalBytes() const { return resourceBytes + pageCacheBytes; }
+    };
+
+    struct Counters {
+        std::chrono::microseconds time[activityCount] { };
+        unsigned count[activityCount] { };
+        Seconds garbageCollectionTime;
+        unsigned evictionCount { 0 };
+    };
+
+    static Ref<ResourceAccountingJava> create(Page& page) { return adoptRef(*new ResourceAccountingJava(page)); }
+    ~ResourceAccountingJava();
+
+    // Attributes the time until the end of the scope to the page, if it
+    // has accounting enabled. Costs a load and a branch while no page has.
+    class Scope {
+        WTF_MAKE_NONCOPYABLE(Scope);
+    public:
+        Scope(Page* page, Activity activity)
+            : m_isActive(isEnabled())
+        {
+            if (UNLIKELY(m_isActive))
+                begin(page, activity);
+        }
+
+        ~Scope()
+        {
+            if (UNLIKELY(m_isActive))
+                end();
+        }
+
+    private:
+        bool m_isActive;
+    };
+
+    static bool isEnabled() { return s_instanceCount; }
+    static void begin(Page*, Activity);
+    static void end();
+
+    const Counters& counters() const { return m_counters; }
+    MemoryUsage measureMemoryUsage() const;
+
+    size_t softLimit() const { return m_softLimit; }
+    void setSoftLimit(size_t);
+
+    void didFinishLoad();
+
+private:
+    explicit ResourceAccountingJava(Page&);
+
+    struct Entry {
+        RefPtr<ResourceAccountingJava> accounting;
+        Activity activity;
+        std::chrono::microseconds cpuTimeStart;
+        Seconds garbageCollectionTimeStart;
+    };
+
+    static Vector<Entry, 8>& stack();
+    static void pause(Entry&, std::chrono::microseconds cpuTime, Seconds garbageCollectionTime);
+
+    void enforceSoftLimit();
+
+    static unsigned s_instanceCount;
+
+    Page& m_page;
+    Counters m_counters;
+    size_t m_softLimit { 0 };
+};
+
+} // namespace WebCore
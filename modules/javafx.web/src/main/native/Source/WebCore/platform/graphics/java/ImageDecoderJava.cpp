@@ -31,6 +31,7 @@
 #include "SharedBuffer.h"
 #include <wtf/java/JavaEnv.h>
 #include "Logging.h"
+#include <wtf/SystemTracing.h>
 
 namespace WebCore {
 
@@ -174,6 +175,7 @@ NativeImagePtr ImageDecoder::createFrameImageAtIndex(size_t idx, SubsamplingLeve
         "(I)Lcom/sun/webkit/graphics/WCImageFrame;");
     ASSERT(midGetFrame);
 
+    TraceScope tracingScope(ImageDecodeStart, ImageDecodeEnd);
     JLObject frame(env->CallObjectMethod(
         m_nativeDecoder,
         midGetFrame,
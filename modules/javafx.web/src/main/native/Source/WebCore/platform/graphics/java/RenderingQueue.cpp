@@ -10,6 +10,7 @@
 
 #include <wtf/java/JavaRef.h>
 #include <wtf/HashMap.h>
+#include <wtf/SystemTracing.h>
 
 #include "com_sun_webkit_graphics_WCRenderQueue.h"
 
@@ -81,6 +82,7 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     if (isEmpty()) {
         return *this;
     }
+    TracePoint(RenderingQueueFlush, m_buffer->size());
     JNIEnv* env = WebCore_GetJavaEnv();
 
     static jmethodID midFwkAddBuffer = env->GetMethodID(PG_GetRenderQueueClass(env),
@@ -55,6 +55,8 @@ public:
 
     bool isEmpty() { return m_position == 0; }
 
+    int size() const { return m_position; }
+
     ~ByteBuffer() {
         delete[] m_buffer;
     }
@@ -29,6 +29,7 @@
 #include "PopupMenuJava.h"
 #include "ResourceRequest.h"
 #include "SearchPopupMenuJava.h"
+#include "StringJava.h"
 #include "WebPage.h"
 #include "Widget.h"
 #include "WindowFeatures.h"
@@ -496,13 +497,7 @@ void ChromeClientJava::runOpenPanel(Frame&, FileChooser& fileChooser)
     CheckAndClearException(env);
 
     if (jfiles) {
-        Vector<String> files;
-        jsize length = env->GetArrayLength(jfiles);
-        for (int i = 0; i < length; i++) {
-            JLString f((jstring) env->GetObjectArrayElement(jfiles, i));
-            files.append(String(env, f));
-        }
-        fileChooser.chooseFiles(files);
+        fileChooser.chooseFiles(jArray2StrVect(env, jfiles));
     }
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
  */
 #include "config.h"
 
@@ -12,30 +12,37 @@ using WTF::String;
 
 jobjectArray strVect2JArray(JNIEnv* env, const Vector<String>& strVect)
 {
-    if (!strVect.size()) {
-        jobjectArray arr = (jobjectArray) env->NewObjectArray(0,
-            JLClass(env->FindClass("java/lang/String")), 0);
-        CheckAndClearException(env); // OOME
-        return arr;
-    }
-
-    ASSERT(strVect[0]);
-    JLString str(strVect[0].toJavaString(env));
+    static JGClass stringClass(env->FindClass("java/lang/String"));
 
-    JLClass sclass(env->GetObjectClass(str));
     jobjectArray strArray =
-        (jobjectArray) env->NewObjectArray(strVect.size(), sclass, 0);
-    CheckAndClearException(env); // OOME
-
-    env->SetObjectArrayElement(strArray, 0, (jstring)str);
+        (jobjectArray) env->NewObjectArray(strVect.size(), stringClass, 0);
+    if (CheckAndClearException(env)) { // OOME
+        return nullptr;
+    }
 
-    for (size_t i = 1; i < strVect.size(); i++) {
+    for (size_t i = 0; i < strVect.size(); i++) {
         ASSERT(strVect[i]);
-        str = strVect[i].toJavaString(env);
+        JLString str(strVect[i].toJavaString(env));
         env->SetObjectArrayElement(strArray, i, (jstring)str);
     }
 
     return strArray;
 }
 
+Vector<String> jArray2StrVect(JNIEnv* env, jobjectArray strArray)
+{
+    Vector<String> strVect;
+    if (!strArray) {
+        return strVect;
+    }
+
+    jsize length = env->GetArrayLength(strArray);
+    strVect.reserveInitialCapacity(length);
+    for (jsize i = 0; i < length; i++) {
+        JLString str((jstring) env->GetObjectArrayElement(strArray, i));
+        strVect.uncheckedAppend(String(env, str));
+    }
+    return strVect;
+}
+
 } // namespace WebCore
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
  */
 
 #pragma once
@@ -11,5 +11,8 @@ namespace WebCore {
 using WTF::String;
 jobjectArray strVect2JArray(
     JNIEnv* env, const Vector<String>& strVect);
+// Null elements become empty strings
+Vector<String> jArray2StrVect(
+    JNIEnv* env, jobjectArray strArray);
 
 } // namespace WebCore
@@ -55,6 +55,8 @@
 #include <wtf/java/DbgUtils.h>
 #include <wtf/java/JavaRef.h>
 #include <wtf/RunLoop.h>
+#include <wtf/Stopwatch.h>
+#include <wtf/SystemTracing.h>
 
 #if USE(ACCELERATED_COMPOSITING)
 #include "TextureMapper.h"
@@ -82,7 +84,9 @@
 #include "PlatformWheelEvent.h"
 #include "ProgressTrackerClientJava.h"
 #include "RenderThemeJava.h"
+#include "ResourceAccountingJava.h"
 #include "ResourceRequest.h"
+#include "ScriptSourceCode.h"
 #include "java/WebKitLogging.h"
 #include "java/BackForwardList.h"
 #include "Storage/WebDatabaseProvider.h"
@@ -94,7 +98,9 @@
 #include "WorkerThread.h"
 #include "testing/js/WebCoreTestSupport.h"
 #include "jsc/BridgeUtils.h"
+#include "jsc/ScriptResultJSC.h"
 #include "ChromeClientJava.h"
+#include "CommonVM.h"
 #include "WebPageConfig.h"
 
 #include <wtf/text/WTFString.h>
@@ -104,6 +110,8 @@
 #include <runtime/JSObject.h>
 #include <runtime/JSCJSValue.h>
 #include <runtime/Options.h>
+#include <runtime/SamplingProfiler.h>
+#include <heap/HeapSnapshotBuilder.h>
 #include <JSLock.h>
 #include <API/APICast.h>
 #include <API/JSStringRef.h>
@@ -118,6 +126,7 @@
 #endif
 
 
+#include "com_sun_webkit_ResourceCounters.h"
 #include "com_sun_webkit_WebPage.h"
 #include "com_sun_webkit_event_WCFocusEvent.h"
 #include "com_sun_webkit_event_WCKeyEvent.h"
@@ -231,6 +240,8 @@ static void drawDebugBorder(GraphicsContext& context,
 #endif
 
 void WebPage::prePaint() {
+    TraceScope tracingScope(WebPagePrePaintStart, WebPagePrePaintEnd);
+
 #if USE(ACCELERATED_COMPOSITING)
     if (m_rootLayer) {
         if (m_syncLayers) {
@@ -257,6 +268,7 @@ void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
 #endif
 
     DBG_CHECKPOINTEX("twkUpdateContent", 15, 100);
+    TraceScope tracingScope(WebPagePaintStart, WebPagePaintEnd);
 
     RefPtr<Frame> mainFrame((Frame*)&m_page->mainFrame());
     RefPtr<FrameView> frameView(mainFrame->view());
@@ -264,6 +276,8 @@ void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
         return;
     }
 
+    ResourceAccountingJava::Scope accountingScope(m_page.get(), ResourceAccountingJava::Activity::Paint);
+
     // Will be deleted by GraphicsContext destructor
     PlatformContextJava* ppgc = new PlatformContextJava(rq);
     GraphicsContext gc(ppgc);
@@ -290,6 +304,9 @@ void WebPage::postPaint(jobject rq, jint x, jint y, jint w, jint h)
         return;
     }
 
+    TraceScope tracingScope(WebPagePostPaintStart, WebPagePostPaintEnd);
+    ResourceAccountingJava::Scope accountingScope(m_page.get(), ResourceAccountingJava::Activity::Paint);
+
     // Will be deleted by GraphicsContext destructor
     PlatformContextJava* ppgc = new PlatformContextJava(rq);
     GraphicsContext gc(ppgc);
@@ -418,6 +435,8 @@ void WebPage::syncLayers()
         return;
     }
 
+    TraceScope tracingScope(WebPageSyncLayersStart, WebPageSyncLayersEnd);
+
     ((Frame*)&m_page->mainFrame())->view()->updateLayoutAndStyleIfNeededRecursive();
 
     // Updating layout might have taken us out of compositing mode
@@ -472,6 +491,8 @@ void WebPage::paintContents(const GraphicsLayer*,
                             GraphicsLayerPaintingPhase,
                             const FloatRect& inClip)
 {
+    ResourceAccountingJava::Scope accountingScope(m_page.get(), ResourceAccountingJava::Activity::Paint);
+
     context.save();
     context.clip(inClip);
     ((Frame*)&m_page->mainFrame())->view()->paint(&context, roundedIntRect(inClip));
@@ -1394,6 +1415,65 @@ JNIEXPORT jobject JNICALL Java_com_sun_webkit_WebPage_twkExecuteScript
         script);
 }
 
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_WebPage_twkCreateArrayBuffer
+    (JNIEnv* env, jobject self, jlong pFrame, jobject buffer, jint offset, jint length)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    if (!frame) {
+        return NULL;
+    }
+    JSGlobalContextRef globalContext = getGlobalContext(&frame->script());
+    RefPtr<JSC::Bindings::RootObject> rootObject(frame->script().createRootObject(frame));
+    return WebCore::createArrayBuffer(
+        env,
+        globalContext,
+        rootObject.get(),
+        buffer,
+        offset,
+        length);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkPrepareScript
+    (JNIEnv* env, jobject self, jlong pFrame, jstring script)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    if (!frame || !script) {
+        return;
+    }
+    // Matches the source that JSEvaluateScript creates in executeScript,
+    // the code cache is keyed by the script text
+    frame->script().prepare(ScriptSourceCode(String(env, script), URL(), TextPosition(), JSC::SourceProviderSourceType::Program, CachedScriptFetcher::create(frame->document()->charset())));
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkExecuteScriptForResult
+    (JNIEnv* env, jobject self, jlong pFrame, jstring script)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    if (!frame) {
+        return 0;
+    }
+    JSGlobalContextRef globalContext = getGlobalContext(&frame->script());
+    RefPtr<JSC::Bindings::RootObject> rootObject(frame->script().createRootObject(frame));
+    return WebCore::executeScriptForResult(
+        env,
+        NULL,
+        globalContext,
+        rootObject.get(),
+        script);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_sun_webkit_WebPage_twkGetScriptResultBuffers
+    (JNIEnv* env, jclass, jlong pResult)
+{
+    return static_cast<ScriptResult*>(jlong_to_ptr(pResult))->toJavaBuffers(env);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkReleaseScriptResult
+    (JNIEnv*, jclass, jlong pResult)
+{
+    static_cast<ScriptResult*>(jlong_to_ptr(pResult))->deref();
+}
+
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkAddJavaScriptBinding
     (JNIEnv* env, jobject self, jlong pFrame, jstring name, jobject value, jobject accessControlContext)
 {
@@ -2400,6 +2480,135 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkDoJSCGarbageCollection
     GCController::singleton().garbageCollectNow();
 }
 
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkStartSamplingProfiler
+  (JNIEnv*, jclass, jint intervalMicros)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    JSC::VM& vm = commonVM();
+    JSC::JSLockHolder lock(vm);
+    // Lets optimized code map its samples back to the functions inlined into it
+    vm.setShouldBuildPCToCodeOriginMapping();
+    Ref<Stopwatch> stopwatch = Stopwatch::create();
+    stopwatch->start();
+    JSC::SamplingProfiler& samplingProfiler = vm.ensureSamplingProfiler(WTFMove(stopwatch));
+
+    LockHolder locker(samplingProfiler.getLock());
+    samplingProfiler.setTimingInterval(std::chrono::microseconds(intervalMicros));
+    samplingProfiler.noticeCurrentThreadAsJSCExecutionThread(locker);
+    samplingProfiler.start(locker);
+    return JNI_TRUE;
+#else
+    UNUSED_PARAM(intervalMicros);
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkStopSamplingProfiler
+  (JNIEnv*, jclass)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    JSC::VM& vm = commonVM();
+    JSC::JSLockHolder lock(vm);
+    if (JSC::SamplingProfiler* samplingProfiler = vm.samplingProfiler()) {
+        LockHolder locker(samplingProfiler->getLock());
+        samplingProfiler->pause(locker);
+    }
+#endif
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkDrainSamplingProfile
+  (JNIEnv* env, jclass)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    JSC::VM& vm = commonVM();
+    JSC::JSLockHolder lock(vm);
+    if (JSC::SamplingProfiler* samplingProfiler = vm.samplingProfiler()) {
+        return samplingProfiler->stackTracesAsFoldedStacks().toJavaString(env).releaseLocal();
+    }
+#endif
+    return NULL;
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkWriteHeapSnapshot
+  (JNIEnv* env, jclass, jstring path)
+{
+    String filePath(env, path);
+#if OS(WINDOWS)
+    FILE* file = _wfopen(reinterpret_cast<const wchar_t*>(filePath.charactersWithNullTermination().data()), L"wb");
+#else
+    FILE* file = fopen(filePath.utf8().data(), "wb");
+#endif
+    if (!file) {
+        return JNI_FALSE;
+    }
+
+    JSC::VM& vm = commonVM();
+    bool succeeded;
+    {
+        JSC::JSLockHolder lock(vm);
+        JSC::HeapSnapshotBuilder snapshotBuilder(vm.ensureHeapProfiler());
+        succeeded = snapshotBuilder.writeSnapshot(file);
+    }
+    return !fclose(file) && succeeded;
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetResourceAccountingEnabled
+    (JNIEnv*, jobject, jlong pPage, jboolean enabled)
+{
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    if (jbool_to_bool(enabled) == !!page->resourceAccounting()) {
+        return;
+    }
+    if (enabled) {
+        page->setResourceAccounting(ResourceAccountingJava::create(*page));
+    } else {
+        page->setResourceAccounting(nullptr);
+    }
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_WebPage_twkGetResourceCounters
+    (JNIEnv* env, jobject, jlong pPage)
+{
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    ResourceAccountingJava* accounting = page->resourceAccounting();
+    if (!accounting) {
+        return nullptr;
+    }
+
+    const auto& counters = accounting->counters();
+    auto usage = accounting->measureMemoryUsage();
+    jlong values[com_sun_webkit_ResourceCounters_SIZE];
+    for (unsigned i = 0; i < ResourceAccountingJava::activityCount; ++i) {
+        values[com_sun_webkit_ResourceCounters_INDEX_TIME + i] = counters.time[i].count();
+        values[com_sun_webkit_ResourceCounters_INDEX_COUNT + i] = counters.count[i];
+    }
+    values[com_sun_webkit_ResourceCounters_INDEX_GC_TIME] = static_cast<jlong>(counters.garbageCollectionTime.microseconds());
+    values[com_sun_webkit_ResourceCounters_INDEX_EVICTIONS] = counters.evictionCount;
+    values[com_sun_webkit_ResourceCounters_INDEX_RESOURCE_BYTES] = usage.resourceBytes;
+    values[com_sun_webkit_ResourceCounters_INDEX_DECODED_IMAGE_BYTES] = usage.decodedImageBytes;
+    values[com_sun_webkit_ResourceCounters_INDEX_PAGE_CACHE_BYTES] = usage.pageCacheBytes;
+    values[com_sun_webkit_ResourceCounters_INDEX_PAGE_CACHE_PAGES] = usage.pageCachePages;
+
+    jlongArray jArray = env->NewLongArray(com_sun_webkit_ResourceCounters_SIZE);
+    env->SetLongArrayRegion(jArray, 0, com_sun_webkit_ResourceCounters_SIZE, values);
+    return jArray;
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkSetResourceSoftLimit
+    (JNIEnv*, jobject, jlong pPage, jlong bytes)
+{
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    ResourceAccountingJava* accounting = page->resourceAccounting();
+    if (!accounting) {
+        return JNI_FALSE;
+    }
+    accounting->setSoftLimit(static_cast<size_t>(bytes));
+    return JNI_TRUE;
+}
+
 #ifdef __cplusplus
 }
 #endif
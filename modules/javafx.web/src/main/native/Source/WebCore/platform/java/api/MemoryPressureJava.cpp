@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+
+#include "CommonVM.h"
+#include "FontCache.h"
+#include "FontCascade.h"
+#include "InlineStyleSheetOwner.h"
+#include "MemoryCache.h"
+#include "MemoryRelease.h"
+#include "PageCache.h"
+#include <heap/HeapInlines.h>
+#include <runtime/JSLock.h>
+#include <runtime/VM.h>
+#include <wtf/java/JavaEnv.h>
+#include <limits>
+
+#if ENABLE(JIT)
+#include <jit/ExecutableAllocator.h>
+#endif
+
+#include "com_sun_webkit_MemoryPressure.h"
+
+namespace WebCore {
+
+namespace {
+
+// Memory is given back in stages, from what is cheapest to recreate to
+// what is most expensive, until the tracked usage is within the budget.
+enum class ReliefStage { Caches, DecodedImages, Code };
+
+// The share of the budget given to the memory cache, and the share of
+// that for dead resources, as with the WebKit cache models.
+const unsigned memoryCacheBudgetDivisor = 4;
+const unsigned minDeadBudgetDivisor = 8;
+const unsigned maxDeadBudgetDivisor = 4;
+const unsigned defaultMemoryCacheCapacity = 8192 * 1024;
+
+size_t s_budget;
+
+size_t jitCodeSize()
+{
+#if ENABLE(JIT)
+    return JSC::ExecutableAllocator::committedByteCount();
+#else
+    return 0;
+#endif
+}
+
+size_t javaScriptHeapSize()
+{
+    JSC::VM& vm = commonVM();
+    JSC::JSLockHolder lock(vm);
+    return vm.heap.size();
+}
+
+// The memory that the budget is tracked against. Decoded image data is
+// part of the memory cache size.
+size_t trackedSize()
+{
+    return MemoryCache::singleton().size() + javaScriptHeapSize() + jitCodeSize();
+}
+
+bool isWithinBudget()
+{
+    return s_budget && trackedSize() <= s_budget;
+}
+
+void applyBudget()
+{
+    unsigned totalBytes = defaultMemoryCacheCapacity;
+    unsigned minDeadBytes = 0;
+    unsigned maxDeadBytes = defaultMemoryCacheCapacity;
+    if (s_budget) {
+        totalBytes = static_cast<unsigned>(std::min<size_t>(s_budget / memoryCacheBudgetDivisor, std::numeric_limits<unsigned>::max()));
+        minDeadBytes = totalBytes / minDeadBudgetDivisor;
+        maxDeadBytes = totalBytes / maxDeadBudgetDivisor;
+    }
+    MemoryCache::singleton().setCapacities(minDeadBytes, maxDeadBytes, totalBytes);
+}
+
+void relieve(ReliefStage stage)
+{
+    switch (stage) {
+    case ReliefStage::Caches:
+        MemoryCache::singleton().pruneDeadResourcesToSize(0);
+        PageCache::singleton().pruneToSizeNow(0, PruningReason::MemoryPressure);
+        FontCache::singleton().purgeInactiveFontData();
+        clearWidthCaches();
+        InlineStyleSheetOwner::clearCache();
+        break;
+    case ReliefStage::DecodedImages:
+        MemoryCache::singleton().destroyDecodedDataForAllImages();
+        MemoryCache::singleton().pruneLiveResourcesToSize(0, /*shouldDestroyDecodedDataForAllLiveResources*/ true);
+        break;
+    case ReliefStage::Code:
+        // Collects garbage and discards the JIT code along with everything
+        // the earlier stages release.
+        releaseMemory(Critical::Yes, Synchronous::Yes);
+        break;
+    }
+}
+
+// Runs the stages up to lastStage, stopping early once the tracked usage
+// is within the budget unless the whole way is forced.
+void relieveUpTo(ReliefStage lastStage, bool force)
+{
+    for (auto stage : { ReliefStage::Caches, ReliefStage::DecodedImages, ReliefStage::Code }) {
+        if (stage > lastStage || (!force && isWithinBudget()))
+            return;
+        relieve(stage);
+    }
+}
+
+// Used without reported pressure, after page loads and when the pressure
+// is over. It stops short of collecting garbage and discarding the JIT
+// code, which a budget that can not be met would otherwise repeat each time.
+void checkBudget()
+{
+    if (s_budget)
+        relieveUpTo(ReliefStage::DecodedImages, false);
+}
+
+void handlePressure(jint level)
+{
+    MemoryPressureHandler::singleton().setUnderMemoryPressure(level != com_sun_webkit_MemoryPressure_LEVEL_NONE);
+    switch (level) {
+    case com_sun_webkit_MemoryPressure_LEVEL_NONE:
+        checkBudget();
+        break;
+    case com_sun_webkit_MemoryPressure_LEVEL_MODERATE:
+        relieveUpTo(ReliefStage::DecodedImages, !s_budget);
+        break;
+    case com_sun_webkit_MemoryPressure_LEVEL_CRITICAL:
+        relieveUpTo(ReliefStage::Code, true);
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+} // namespace
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryPressure_twkSetLevel
+  (JNIEnv*, jclass, jint level)
+{
+    handlePressure(level);
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_MemoryPressure_twkGetBudget
+  (JNIEnv*, jclass)
+{
+    return static_cast<jlong>(s_budget);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryPressure_twkSetBudget
+  (JNIEnv*, jclass, jlong budget)
+{
+    ASSERT(budget >= 0);
+    s_budget = static_cast<size_t>(budget);
+    applyBudget();
+    if (s_budget)
+        relieveUpTo(ReliefStage::Code, false);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryPressure_twkCheckBudget
+  (JNIEnv*, jclass)
+{
+    checkBudget();
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_MemoryPressure_twkGetUsage
+  (JNIEnv* env, jclass)
+{
+    auto statistics = MemoryCache::singleton().getStatistics();
+
+    jlong usage[com_sun_webkit_MemoryPressure_USAGE_COUNT];
+    usage[com_sun_webkit_MemoryPressure_USAGE_MEMORY_CACHE] = MemoryCache::singleton().size();
+    usage[com_sun_webkit_MemoryPressure_USAGE_DECODED_IMAGES] = statistics.images.decodedSize;
+    usage[com_sun_webkit_MemoryPressure_USAGE_JAVASCRIPT_HEAP] = javaScriptHeapSize();
+    usage[com_sun_webkit_MemoryPressure_USAGE_JIT_CODE] = jitCodeSize();
+    usage[com_sun_webkit_MemoryPressure_USAGE_PAGE_CACHE_PAGES] = PageCache::singleton().pageCount();
+    usage[com_sun_webkit_MemoryPressure_USAGE_FONT_CACHE_FONTS] = FontCache::singleton().fontCount();
+
+    jlongArray jArray = env->NewLongArray(com_sun_webkit_MemoryPressure_USAGE_COUNT);
+    env->SetLongArrayRegion(jArray, 0, com_sun_webkit_MemoryPressure_USAGE_COUNT, usage);
+    return jArray;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+
+#include <wtf/SystemTracing.h>
+#include <wtf/Vector.h>
+#include <wtf/java/JavaEnv.h>
+#include <wtf/java/TraceBufferJava.h>
+
+#include "com_sun_webkit_Tracing.h"
+
+namespace WebCore {
+
+namespace {
+
+struct TracePointDescription {
+    const char* name;
+    jchar phase;
+};
+
+// The trace points that are recorded in the Java port. The begin and end
+// points of an interval share the name.
+TracePointDescription describe(jint code)
+{
+    switch (code) {
+    case VMEntryScopeStart:
+        return { "JavaScript", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case VMEntryScopeEnd:
+        return { "JavaScript", com_sun_webkit_Tracing_PHASE_END };
+    case StyleRecalcStart:
+        return { "StyleRecalc", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case StyleRecalcEnd:
+        return { "StyleRecalc", com_sun_webkit_Tracing_PHASE_END };
+    case LayoutStart:
+        return { "Layout", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case LayoutEnd:
+        return { "Layout", com_sun_webkit_Tracing_PHASE_END };
+    case PaintViewStart:
+        return { "PaintView", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case PaintViewEnd:
+        return { "PaintView", com_sun_webkit_Tracing_PHASE_END };
+    case RAFCallbackStart:
+        return { "AnimationFrameCallbacks", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case RAFCallbackEnd:
+        return { "AnimationFrameCallbacks", com_sun_webkit_Tracing_PHASE_END };
+    case ImageDecodeStart:
+        return { "ImageDecode", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case ImageDecodeEnd:
+        return { "ImageDecode", com_sun_webkit_Tracing_PHASE_END };
+    case RenderingQueueFlush:
+        return { "RenderingQueueFlush", com_sun_webkit_Tracing_PHASE_COUNTER };
+    case WebPagePrePaintStart:
+        return { "PrePaint", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case WebPagePrePaintEnd:
+        return { "PrePaint", com_sun_webkit_Tracing_PHASE_END };
+    case WebPagePaintStart:
+        return { "Paint", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case WebPagePaintEnd:
+        return { "Paint", com_sun_webkit_Tracing_PHASE_END };
+    case WebPagePostPaintStart:
+        return { "PostPaint", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case WebPagePostPaintEnd:
+        return { "PostPaint", com_sun_webkit_Tracing_PHASE_END };
+    case WebPageSyncLayersStart:
+        return { "SyncLayers", com_sun_webkit_Tracing_PHASE_BEGIN };
+    case WebPageSyncLayersEnd:
+        return { "SyncLayers", com_sun_webkit_Tracing_PHASE_END };
+    default:
+        return { nullptr, com_sun_webkit_Tracing_PHASE_INSTANT };
+    }
+}
+
+// Records are drained in chunks, so that draining a mostly empty buffer
+// does not take a buffer sized copy.
+const size_t drainChunkSize = 1024;
+
+} // namespace
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_Tracing_twkSetEnabled
+  (JNIEnv*, jclass, jboolean enabled)
+{
+    TraceBufferJava::setEnabled(enabled);
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_Tracing_twkDrain
+  (JNIEnv* env, jclass)
+{
+    Vector<jlong> records;
+    TraceBufferJava::Record chunk[drainChunkSize];
+    size_t count;
+    do {
+        count = TraceBufferJava::drain(chunk, drainChunkSize);
+        for (size_t i = 0; i < count; ++i) {
+            jlong record[com_sun_webkit_Tracing_RECORD_SIZE];
+            record[com_sun_webkit_Tracing_RECORD_TIMESTAMP] = static_cast<jlong>(chunk[i].timestamp);
+            record[com_sun_webkit_Tracing_RECORD_CODE] = chunk[i].code;
+            record[com_sun_webkit_Tracing_RECORD_THREAD] = chunk[i].thread;
+            record[com_sun_webkit_Tracing_RECORD_DATA] = static_cast<jlong>(chunk[i].data);
+            records.append(record, com_sun_webkit_Tracing_RECORD_SIZE);
+        }
+    } while (count == drainChunkSize);
+
+    jlongArray jArray = env->NewLongArray(records.size());
+    env->SetLongArrayRegion(jArray, 0, records.size(), records.data());
+    return jArray;
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_Tracing_twkTakeDroppedCount
+  (JNIEnv*, jclass)
+{
+    return static_cast<jlong>(TraceBufferJava::takeDroppedCount());
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_Tracing_twkGetName
+  (JNIEnv* env, jclass, jint code)
+{
+    const char* name = describe(code).name;
+    return name ? env->NewStringUTF(name) : nullptr;
+}
+
+JNIEXPORT jchar JNICALL Java_com_sun_webkit_Tracing_twkGetPhase
+  (JNIEnv*, jclass, jint code)
+{
+    return describe(code).phase;
+}
+
+#ifdef __cplusplus
+}
+#endif
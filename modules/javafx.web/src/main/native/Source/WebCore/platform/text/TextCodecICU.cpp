@@ -36,7 +36,7 @@
 #include <wtf/StringExtras.h>
 #include <wtf/Threading.h>
 #include <wtf/text/CString.h>
-#include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringBuffer.h>
 #include <wtf/unicode/CharacterNames.h>
 
 namespace WebCore {
@@ -358,29 +358,47 @@ String TextCodecICU::decode(const char* bytes, size_t length, bool flush, bool s
 
     ErrorCallbackSetter callbackSetter(m_converterICU, stopOnError);
 
-    StringBuilder result;
+    if (length > std::numeric_limits<unsigned>::max() / 2)
+        CRASH();
+
+    // Decode straight into the string's storage. The encodings handled here
+    // produce at most one UTF-16 code unit per input byte, plus whatever the
+    // converter held back from the previous chunk, so a single pass normally
+    // fills the buffer without an intermediate copy.
+    UErrorCode err = U_ZERO_ERROR;
+    int32_t pending = ucnv_toUCountPending(m_converterICU, &err);
+    StringBuffer<UChar> result(length + std::max(pending, 0) + 1);
+    unsigned decoded = 0;
 
-    UChar buffer[ConversionBufferSize];
-    UChar* bufferLimit = buffer + ConversionBufferSize;
     const char* source = reinterpret_cast<const char*>(bytes);
     const char* sourceLimit = source + length;
     int32_t* offsets = NULL;
-    UErrorCode err = U_ZERO_ERROR;
+    err = U_ZERO_ERROR;
 
     do {
-        int ucharsDecoded = decodeToBuffer(buffer, bufferLimit, source, sourceLimit, offsets, flush, err);
-        result.append(buffer, ucharsDecoded);
+        if (err == U_BUFFER_OVERFLOW_ERROR)
+            result.resize(result.length() * 2);
+        decoded += decodeToBuffer(result.characters() + decoded, result.characters() + result.length(), source, sourceLimit, offsets, flush, err);
     } while (err == U_BUFFER_OVERFLOW_ERROR);
 
     if (U_FAILURE(err)) {
         // flush the converter so it can be reused, and not be bothered by this error.
+        UChar buffer[ConversionBufferSize];
+        UChar* bufferLimit = buffer + ConversionBufferSize;
         do {
             decodeToBuffer(buffer, bufferLimit, source, sourceLimit, offsets, true, err);
         } while (source < sourceLimit);
         sawError = true;
     }
 
-    String resultString = result.toString();
+    String resultString;
+    if (decoded < result.length() / 2) {
+        // Multi-byte encodings leave most of the buffer unused; don't keep it alive.
+        resultString = String(result.characters(), decoded);
+    } else {
+        result.shrink(decoded);
+        resultString = String::adopt(WTFMove(result));
+    }
 
     // <http://bugs.webkit.org/show_bug.cgi?id=17014>
     // Simplified Chinese pages use the code A3A0 to mean "full-width space", but ICU decodes it as U+E5E5.
@@ -60,6 +60,12 @@ SharingResolver::SharingResolver(const Document& document, const DocumentRuleSet
 {
 }
 
+static inline SharingResolver::CandidateKey candidateKey(const StyledElement& element, const Element& parentElement)
+{
+    auto* className = element.hasClass() ? element.attributeWithoutSynchronization(HTMLNames::classAttr).impl() : nullptr;
+    return { &parentElement, { element.tagQName().localName().impl(), className } };
+}
+
 static inline bool parentElementPreventsSharing(const Element& parentElement)
 {
     return parentElement.hasFlagsSetDuringStylingOfChildren();
@@ -110,7 +116,7 @@ std::unique_ptr<RenderStyle> SharingResolver::resolve(const Element& searchEleme
 
     // Check previous siblings and their cousins.
     unsigned count = 0;
-    StyledElement* shareElement = nullptr;
+    const StyledElement* shareElement = nullptr;
     Node* cousinList = element.previousSibling();
     while (cousinList) {
         shareElement = findSibling(context, cousinList, count);
@@ -121,6 +127,11 @@ std::unique_ptr<RenderStyle> SharingResolver::resolve(const Element& searchEleme
         cousinList = locateCousinList(cousinList->parentElement());
     }
 
+    auto key = candidateKey(element, parentElement);
+    if (!shareElement)
+        shareElement = findCousinWithSameKey(context, key);
+    m_candidates.set(key, &element);
+
     // If we have exhausted all our budget or our cousins.
     if (!shareElement)
         return nullptr;
@@ -169,6 +180,26 @@ Node* SharingResolver::locateCousinList(const Element* parent) const
     return nullptr;
 }
 
+const StyledElement* SharingResolver::findCousinWithSameKey(const Context& context, const CandidateKey& key) const
+{
+    // Rows of a data grid often have more cells than the search budget, with
+    // a class per column. Look up the cell of the same kind under each parent
+    // that locateCousinList() would visit instead of walking back to it.
+    const Element* parent = key.first;
+    for (unsigned count = 0; count < cStyleSearchThreshold; ++count) {
+        auto* elementSharingParentStyle = m_elementsSharingStyle.get(parent);
+        if (!elementSharingParentStyle)
+            return nullptr;
+        if (!parentElementPreventsSharing(*elementSharingParentStyle)) {
+            auto* candidate = m_candidates.get({ elementSharingParentStyle, key.second });
+            if (candidate && canShareStyleWithElement(context, *candidate))
+                return candidate;
+        }
+        parent = elementSharingParentStyle;
+    }
+    return nullptr;
+}
+
 static bool canShareStyleWithControl(const HTMLFormControlElement& element, const HTMLFormControlElement& formElement)
 {
     if (!is<HTMLInputElement>(formElement) || !is<HTMLInputElement>(element))
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <wtf/HashMap.h>
+#include <wtf/text/AtomicStringImpl.h>
 
 namespace WebCore {
 
@@ -49,11 +50,15 @@ public:
 
     std::unique_ptr<RenderStyle> resolve(const Element&, const Update&);
 
+    // Parent element, local name and class attribute of a sharing candidate.
+    using CandidateKey = std::pair<const Element*, std::pair<AtomicStringImpl*, AtomicStringImpl*>>;
+
 private:
     struct Context;
 
     StyledElement* findSibling(const Context&, Node*, unsigned& count) const;
     Node* locateCousinList(const Element* parent) const;
+    const StyledElement* findCousinWithSameKey(const Context&, const CandidateKey&) const;
     bool canShareStyleWithElement(const Context&, const StyledElement& candidateElement) const;
     bool styleSharingCandidateMatchesRuleSet(const StyledElement&, const RuleSet*) const;
     bool sharingCandidateHasIdenticalStyleAffectingAttributes(const Context&, const StyledElement& sharingCandidate) const;
@@ -64,6 +69,7 @@ private:
     const SelectorFilter& m_selectorFilter;
 
     HashMap<const Element*, const Element*> m_elementsSharingStyle;
+    HashMap<CandidateKey, const StyledElement*> m_candidates;
 };
 
 }
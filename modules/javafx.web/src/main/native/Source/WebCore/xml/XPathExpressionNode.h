@@ -54,6 +54,11 @@ public:
     bool isContextPositionSensitive() const { return m_isContextPositionSensitive; }
     bool isContextSizeSensitive() const { return m_isContextSizeSensitive; }
 
+    // Let Step recognize "[@id = 'literal']" predicates and look elements up by id.
+    virtual bool isIdAttributeReference() const { return false; }
+    virtual String stringLiteral() const { return String(); }
+    virtual AtomicString idTestValue() const { return nullAtom; }
+
 protected:
     Expression();
 
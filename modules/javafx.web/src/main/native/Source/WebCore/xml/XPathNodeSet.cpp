@@ -145,6 +145,11 @@ void NodeSet::sort() const
         return;
     }
 
+    // Steps along reverse axes produce nodes in reverse document order, and predicates keep
+    // nodes in order, so check for an ordered set before doing the full sort.
+    if (sortIfMonotonic())
+        return;
+
     if (nodeCount > traversalSortCutoff) {
         traversalSort();
         return;
@@ -177,6 +182,24 @@ void NodeSet::sort() const
     m_isSorted = true;
 }
 
+bool NodeSet::sortIfMonotonic() const
+{
+    const unsigned short direction = m_nodes[0]->compareDocumentPosition(*m_nodes[1]) & (Node::DOCUMENT_POSITION_DISCONNECTED | Node::DOCUMENT_POSITION_FOLLOWING | Node::DOCUMENT_POSITION_PRECEDING);
+    if (direction != Node::DOCUMENT_POSITION_FOLLOWING && direction != Node::DOCUMENT_POSITION_PRECEDING)
+        return false;
+
+    unsigned nodeCount = m_nodes.size();
+    for (unsigned i = 2; i < nodeCount; ++i) {
+        if ((m_nodes[i - 1]->compareDocumentPosition(*m_nodes[i]) & (Node::DOCUMENT_POSITION_DISCONNECTED | direction)) != direction)
+            return false;
+    }
+
+    if (direction == Node::DOCUMENT_POSITION_PRECEDING)
+        m_nodes.reverse();
+    m_isSorted = true;
+    return true;
+}
+
 static Node* findRootNode(Node* node)
 {
     if (is<Attr>(*node))
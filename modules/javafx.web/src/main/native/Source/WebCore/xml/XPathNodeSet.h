@@ -69,6 +69,8 @@ namespace WebCore {
 
         private:
             void traversalSort() const;
+            // Sorts the set if it is in document order or in reverse document order, otherwise returns false.
+            bool sortIfMonotonic() const;
 
             mutable bool m_isSorted;
             bool m_subtreesAreDisjoint;
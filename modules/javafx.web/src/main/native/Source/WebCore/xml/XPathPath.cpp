@@ -136,6 +136,11 @@ void LocationPath::evaluate(NodeSet& nodes) const
     nodes.markSorted(resultIsSorted);
 }
 
+bool LocationPath::isIdAttributeReference() const
+{
+    return !m_isAbsolute && m_steps.size() == 1 && m_steps[0]->isIdAttributeTest();
+}
+
 void LocationPath::appendStep(std::unique_ptr<Step> step)
 {
     unsigned stepCount = m_steps.size();
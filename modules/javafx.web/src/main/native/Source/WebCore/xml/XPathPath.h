@@ -56,6 +56,8 @@ namespace WebCore {
             void appendStep(std::unique_ptr<Step>);
             void prependStep(std::unique_ptr<Step>);
 
+            bool isIdAttributeReference() const override;
+
         private:
             Value evaluate() const override;
             Value::Type resultType() const override { return Value::NodeSetValue; }
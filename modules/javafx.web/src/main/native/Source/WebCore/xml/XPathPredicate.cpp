@@ -102,6 +102,21 @@ EqTestOp::EqTestOp(Opcode opcode, std::unique_ptr<Expression> lhs, std::unique_p
     addSubexpression(WTFMove(rhs));
 }
 
+AtomicString EqTestOp::idTestValue() const
+{
+    if (m_opcode != OP_EQ)
+        return nullAtom;
+    for (unsigned i = 0; i < 2; ++i) {
+        if (!subexpression(i).isIdAttributeReference())
+            continue;
+        String literal = subexpression(1 - i).stringLiteral();
+        // The id map has no entry for elements with an empty id.
+        if (!literal.isEmpty())
+            return AtomicString(literal);
+    }
+    return nullAtom;
+}
+
 bool EqTestOp::compare(const Value& lhs, const Value& rhs) const
 {
     if (lhs.isNodeSet()) {
@@ -46,6 +46,8 @@ namespace WebCore {
         public:
             explicit StringExpression(String&&);
 
+            String stringLiteral() const override { return m_value.toString(); }
+
         private:
             Value evaluate() const override;
             Value::Type resultType() const override { return Value::StringValue; }
@@ -80,6 +82,8 @@ namespace WebCore {
             EqTestOp(Opcode, std::unique_ptr<Expression> lhs, std::unique_ptr<Expression> rhs);
             Value evaluate() const override;
 
+            AtomicString idTestValue() const override;
+
         private:
             Value::Type resultType() const override { return Value::BooleanValue; }
             bool compare(const Value&, const Value&) const;
@@ -32,6 +32,7 @@
 #include "Document.h"
 #include "HTMLDocument.h"
 #include "HTMLElement.h"
+#include "HTMLNames.h"
 #include "NodeTraversal.h"
 #include "XMLNSNames.h"
 #include "XPathParser.h"
@@ -70,6 +71,25 @@ void Step::optimize()
             remainingPredicates.append(WTFMove(predicate));
     }
     m_predicates = WTFMove(remainingPredicates);
+
+    // Elements with the id in "//foo[@id = 'bar']" can be taken from the id map, as long as
+    // skipping the other elements cannot change the position seen by a merged predicate.
+    m_indexedId = nullAtom;
+    if ((m_axis == DescendantAxis || m_axis == DescendantOrSelfAxis) && !m_nodeTest.m_mergedPredicates.isEmpty()
+        && !predicateIsContextPositionSensitive(*m_nodeTest.m_mergedPredicates[0])) {
+        for (auto& predicate : m_nodeTest.m_mergedPredicates) {
+            m_indexedId = predicate->idTestValue();
+            if (!m_indexedId.isNull())
+                break;
+        }
+    }
+}
+
+bool Step::isIdAttributeTest() const
+{
+    return m_axis == AttributeAxis && m_nodeTest.m_kind == NodeTest::NameTest
+        && m_nodeTest.m_data == HTMLNames::idAttr.localName() && m_nodeTest.m_namespaceURI.isEmpty()
+        && m_predicates.isEmpty() && m_nodeTest.m_mergedPredicates.isEmpty();
 }
 
 void optimizeStepPair(Step& first, Step& second, bool& dropSecondStep)
@@ -236,6 +256,49 @@ inline bool nodeMatches(Node& node, Step::Axis axis, const Step::NodeTest& nodeT
     return true;
 }
 
+// Appends the descendants of the context that match, in document order, from the id map or
+// the tag name index instead of walking the subtree. Returns false if neither can be used.
+bool Step::descendantsFromIndex(Node& context, NodeSet& nodes) const
+{
+    if (!context.isConnected())
+        return false;
+
+    const Vector<Element*>* elements = nullptr;
+    if (!m_indexedId.isNull()) {
+        elements = context.treeScope().getAllElementsById(m_indexedId);
+        if (!elements)
+            return true;
+    } else {
+        // HTML documents match names case-insensitively, see nodeMatchesBasicTest().
+        if (m_nodeTest.m_kind != NodeTest::NameTest || m_nodeTest.m_data == starAtom || is<HTMLDocument>(context.document()))
+            return false;
+        if (&context.treeScope() != &context.document())
+            return false;
+        elements = TagIndex::elementsWithLocalName(context.document(), m_nodeTest.m_data);
+        if (!elements)
+            return false;
+    }
+
+    // The descendants of the context are contiguous in document order.
+    auto* begin = elements->begin();
+    auto* end = elements->end();
+    if (!context.isDocumentNode()) {
+        begin = std::lower_bound(begin, end, &context, [](Element* element, Node* context) {
+            return element->compareDocumentPosition(*context) & Node::DOCUMENT_POSITION_FOLLOWING;
+        });
+    }
+    for (auto* it = begin; it != end; ++it) {
+        Element& element = **it;
+        if (&element == &context)
+            continue;
+        if (!context.contains(&element))
+            break;
+        if (nodeMatches(element, m_axis, m_nodeTest))
+            nodes.append(&element);
+    }
+    return true;
+}
+
 // Result nodes are ordered in axis order. Node test (including merged predicates) is applied.
 void Step::nodesInAxis(Node& context, NodeSet& nodes) const
 {
@@ -252,6 +315,8 @@ void Step::nodesInAxis(Node& context, NodeSet& nodes) const
         case DescendantAxis:
             if (context.isAttributeNode()) // In XPath model, attribute nodes do not have children.
                 return;
+            if (descendantsFromIndex(context, nodes))
+                return;
             for (Node* node = context.firstChild(); node; node = NodeTraversal::next(*node, &context)) {
                 if (nodeMatches(*node, DescendantAxis, m_nodeTest))
                     nodes.append(node);
@@ -373,6 +438,8 @@ void Step::nodesInAxis(Node& context, NodeSet& nodes) const
                 nodes.append(&context);
             if (context.isAttributeNode()) // In XPath model, attribute nodes do not have children.
                 return;
+            if (descendantsFromIndex(context, nodes))
+                return;
             for (Node* node = context.firstChild(); node; node = NodeTraversal::next(*node, &context)) {
                 if (nodeMatches(*node, DescendantOrSelfAxis, m_nodeTest))
                     nodes.append(node);
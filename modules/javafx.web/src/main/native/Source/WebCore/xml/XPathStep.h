@@ -101,6 +101,9 @@ public:
 
     Axis axis() const { return m_axis; }
 
+    // Whether this is the "@id" step of an id test.
+    bool isIdAttributeTest() const;
+
 private:
     friend void optimizeStepPair(Step&, Step&, bool&);
 
@@ -108,10 +111,14 @@ private:
 
     void parseNodeTest(const String&);
     void nodesInAxis(Node& context, NodeSet&) const;
+    bool descendantsFromIndex(Node& context, NodeSet&) const;
 
     Axis m_axis;
     NodeTest m_nodeTest;
     Vector<std::unique_ptr<Expression>> m_predicates;
+
+    // The id compared with by a merged predicate of a descendant step.
+    AtomicString m_indexedId;
 };
 
 void optimizeStepPair(Step&, Step&, bool& dropSecondStep);
@@ -28,7 +28,10 @@
 #include "XPathUtil.h"
 
 #include "ContainerNode.h"
+#include "Document.h"
+#include "TypedElementDescendantIterator.h"
 #include "TextNodeTraversal.h"
+#include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
 namespace XPath {
@@ -76,5 +79,27 @@ bool isValidContextNode(Node* node)
     return false;
 }
 
+const Vector<Element*>* TagIndex::elementsWithLocalName(Document& document, const AtomicString& localName)
+{
+    TagIndex& index = document.xpathTagIndex();
+    uint64_t treeVersion = document.domTreeVersion();
+    if (index.m_treeVersion != treeVersion) {
+        index.m_elements.clear();
+        index.m_isBuilt = false;
+        index.m_treeVersion = treeVersion;
+        return nullptr;
+    }
+
+    if (!index.m_isBuilt) {
+        for (auto& element : descendantsOfType<Element>(document))
+            index.m_elements.add(element.localName().impl(), Vector<Element*>()).iterator->value.append(&element);
+        index.m_isBuilt = true;
+    }
+
+    static NeverDestroyed<Vector<Element*>> noElements;
+    auto it = index.m_elements.find(localName.impl());
+    return it == index.m_elements.end() ? &noElements.get() : &it->value;
+}
+
 }
 }
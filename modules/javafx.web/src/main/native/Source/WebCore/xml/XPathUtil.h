@@ -26,10 +26,14 @@
 
 #pragma once
 
-#include <wtf/Forward.h>
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
 
 namespace WebCore {
 
+    class Document;
+    class Element;
     class Node;
 
     namespace XPath {
@@ -43,6 +47,22 @@ namespace WebCore {
         /* @return whether the given node is a valid context node */
         bool isValidContextNode(Node*);
 
+        // The elements of a document by local name, in document order, for descendant
+        // name tests. Built on the second query at a DOM tree version, so that documents
+        // changed between queries keep walking the tree. Document::incDOMTreeVersion()
+        // drops it, so it never holds elements that were removed from the tree.
+        class TagIndex {
+            WTF_MAKE_FAST_ALLOCATED;
+        public:
+            // Returns nullptr when the caller should walk the tree instead.
+            static const Vector<Element*>* elementsWithLocalName(Document&, const AtomicString&);
+
+        private:
+            uint64_t m_treeVersion { 0 };
+            bool m_isBuilt { false };
+            HashMap<AtomicStringImpl*, Vector<Element*>> m_elements;
+        };
+
     } // namespace XPath
 
 } // namespace WebCore
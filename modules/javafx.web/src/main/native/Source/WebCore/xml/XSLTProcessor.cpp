@@ -61,6 +61,8 @@ static inline void transformTextStringToXHTMLDocumentString(String& text)
 
 XSLTProcessor::~XSLTProcessor()
 {
+    clearCompiledStylesheet();
+
     // Stylesheet shouldn't outlive its root node.
     ASSERT(!m_stylesheetRootNode || !m_stylesheet || m_stylesheet->hasOneRef());
 }
@@ -170,6 +172,7 @@ void XSLTProcessor::removeParameter(const String& /*namespaceURI*/, const String
 
 void XSLTProcessor::reset()
 {
+    clearCompiledStylesheet();
     m_stylesheet = nullptr;
     m_stylesheetRootNode = nullptr;
     m_parameters.clear();
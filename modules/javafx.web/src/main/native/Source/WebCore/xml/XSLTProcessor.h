@@ -49,8 +49,10 @@ public:
     // DOM methods
     void importStylesheet(RefPtr<Node>&& style)
     {
-        if (style)
+        if (style) {
+            clearCompiledStylesheet();
             m_stylesheetRootNode = WTFMove(style);
+        }
     }
     RefPtr<DocumentFragment> transformToFragment(Node* source, Document* ouputDoc);
     RefPtr<Document> transformToDocument(Node* source);
@@ -73,9 +75,18 @@ public:
 private:
     XSLTProcessor() { }
 
+    xsltStylesheetPtr compiledStylesheet();
+    void clearCompiledStylesheet();
+
     RefPtr<XSLStyleSheet> m_stylesheet;
     RefPtr<Node> m_stylesheetRootNode;
     ParameterMap m_parameters;
+
+    // The imported stylesheet compiled by libxslt, reused by transforms until
+    // the markup of m_stylesheetRootNode changes.
+    xsltStylesheetPtr m_compiledStylesheet { nullptr };
+    String m_compiledStylesheetMarkup;
+    uint64_t m_compiledStylesheetTreeVersion { 0 };
 };
 
 } // namespace WebCore
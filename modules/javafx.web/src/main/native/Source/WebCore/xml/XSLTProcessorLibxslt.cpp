@@ -45,8 +45,6 @@
 #include <libxslt/variables.h>
 #include <libxslt/xsltutils.h>
 #include <wtf/Assertions.h>
-#include <wtf/text/StringBuffer.h>
-#include <wtf/unicode/UTF8.h>
 
 #if OS(DARWIN) && !PLATFORM(GTK) && !PLATFORM(JAVA)
 #include "SoftLinking.h"
@@ -170,27 +168,10 @@ static inline void setXSLTLoadCallBack(xsltDocLoaderFunc func, XSLTProcessor* pr
     globalCachedResourceLoader = cachedResourceLoader;
 }
 
-static int writeToStringBuilder(void* context, const char* buffer, int len)
+static int writeToVector(void* context, const char* buffer, int len)
 {
-    StringBuilder& resultOutput = *static_cast<StringBuilder*>(context);
-
-    if (!len)
-        return 0;
-
-    StringBuffer<UChar> stringBuffer(len);
-    UChar* bufferUChar = stringBuffer.characters();
-    UChar* bufferUCharEnd = bufferUChar + len;
-
-    const char* stringCurrent = buffer;
-    WTF::Unicode::ConversionResult result = WTF::Unicode::convertUTF8ToUTF16(&stringCurrent, buffer + len, &bufferUChar, bufferUCharEnd);
-    if (result != WTF::Unicode::conversionOK && result != WTF::Unicode::sourceExhausted) {
-        ASSERT_NOT_REACHED();
-        return -1;
-    }
-
-    int utf16Length = bufferUChar - stringBuffer.characters();
-    resultOutput.append(stringBuffer.characters(), utf16Length);
-    return stringCurrent - buffer;
+    static_cast<Vector<char>*>(context)->append(buffer, len);
+    return len;
 }
 
 static bool saveResultToString(xmlDocPtr resultDoc, xsltStylesheetPtr sheet, String& resultString)
@@ -199,9 +180,11 @@ static bool saveResultToString(xmlDocPtr resultDoc, xsltStylesheetPtr sheet, Str
     if (!outputBuf)
         return false;
 
-    StringBuilder resultBuilder;
-    outputBuf->context = &resultBuilder;
-    outputBuf->writecallback = writeToStringBuilder;
+    // Without an encoder the output is UTF-8, which is converted once at the
+    // end rather than chunk by chunk. All-ASCII results stay 8-bit.
+    Vector<char> resultBytes;
+    outputBuf->context = &resultBytes;
+    outputBuf->writecallback = writeToVector;
 
     int retval = xsltSaveResultTo(outputBuf, resultDoc, sheet);
     xmlOutputBufferClose(outputBuf);
@@ -209,10 +192,18 @@ static bool saveResultToString(xmlDocPtr resultDoc, xsltStylesheetPtr sheet, Str
         return false;
 
     // Workaround for <http://bugzilla.gnome.org/show_bug.cgi?id=495668>: libxslt appends an extra line feed to the result.
-    if (resultBuilder.length() > 0 && resultBuilder[resultBuilder.length() - 1] == '\n')
-        resultBuilder.resize(resultBuilder.length() - 1);
+    if (!resultBytes.isEmpty() && resultBytes.last() == '\n')
+        resultBytes.removeLast();
 
-    resultString = resultBuilder.toString();
+    if (resultBytes.isEmpty()) {
+        resultString = emptyString();
+        return true;
+    }
+    resultString = String::fromUTF8(resultBytes.data(), resultBytes.size());
+    if (resultString.isNull()) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
 
     return true;
 }
@@ -247,7 +238,7 @@ static void freeXsltParamArray(const char** params)
     fastFree(params);
 }
 
-static xsltStylesheetPtr xsltStylesheetPointer(RefPtr<XSLStyleSheet>& cachedStylesheet, Node* stylesheetRootNode)
+static xsltStylesheetPtr xsltStylesheetPointer(RefPtr<XSLStyleSheet>& cachedStylesheet, Node* stylesheetRootNode, const String& markup)
 {
     if (!cachedStylesheet && stylesheetRootNode) {
         cachedStylesheet = XSLStyleSheet::createForXSLTProcessor(stylesheetRootNode->parentNode() ? stylesheetRootNode->parentNode() : stylesheetRootNode,
@@ -256,7 +247,7 @@ static xsltStylesheetPtr xsltStylesheetPointer(RefPtr<XSLStyleSheet>& cachedStyl
 
         // According to Mozilla documentation, the node must be a Document node, an xsl:stylesheet or xsl:transform element.
         // But we just use text content regardless of node type.
-        cachedStylesheet->parseString(createMarkup(*stylesheetRootNode));
+        cachedStylesheet->parseString(markup);
     }
 
     if (!cachedStylesheet || !cachedStylesheet->document())
@@ -265,6 +256,53 @@ static xsltStylesheetPtr xsltStylesheetPointer(RefPtr<XSLStyleSheet>& cachedStyl
     return cachedStylesheet->compileStyleSheet();
 }
 
+xsltStylesheetPtr XSLTProcessor::compiledStylesheet()
+{
+    // Stylesheets from processing instructions are compiled for a single transform.
+    if (!m_stylesheetRootNode) {
+        xsltStylesheetPtr sheet = xsltStylesheetPointer(m_stylesheet, nullptr, String());
+        if (sheet)
+            m_stylesheet->clearDocuments();
+        return sheet;
+    }
+
+    // Any change to the document bumps its tree version. Only serialize the
+    // stylesheet again when it moves, and only recompile when its markup differs.
+    uint64_t treeVersion = m_stylesheetRootNode->document().domTreeVersion();
+    if (m_compiledStylesheet && treeVersion == m_compiledStylesheetTreeVersion)
+        return m_compiledStylesheet;
+    String markup = createMarkup(*m_stylesheetRootNode);
+    if (m_compiledStylesheet && markup == m_compiledStylesheetMarkup) {
+        m_compiledStylesheetTreeVersion = treeVersion;
+        return m_compiledStylesheet;
+    }
+
+    clearCompiledStylesheet();
+    xsltStylesheetPtr sheet = xsltStylesheetPointer(m_stylesheet, m_stylesheetRootNode.get(), markup);
+    if (!sheet)
+        return nullptr;
+    // A sheet compiled while imports were still loading lacks them, so it
+    // is not kept.
+    if (!m_stylesheet->isLoading()) {
+        m_compiledStylesheet = sheet;
+        m_compiledStylesheetMarkup = markup;
+        m_compiledStylesheetTreeVersion = treeVersion;
+    }
+    m_stylesheet->clearDocuments();
+    return sheet;
+}
+
+void XSLTProcessor::clearCompiledStylesheet()
+{
+    if (!m_compiledStylesheet)
+        return;
+    xsltFreeStylesheet(m_compiledStylesheet);
+    m_compiledStylesheet = nullptr;
+    m_compiledStylesheetMarkup = String();
+    // The XSLStyleSheet serves loads made on behalf of the compiled sheet.
+    m_stylesheet = nullptr;
+}
+
 static inline xmlDocPtr xmlDocPtrFromNode(Node& sourceNode, bool& shouldDelete)
 {
     Ref<Document> ownerDocument(sourceNode.document());
@@ -305,13 +343,12 @@ bool XSLTProcessor::transformToString(Node& sourceNode, String& mimeType, String
     Ref<Document> ownerDocument(sourceNode.document());
 
     setXSLTLoadCallBack(docLoaderFunc, this, &ownerDocument->cachedResourceLoader());
-    xsltStylesheetPtr sheet = xsltStylesheetPointer(m_stylesheet, m_stylesheetRootNode.get());
+    xsltStylesheetPtr sheet = compiledStylesheet();
     if (!sheet) {
         setXSLTLoadCallBack(nullptr, nullptr, nullptr);
         m_stylesheet = nullptr;
         return false;
     }
-    m_stylesheet->clearDocuments();
 
     xmlChar* origMethod = sheet->method;
     if (!origMethod && mimeType == "text/html")
@@ -366,8 +403,10 @@ bool XSLTProcessor::transformToString(Node& sourceNode, String& mimeType, String
 
     sheet->method = origMethod;
     setXSLTLoadCallBack(0, 0, 0);
-    xsltFreeStylesheet(sheet);
-    m_stylesheet = nullptr;
+    if (sheet != m_compiledStylesheet) {
+        xsltFreeStylesheet(sheet);
+        m_stylesheet = nullptr;
+    }
 
     return success;
 }
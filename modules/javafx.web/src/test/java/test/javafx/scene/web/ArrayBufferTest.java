@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import java.nio.ByteBuffer;
+import javafx.scene.web.WebEngineShim;
+import netscape.javascript.JSObject;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import org.junit.Test;
+
+public class ArrayBufferTest extends TestBase {
+
+    private JSObject createArrayBuffer(ByteBuffer buffer) {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        JSObject arrayBuffer = page.createArrayBuffer(page.getMainFrame(), buffer);
+        assertNotNull(arrayBuffer);
+        JSObject window = (JSObject) getEngine().executeScript("window");
+        window.setMember("buf", arrayBuffer);
+        return arrayBuffer;
+    }
+
+    @Test public void testSharedMemory() {
+        loadContent("<html><body></body></html>");
+        submit(() -> {
+            ByteBuffer buffer = ByteBuffer.allocateDirect(16);
+            for (int i = 0; i < 16; i++) {
+                buffer.put(i, (byte) i);
+            }
+            createArrayBuffer(buffer);
+            assertEquals(16, getEngine().executeScript("buf.byteLength"));
+            assertEquals(5, getEngine().executeScript("new Uint8Array(buf)[5]"));
+
+            // Writes on either side are visible to the other
+            getEngine().executeScript("new Uint8Array(buf)[0] = 42");
+            assertEquals(42, buffer.get(0));
+            buffer.put(15, (byte) 7);
+            assertEquals(7, getEngine().executeScript("new Uint8Array(buf)[15]"));
+        });
+    }
+
+    @Test public void testRemainingBytes() {
+        loadContent("<html><body></body></html>");
+        submit(() -> {
+            ByteBuffer buffer = ByteBuffer.allocateDirect(16);
+            buffer.position(4).limit(12);
+            buffer.put(4, (byte) 9);
+            createArrayBuffer(buffer);
+            assertEquals(8, getEngine().executeScript("buf.byteLength"));
+            assertEquals(9, getEngine().executeScript("new Uint8Array(buf)[0]"));
+        });
+    }
+
+    @Test public void testTransferCopies() {
+        loadContent("<html><body></body></html>");
+        submit(() -> {
+            ByteBuffer buffer = ByteBuffer.allocateDirect(16);
+            createArrayBuffer(buffer);
+            // A pinned buffer is copied rather than detached, so the memory
+            // stays shared with the Java buffer
+            getEngine().executeScript("postMessage(0, '*', [buf])");
+            assertEquals(16, getEngine().executeScript("buf.byteLength"));
+            getEngine().executeScript("new Uint8Array(buf)[1] = 3");
+            assertEquals(3, buffer.get(1));
+        });
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testHeapBuffer() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        page.createArrayBuffer(page.getMainFrame(), ByteBuffer.allocate(16));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testReadOnlyBuffer() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        page.createArrayBuffer(page.getMainFrame(),
+                ByteBuffer.allocateDirect(16).asReadOnlyBuffer());
+    }
+
+    @Test public void testIllegalFrameId() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            assertNull(page.createArrayBuffer(1, ByteBuffer.allocateDirect(16)));
+        });
+    }
+}
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.dom.DOMSnapshot;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import org.w3c.dom.DOMException;
+import org.w3c.dom.Document;
+import org.w3c.dom.Element;
+import org.w3c.dom.Node;
+import org.w3c.dom.NodeList;
+import org.w3c.dom.Text;
+import org.w3c.dom.traversal.NodeFilter;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import org.junit.Test;
+
+public class DOMSnapshotTest extends TestBase {
+
+    private static final String CONTENT =
+            "<html><body>"
+            + "<div id='a' class='x' title='t'>one<span id='b'>two</span></div>"
+            + "<div id='c' style='display:none'><p id='d'>hidden</p></div>"
+            + "<p id='e' class='x' style='width:50px;height:20px'>three</p>"
+            + "</body></html>";
+
+    static final class Record {
+        long id;
+        long parent;
+        int type;
+        int flags;
+        String name;
+        String value;
+        final Map<String, String> attributes = new LinkedHashMap<>();
+        int[] box;
+    }
+
+    static String readString(ByteBuffer buffer) {
+        int length = buffer.getInt();
+        char[] chars = new char[length];
+        for (int i = 0; i < length; i++) {
+            chars[i] = buffer.getChar();
+        }
+        return new String(chars);
+    }
+
+    static Record readRecord(ByteBuffer buffer) {
+        Record record = new Record();
+        record.id = buffer.getLong();
+        record.parent = buffer.getLong();
+        record.type = buffer.getInt();
+        record.flags = buffer.getInt();
+        record.name = readString(buffer);
+        record.value = readString(buffer);
+        int count = buffer.getInt();
+        for (int i = 0; i < count; i++) {
+            String name = readString(buffer);
+            record.attributes.put(name, readString(buffer));
+        }
+        if ((record.flags & DOMSnapshot.HAS_BOX) != 0) {
+            record.box = new int[] {
+                buffer.getInt(), buffer.getInt(), buffer.getInt(), buffer.getInt()
+            };
+        }
+        return record;
+    }
+
+    static List<Record> readSnapshot(ByteBuffer buffer) {
+        assertEquals(DOMSnapshot.VERSION, buffer.getInt());
+        int count = buffer.getInt();
+        List<Record> records = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            records.add(readRecord(buffer));
+        }
+        assertFalse(buffer.hasRemaining());
+        return records;
+    }
+
+    static Record find(List<Record> records, long id) {
+        for (Record record : records) {
+            if (record.id == id) {
+                return record;
+            }
+        }
+        return null;
+    }
+
+    static final class JournalRecord {
+        int kind;
+        long id;
+        long parent;
+        long previous;
+        List<Record> subtree = new ArrayList<>();
+        String name;
+        String value;
+    }
+
+    // Flags of the journal last read, JUnit creates an instance per test
+    private int journalFlags;
+
+    private List<JournalRecord> readJournal(ByteBuffer buffer) {
+        assertEquals(DOMSnapshot.VERSION, buffer.getInt());
+        int count = buffer.getInt();
+        journalFlags = buffer.getInt();
+        List<JournalRecord> records = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            JournalRecord record = new JournalRecord();
+            record.kind = buffer.getInt();
+            record.id = buffer.getLong();
+            switch (record.kind) {
+                case DOMSnapshot.JOURNAL_INSERTED:
+                    record.parent = buffer.getLong();
+                    record.previous = buffer.getLong();
+                    int subtreeCount = buffer.getInt();
+                    for (int j = 0; j < subtreeCount; j++) {
+                        record.subtree.add(readRecord(buffer));
+                    }
+                    break;
+                case DOMSnapshot.JOURNAL_REMOVED:
+                    break;
+                case DOMSnapshot.JOURNAL_ATTRIBUTE:
+                    record.name = readString(buffer);
+                    if (buffer.getInt() != 0) {
+                        record.value = readString(buffer);
+                    }
+                    break;
+                case DOMSnapshot.JOURNAL_TEXT:
+                    record.value = readString(buffer);
+                    break;
+                default:
+                    throw new AssertionError("Unknown journal record " + record.kind);
+            }
+            records.add(record);
+        }
+        assertFalse(buffer.hasRemaining());
+        return records;
+    }
+
+    private Document loadDocument() {
+        loadContent(CONTENT);
+        return submit(() -> getEngine().getDocument());
+    }
+
+    @Test public void testCaptureAll() {
+        Document doc = loadDocument();
+        submit(() -> {
+            ByteBuffer buffer = DOMSnapshot.capture(doc);
+            assertTrue(buffer.isReadOnly());
+            List<Record> records = readSnapshot(buffer);
+
+            Record root = records.get(0);
+            assertEquals(DOMSnapshot.getNodeId(doc), root.id);
+            assertEquals(0, root.parent);
+            assertEquals(Node.DOCUMENT_NODE, root.type);
+
+            Element a = doc.getElementById("a");
+            Record ra = find(records, DOMSnapshot.getNodeId(a));
+            assertEquals("DIV", ra.name);
+            assertEquals(DOMSnapshot.getNodeId(a.getParentNode()), ra.parent);
+            assertEquals("a", ra.attributes.get("id"));
+            assertEquals("x", ra.attributes.get("class"));
+            assertEquals("t", ra.attributes.get("title"));
+            assertNull(ra.box);
+
+            Node text = a.getFirstChild();
+            Record rt = find(records, DOMSnapshot.getNodeId(text));
+            assertEquals(Node.TEXT_NODE, rt.type);
+            assertEquals("one", rt.value);
+            assertEquals(ra.id, rt.parent);
+
+            // Records are in document order
+            Record rb = find(records, DOMSnapshot.getNodeId(doc.getElementById("b")));
+            Record re = find(records, DOMSnapshot.getNodeId(doc.getElementById("e")));
+            assertTrue(records.indexOf(ra) < records.indexOf(rt));
+            assertTrue(records.indexOf(rt) < records.indexOf(rb));
+            assertTrue(records.indexOf(rb) < records.indexOf(re));
+        });
+    }
+
+    @Test public void testCaptureFilters() {
+        Document doc = loadDocument();
+        submit(() -> {
+            Element body = (Element) doc.getElementsByTagName("body").item(0);
+            List<Record> records = readSnapshot(DOMSnapshot.capture(body,
+                    NodeFilter.SHOW_ELEMENT, new String[] {"ID"}, 0));
+            for (Record record : records) {
+                assertEquals(Node.ELEMENT_NODE, record.type);
+                assertFalse(record.attributes.containsKey("class"));
+            }
+            assertEquals(6, records.size());
+
+            // Children of a filtered out node get its closest shown ancestor
+            // as their parent
+            List<Record> texts = readSnapshot(DOMSnapshot.capture(body,
+                    NodeFilter.SHOW_TEXT, null, 0));
+            assertEquals(4, texts.size());
+            for (Record record : texts) {
+                assertEquals(0, record.parent);
+            }
+
+            Record rb = find(records, DOMSnapshot.getNodeId(doc.getElementById("b")));
+            assertEquals("b", rb.attributes.get("id"));
+            assertEquals(1, rb.attributes.size());
+        });
+    }
+
+    @Test public void testCaptureLayout() {
+        Document doc = loadDocument();
+        submit(() -> {
+            Element body = (Element) doc.getElementsByTagName("body").item(0);
+            List<Record> records = readSnapshot(DOMSnapshot.capture(body,
+                    NodeFilter.SHOW_ELEMENT, null,
+                    DOMSnapshot.LAYOUT | DOMSnapshot.RENDERED_ONLY));
+            assertNull(find(records, DOMSnapshot.getNodeId(doc.getElementById("c"))));
+            assertNull(find(records, DOMSnapshot.getNodeId(doc.getElementById("d"))));
+
+            Record re = find(records, DOMSnapshot.getNodeId(doc.getElementById("e")));
+            assertEquals(DOMSnapshot.HAS_BOX, re.flags);
+            assertEquals(50, re.box[2]);
+            assertEquals(20, re.box[3]);
+        });
+    }
+
+    @Test public void testNodeIds() {
+        Document doc = loadDocument();
+        submit(() -> {
+            Element a = doc.getElementById("a");
+            Element b = doc.getElementById("b");
+            long id = DOMSnapshot.getNodeId(a);
+            assertNotEquals(0, id);
+            assertEquals(id, DOMSnapshot.getNodeId(a));
+            assertNotEquals(id, DOMSnapshot.getNodeId(b));
+            assertSame(a, DOMSnapshot.getNode(id));
+
+            // A node that was never serialized gets an id when asked for one
+            Element created = doc.createElement("i");
+            long createdId = DOMSnapshot.getNodeId(created);
+            assertNotEquals(id, createdId);
+            assertSame(created, DOMSnapshot.getNode(createdId));
+        });
+    }
+
+    @Test public void testQuerySelectorAll() {
+        Document doc = loadDocument();
+        submit(() -> {
+            Node[] nodes = DOMSnapshot.querySelectorAll(doc, ".x, span");
+            assertArrayEquals(new Node[] {
+                doc.getElementById("a"), doc.getElementById("b"), doc.getElementById("e")
+            }, nodes);
+
+            Element a = doc.getElementById("a");
+            NodeList expected = a.getElementsByTagName("*");
+            Node[] scoped = DOMSnapshot.querySelectorAll(a, "*");
+            assertEquals(expected.getLength(), scoped.length);
+            for (int i = 0; i < scoped.length; i++) {
+                assertSame(expected.item(i), scoped[i]);
+            }
+
+            assertEquals(0, DOMSnapshot.querySelectorAll(doc, "table").length);
+        });
+    }
+
+    @Test public void testQuerySelectorAllInvalid() {
+        Document doc = loadDocument();
+        submit(() -> {
+            try {
+                DOMSnapshot.querySelectorAll(doc, "[");
+                throw new AssertionError("DOMException expected");
+            } catch (DOMException e) {
+                assertEquals(DOMException.SYNTAX_ERR, e.code);
+            }
+        });
+    }
+
+    @Test public void testJournalNotStarted() {
+        Document doc = loadDocument();
+        submit(() -> {
+            try {
+                DOMSnapshot.drainJournal(doc, null);
+                throw new AssertionError("DOMException expected");
+            } catch (DOMException e) {
+                assertEquals(DOMException.NOT_SUPPORTED_ERR, e.code);
+            }
+        });
+    }
+
+    @Test public void testJournalRecords() {
+        Document doc = loadDocument();
+        submit(() -> {
+            DOMSnapshot.startJournal(doc, DOMSnapshot.DEFAULT_JOURNAL_CAPACITY);
+            Element a = doc.getElementById("a");
+            Element b = doc.getElementById("b");
+            Text one = (Text) a.getFirstChild();
+            long bId = DOMSnapshot.getNodeId(b);
+
+            a.setAttribute("title", "u");
+            Element i = doc.createElement("i");
+            i.appendChild(doc.createTextNode("new"));
+            a.appendChild(i);
+            one.setData("changed");
+            a.removeChild(b);
+            a.removeAttribute("class");
+
+            List<JournalRecord> records = readJournal(DOMSnapshot.drainJournal(doc, null));
+            assertEquals(0, journalFlags);
+            assertEquals(5, records.size());
+
+            JournalRecord title = records.get(0);
+            assertEquals(DOMSnapshot.JOURNAL_ATTRIBUTE, title.kind);
+            assertEquals(DOMSnapshot.getNodeId(a), title.id);
+            assertEquals("title", title.name);
+            assertEquals("u", title.value);
+
+            // Positions are read when draining, after b was removed
+            JournalRecord inserted = records.get(1);
+            assertEquals(DOMSnapshot.JOURNAL_INSERTED, inserted.kind);
+            assertEquals(DOMSnapshot.getNodeId(i), inserted.id);
+            assertEquals(DOMSnapshot.getNodeId(a), inserted.parent);
+            assertEquals(DOMSnapshot.getNodeId(one), inserted.previous);
+            assertEquals(2, inserted.subtree.size());
+            assertEquals("I", inserted.subtree.get(0).name);
+            assertEquals(DOMSnapshot.getNodeId(a), inserted.subtree.get(0).parent);
+            assertEquals("new", inserted.subtree.get(1).value);
+            assertEquals(inserted.id, inserted.subtree.get(1).parent);
+
+            JournalRecord text = records.get(2);
+            assertEquals(DOMSnapshot.JOURNAL_TEXT, text.kind);
+            assertEquals(DOMSnapshot.getNodeId(one), text.id);
+            assertEquals("changed", text.value);
+
+            JournalRecord removed = records.get(3);
+            assertEquals(DOMSnapshot.JOURNAL_REMOVED, removed.kind);
+            assertEquals(bId, removed.id);
+
+            JournalRecord cls = records.get(4);
+            assertEquals(DOMSnapshot.JOURNAL_ATTRIBUTE, cls.kind);
+            assertEquals("class", cls.name);
+            assertNull(cls.value);
+
+            // A drained journal is empty
+            assertEquals(0, readJournal(DOMSnapshot.drainJournal(doc, null)).size());
+            DOMSnapshot.stopJournal(doc);
+        });
+    }
+
+    @Test public void testJournalCollapsesRepeatedChanges() {
+        Document doc = loadDocument();
+        submit(() -> {
+            DOMSnapshot.startJournal(doc, DOMSnapshot.DEFAULT_JOURNAL_CAPACITY);
+            Element e = doc.getElementById("e");
+            for (int i = 0; i < 100; i++) {
+                e.setAttribute("title", "v" + i);
+            }
+            List<JournalRecord> records = readJournal(DOMSnapshot.drainJournal(doc, null));
+            assertEquals(1, records.size());
+            assertEquals("v99", records.get(0).value);
+            DOMSnapshot.stopJournal(doc);
+        });
+    }
+
+    @Test public void testJournalAttributeFilter() {
+        Document doc = loadDocument();
+        submit(() -> {
+            DOMSnapshot.startJournal(doc, DOMSnapshot.DEFAULT_JOURNAL_CAPACITY);
+            Element e = doc.getElementById("e");
+            e.setAttribute("title", "ignored");
+            e.setAttribute("class", "y");
+            List<JournalRecord> records = readJournal(
+                    DOMSnapshot.drainJournal(doc, new String[] {"class"}));
+            assertEquals(1, records.size());
+            assertEquals("class", records.get(0).name);
+            assertEquals("y", records.get(0).value);
+            DOMSnapshot.stopJournal(doc);
+        });
+    }
+
+    @Test public void testJournalOverflow() {
+        Document doc = loadDocument();
+        submit(() -> {
+            DOMSnapshot.startJournal(doc, 4);
+            Element e = doc.getElementById("e");
+            for (int i = 0; i < 10; i++) {
+                e.setAttribute("data-" + i, "x");
+            }
+            List<JournalRecord> records = readJournal(DOMSnapshot.drainJournal(doc, null));
+            assertEquals(DOMSnapshot.JOURNAL_OVERFLOWED, journalFlags);
+            // The newest records are kept
+            assertEquals(4, records.size());
+            for (int i = 0; i < 4; i++) {
+                assertEquals("data-" + (6 + i), records.get(i).name);
+            }
+
+            readJournal(DOMSnapshot.drainJournal(doc, null));
+            assertEquals(0, journalFlags);
+            DOMSnapshot.stopJournal(doc);
+        });
+    }
+
+    @Test public void testStopJournal() {
+        Document doc = loadDocument();
+        submit(() -> {
+            DOMSnapshot.startJournal(doc, DOMSnapshot.DEFAULT_JOURNAL_CAPACITY);
+            DOMSnapshot.stopJournal(doc);
+            doc.getElementById("e").setAttribute("title", "x");
+            try {
+                DOMSnapshot.drainJournal(doc, null);
+                throw new AssertionError("DOMException expected");
+            } catch (DOMException e) {
+                assertEquals(DOMException.NOT_SUPPORTED_ERR, e.code);
+            }
+        });
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testJournalCapacity() {
+        Document doc = loadDocument();
+        DOMSnapshot.startJournal(doc, 0);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.MemoryPressure;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import org.junit.After;
+import org.junit.Test;
+
+public class MemoryPressureTest extends TestBase {
+
+    private static final String IMAGES =
+            "<html><body><script>"
+            + "var c = document.createElement('canvas');"
+            + "c.width = c.height = 256;"
+            + "for (var i = 0; i < 16; i++) {"
+            + "  var img = document.createElement('img');"
+            + "  img.src = c.toDataURL('image/png', i);"
+            + "  document.body.appendChild(img);"
+            + "}"
+            + "</script></body></html>";
+
+    // About 8MB of arrays, kept alive until the test drops them
+    private static final long GARBAGE_BYTES = 8L * 1024 * 1024;
+    private static final String GARBAGE =
+            "<html><body><script>"
+            + "var garbage = [];"
+            + "for (var i = 0; i < 1024; i++) {"
+            + "  garbage.push(new Float64Array(1024));"
+            + "}"
+            + "</script></body></html>";
+
+    @After public void resetMemoryPressure() {
+        submit(() -> {
+            MemoryPressure.setBudget(0);
+            MemoryPressure.setLevel(MemoryPressure.LEVEL_NONE);
+        });
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testNegativeBudget() {
+        MemoryPressure.setBudget(-1);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testInvalidLevel() {
+        MemoryPressure.setLevel(MemoryPressure.LEVEL_CRITICAL + 1);
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testSetLevelOffEventThread() {
+        MemoryPressure.setLevel(MemoryPressure.LEVEL_NONE);
+    }
+
+    @Test public void testBudget() {
+        submit(() -> {
+            MemoryPressure.setBudget(64L * 1024 * 1024);
+            assertEquals(64L * 1024 * 1024, MemoryPressure.getBudget());
+            MemoryPressure.setBudget(0);
+            assertEquals(0, MemoryPressure.getBudget());
+        });
+    }
+
+    @Test public void testUsage() {
+        loadContent(IMAGES);
+        submit(() -> {
+            MemoryPressure.Usage usage = MemoryPressure.getUsage();
+            assertTrue(usage.getMemoryCacheBytes() > 0);
+            assertTrue(usage.getMemoryCacheBytes() >= usage.getDecodedImageBytes());
+            assertTrue(usage.getJavaScriptHeapBytes() > 0);
+        });
+    }
+
+    @Test public void testCriticalPressure() {
+        loadContent(GARBAGE);
+        submit(() -> {
+            getEngine().executeScript("garbage = null");
+            MemoryPressure.Usage before = MemoryPressure.getUsage();
+            MemoryPressure.setLevel(MemoryPressure.LEVEL_CRITICAL);
+            MemoryPressure.Usage after = MemoryPressure.getUsage();
+            // The arrays that were dropped are collected
+            assertTrue(before + " -> " + after, after.getJavaScriptHeapBytes()
+                    < before.getJavaScriptHeapBytes() - GARBAGE_BYTES / 2);
+            assertTrue(before + " -> " + after,
+                    after.getTotalBytes() < before.getTotalBytes());
+            assertEquals(0, after.getPageCachePages());
+        });
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetSocketAddress;
+import java.nio.charset.StandardCharsets;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+import static org.junit.Assert.assertEquals;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class PreloadScannerTest extends TestBase {
+
+    // Slices of markup the parser yields after, each longer than the
+    // 4096 tokens HTMLParserScheduler parses before it checks the time
+    private static final int SLICES = 4;
+    private static final int PARAGRAPHS_PER_SLICE = 2000;
+
+    // Runs longer than the parser time limit, so the parser yields after it
+    private static final String BUSY_SCRIPT =
+            "<script>var end = Date.now() + 600; while (Date.now() < end);</script>";
+
+    // Asks the server whether the resource was requested, before the
+    // parser gets to the element that references it
+    private static final String CHECK_SCRIPT =
+            "<script>"
+            + "function requested(name) {"
+            + "  var end = Date.now() + 5000;"
+            + "  while (Date.now() < end) {"
+            + "    var xhr = new XMLHttpRequest();"
+            + "    xhr.open('GET', '/requested?' + name, false);"
+            + "    xhr.send();"
+            + "    if (xhr.responseText == 'yes') return true;"
+            + "  }"
+            + "  return false;"
+            + "}"
+            + "window.lateStyle = requested('late.css');"
+            + "window.lateImage = requested('late.gif');"
+            + "</script>";
+
+    private static final byte[] GIF = {
+        'G', 'I', 'F', '8', '9', 'a', 1, 0, 1, 0, (byte) 0x80, 0, 0,
+        0, 0, 0, (byte) 0xff, (byte) 0xff, (byte) 0xff,
+        '!', (byte) 0xf9, 4, 1, 0, 0, 0, 0,
+        ',', 0, 0, 0, 0, 1, 0, 1, 0, 0, 2, 2, 'D', 1, 0, ';'
+    };
+
+    private final Set<String> requested = ConcurrentHashMap.newKeySet();
+    private HttpServer server;
+
+    private static String longDocument() {
+        StringBuilder html = new StringBuilder("<!DOCTYPE html><html><body>");
+        for (int slice = 0; slice < SLICES; slice++) {
+            for (int i = 0; i < PARAGRAPHS_PER_SLICE; i++) {
+                html.append("<p>").append(i).append("</p>");
+            }
+            html.append(BUSY_SCRIPT);
+        }
+        html.append(CHECK_SCRIPT);
+        html.append("<link rel='stylesheet' href='/late.css'>");
+        html.append("<img src='/late.gif'>");
+        html.append("</body></html>");
+        return html.toString();
+    }
+
+    private void respond(HttpExchange exchange) throws IOException {
+        String path = exchange.getRequestURI().getPath();
+        String type;
+        byte[] body;
+        if (path.equals("/page.html")) {
+            type = "text/html";
+            body = longDocument().getBytes(StandardCharsets.UTF_8);
+        } else if (path.equals("/requested")) {
+            String name = exchange.getRequestURI().getQuery();
+            type = "text/plain";
+            body = (requested.contains("/" + name) ? "yes" : "no").getBytes(StandardCharsets.UTF_8);
+        } else {
+            requested.add(path);
+            if (path.endsWith(".css")) {
+                type = "text/css";
+                body = "p { margin: 0 }".getBytes(StandardCharsets.UTF_8);
+            } else {
+                type = "image/gif";
+                body = GIF;
+            }
+        }
+        exchange.getResponseHeaders().set("Content-Type", type);
+        exchange.getResponseHeaders().set("Cache-Control", "no-store");
+        exchange.sendResponseHeaders(200, body.length);
+        try (OutputStream out = exchange.getResponseBody()) {
+            out.write(body);
+        }
+    }
+
+    @Before public void startServer() throws IOException {
+        server = HttpServer.create(new InetSocketAddress("127.0.0.1", 0), 0);
+        server.createContext("/", this::respond);
+        server.start();
+    }
+
+    @After public void stopServer() {
+        server.stop(0);
+    }
+
+    /**
+     * The preload scanner runs while the parser yields. A late stylesheet
+     * and image of a long document must be requested before the parser
+     * reaches them, which needs the scanner to keep up with the parser
+     * over several yields.
+     */
+    @Test public void testLateResourcesArePreloaded() {
+        load("http://127.0.0.1:" + server.getAddress().getPort() + "/page.html");
+        assertEquals(Boolean.TRUE, executeScript("window.lateStyle"));
+        assertEquals(Boolean.TRUE, executeScript("window.lateImage"));
+    }
+}
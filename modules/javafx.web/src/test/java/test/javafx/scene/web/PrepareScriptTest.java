@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import javafx.scene.web.WebEngineShim;
+import netscape.javascript.JSException;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import org.junit.Test;
+
+public class PrepareScriptTest extends TestBase {
+
+    private static final String RECORD_ERRORS =
+            "<script>"
+            + "var errors = [];"
+            + "window.onerror = function(message) { errors.push(message); };"
+            + "</script>";
+
+    private static String dataScript(String source) {
+        return "data:text/javascript," + source.replace(" ", "%20")
+                .replace("=", "%3D").replace(";", "%3B");
+    }
+
+    @Test public void testPreparedScriptRuns() {
+        loadContent("<html><body></body></html>");
+        submit(() -> {
+            WebPage page = WebEngineShim.getPage(getEngine());
+            page.prepareScript(page.getMainFrame(), "6 * 7");
+            assertEquals(42, getEngine().executeScript("6 * 7"));
+        });
+    }
+
+    @Test public void testPreparedSyntaxErrorReportedOnExecution() {
+        loadContent("<html><body></body></html>");
+        submit(() -> {
+            WebPage page = WebEngineShim.getPage(getEngine());
+            // Preparing does not report the error, nor run anything
+            page.prepareScript(page.getMainFrame(), "var broken = ;");
+            try {
+                getEngine().executeScript("var broken = ;");
+                fail("JSException expected but not thrown");
+            } catch (JSException ex) {
+                assertTrue(ex.getMessage(), ex.getMessage().startsWith("SyntaxError"));
+            }
+        });
+    }
+
+    @Test public void testExternalSyntaxErrorReportedOnExecution() {
+        // The deferred scripts are compiled when they load, and run after parsing
+        loadContent("<html><body>" + RECORD_ERRORS
+                + "<script defer src='" + dataScript("var broken = ;") + "'></script>"
+                + "<script defer src='" + dataScript("var after = 1;") + "'></script>"
+                + "</body></html>");
+        assertEquals(1, executeScript("errors.length"));
+        assertTrue((Boolean) executeScript("errors[0].indexOf('SyntaxError') >= 0"));
+        assertEquals(1, executeScript("after"));
+    }
+
+    @Test public void testDetachedScriptStillRuns() {
+        // A script removed while it loads is not compiled ahead, but still runs
+        loadContent("<html><body>" + RECORD_ERRORS + "<script>"
+                + "var script = document.createElement('script');"
+                + "script.src = '" + dataScript("var detached = 1;") + "';"
+                + "script.onload = function() { loaded = true; };"
+                + "var loaded = false;"
+                + "document.body.appendChild(script);"
+                + "document.body.removeChild(script);"
+                + "</script></body></html>");
+        assertEquals(Boolean.TRUE, executeScript("loaded"));
+        assertEquals(1, executeScript("detached"));
+        assertEquals(0, executeScript("errors.length"));
+    }
+}
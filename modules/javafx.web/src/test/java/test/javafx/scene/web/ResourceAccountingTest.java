@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.ResourceCounters;
+import com.sun.webkit.WebPage;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngineShim;
+import javafx.scene.web.WebView;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import org.junit.Test;
+
+public class ResourceAccountingTest extends TestBase {
+
+    private static final String LAYOUT =
+            "<html><body><div id='d'>text</div><script>"
+            + "var d = document.getElementById('d');"
+            + "for (var i = 0; i < 100; i++) {"
+            + "  d.style.width = i + 'px';"
+            + "  d.offsetWidth;"
+            + "}"
+            + "</script></body></html>";
+
+    private static final String IMAGE =
+            "<html><body><img src='data:image/gif;base64,"
+            + "R0lGODlhAQABAIAAAP///wAAACH5BAEAAAAALAAAAAABAAEAAAICRAEAOw=='>"
+            + "</body></html>";
+
+    @Test public void testDisabledByDefault() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            assertNull(page.getResourceCounters());
+        });
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testSoftLimitRequiresAccounting() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            page.setResourceSoftLimit(1024);
+        });
+    }
+
+    @Test public void testCounters() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            page.setResourceAccountingEnabled(true);
+        });
+        loadContent(LAYOUT);
+        submit(() -> {
+            ResourceCounters counters = page.getResourceCounters();
+            assertNotNull(counters);
+            assertTrue(counters.getCount(ResourceCounters.ACTIVITY_SCRIPT) > 0);
+            assertTrue(counters.getCount(ResourceCounters.ACTIVITY_STYLE) >= 100);
+            assertTrue(counters.getCount(ResourceCounters.ACTIVITY_LAYOUT) >= 100);
+            assertEquals(0, counters.getEvictionCount());
+
+            page.setResourceAccountingEnabled(false);
+            assertNull(page.getResourceCounters());
+        });
+    }
+
+    @Test public void testSoftLimit() {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            page.setResourceAccountingEnabled(true);
+            page.setResourceSoftLimit(1);
+        });
+        loadContent(IMAGE);
+        submit(() -> {
+            ResourceCounters counters = page.getResourceCounters();
+            assertTrue(counters.getEvictionCount() > 0);
+            assertEquals(0, counters.getPageCachePages());
+            page.setResourceAccountingEnabled(false);
+        });
+    }
+
+    @Test public void testSoftLimitKeepsSharedImages() throws Exception {
+        WebPage page = WebEngineShim.getPage(getEngine());
+        submit(() -> {
+            page.setResourceAccountingEnabled(true);
+        });
+        loadContent(IMAGE);
+        long decodedImageBytes = submit(() -> {
+            // Painting decodes the image
+            new Scene(getView()).snapshot(null);
+            return page.getResourceCounters().getDecodedImageBytes();
+        });
+        assertTrue(decodedImageBytes > 0);
+
+        // Another page shows the same cached image and goes over its limit
+        CountDownLatch loaded = new CountDownLatch(1);
+        WebView other = submit(() -> {
+            WebView view = new WebView();
+            view.getEngine().getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+                if (n == Worker.State.SUCCEEDED) {
+                    loaded.countDown();
+                }
+            });
+            view.getEngine().loadContent(IMAGE);
+            return view;
+        });
+        assertTrue(loaded.await(getLoadTimeOut(), TimeUnit.MILLISECONDS));
+        submit(() -> {
+            WebPage otherPage = WebEngineShim.getPage(other.getEngine());
+            otherPage.setResourceAccountingEnabled(true);
+            otherPage.setResourceSoftLimit(1);
+            assertTrue(otherPage.getResourceCounters().getEvictionCount() > 0);
+
+            assertEquals(decodedImageBytes,
+                    page.getResourceCounters().getDecodedImageBytes());
+            otherPage.setResourceAccountingEnabled(false);
+            page.setResourceAccountingEnabled(false);
+        });
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.ScriptResult;
+import com.sun.webkit.WebPage;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Date;
+import java.util.List;
+import java.util.Map;
+import javafx.scene.web.WebEngineShim;
+import netscape.javascript.JSException;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import org.junit.Before;
+import org.junit.Test;
+
+public class ScriptResultTest extends TestBase {
+
+    @Before public void loadPage() {
+        loadContent("<html><body></body></html>");
+    }
+
+    private Object eval(String script) {
+        return submit(() -> {
+            WebPage page = WebEngineShim.getPage(getEngine());
+            return page.executeScriptForResult(page.getMainFrame(), script).toJava();
+        });
+    }
+
+    @Test public void testPrimitives() {
+        assertEquals("undefined", eval("undefined"));
+        assertNull(eval("null"));
+        assertEquals(Boolean.TRUE, eval("true"));
+        assertEquals(Boolean.FALSE, eval("false"));
+        assertEquals("", eval("''"));
+        assertEquals("\u00e9\u4e2d\ud83d\ude00", eval("'\\u00e9\\u4e2d\\ud83d\\ude00'"));
+        assertSame(ScriptResult.OPAQUE, eval("(function() {})"));
+    }
+
+    @Test public void testNumbers() {
+        assertEquals(1, eval("1"));
+        assertEquals(-7, eval("-7"));
+        assertEquals(1.5, eval("1.5"));
+        assertEquals(2147483648.0, eval("Math.pow(2, 31)"));
+        assertEquals(Double.NaN, eval("NaN"));
+        assertEquals(Double.POSITIVE_INFINITY, eval("Infinity"));
+        assertEquals(0, eval("0"));
+        // -0 stays a double, so the sign is not lost
+        Object negativeZero = eval("-0");
+        assertTrue(negativeZero instanceof Double);
+        assertEquals(Double.doubleToRawLongBits(-0.0),
+                Double.doubleToRawLongBits((Double) negativeZero));
+    }
+
+    @Test public void testDates() {
+        assertEquals(new Date(1000), eval("new Date(1000)"));
+        assertEquals(new Date(-86400000L), eval("new Date(-86400000)"));
+        assertNull(eval("new Date(NaN)"));
+    }
+
+    @Test public void testNesting() {
+        assertEquals(Arrays.asList(1, "a", null, Arrays.asList(true, 2.5)),
+                eval("[1, 'a', null, [true, 2.5]]"));
+
+        Map<?, ?> map = (Map<?, ?>) eval("({b: 1, a: {c: [2]}, '': 'e'})");
+        assertEquals(Arrays.asList("b", "a", ""), Arrays.asList(map.keySet().toArray()));
+        assertEquals(1, map.get("b"));
+        assertEquals(Collections.singletonMap("c", Arrays.asList(2)), map.get("a"));
+        assertEquals("e", map.get(""));
+
+        // Holes read as undefined
+        assertEquals(Arrays.asList(1, "undefined", 3), eval("[1, , 3]"));
+    }
+
+    @Test public void testCycles() {
+        Map<?, ?> map = (Map<?, ?>) eval("var o = {n: 1}; o.self = o; o");
+        assertEquals(1, map.get("n"));
+        assertSame(ScriptResult.OPAQUE, map.get("self"));
+
+        List<?> list = (List<?>) eval("var a = [0]; a.push(a); a");
+        assertEquals(0, list.get(0));
+        assertSame(ScriptResult.OPAQUE, list.get(1));
+
+        // An object that is referenced twice without a cycle is written
+        // out both times
+        assertEquals(Arrays.asList(Collections.singletonMap("x", 1),
+                                   Collections.singletonMap("x", 1)),
+                eval("var s = {x: 1}; [s, s]"));
+    }
+
+    @Test public void testMaxDepth() {
+        Object value = eval("var v = 0;"
+                + "for (var i = 0; i < " + (ScriptResult.MAX_DEPTH + 10) + "; i++) v = [v];"
+                + "v");
+        int depth = 0;
+        while (value instanceof List) {
+            value = ((List<?>) value).get(0);
+            depth++;
+        }
+        assertEquals(ScriptResult.MAX_DEPTH, depth);
+        assertSame(ScriptResult.OPAQUE, value);
+    }
+
+    @Test public void testGetterThrows() {
+        submit(() -> {
+            WebPage page = WebEngineShim.getPage(getEngine());
+            try {
+                page.executeScriptForResult(page.getMainFrame(),
+                        "({get x() { throw new Error('boom'); }})");
+                throw new AssertionError("JSException expected");
+            } catch (JSException e) {
+                assertTrue(e.getMessage().contains("boom"));
+            }
+        });
+    }
+
+    @Test public void testTypedArrays() {
+        submit(() -> {
+            WebPage page = WebEngineShim.getPage(getEngine());
+            ScriptResult result = page.executeScriptForResult(page.getMainFrame(),
+                    "window.f = new Float64Array([1.5, 2.5]);"
+                    + "window.u = new Uint8Array(new ArrayBuffer(8), 2, 4);"
+                    + "window.b = new ArrayBuffer(3);"
+                    + "[f, u, b, f]");
+            assertEquals(4, result.getBufferCount());
+            List<?> list = (List<?>) result.toJava();
+
+            ByteBuffer f = (ByteBuffer) list.get(0);
+            assertTrue(f.isDirect());
+            assertEquals(16, f.capacity());
+            assertEquals(1.5, f.getDouble(0), 0);
+            assertEquals(2.5, f.getDouble(8), 0);
+
+            ByteBuffer u = (ByteBuffer) list.get(1);
+            assertEquals(4, u.capacity());
+            ByteBuffer b = (ByteBuffer) list.get(2);
+            assertEquals(3, b.capacity());
+
+            // The buffers are views of the script objects
+            u.put(0, (byte) 9);
+            assertEquals(9, getEngine().executeScript("new Uint8Array(u.buffer)[2]"));
+            getEngine().executeScript("f[1] = 4.25");
+            assertEquals(4.25, f.getDouble(8), 0);
+
+            // A pinned buffer is copied when transferred, so the view stays
+            // valid
+            getEngine().executeScript("postMessage(0, '*', [f.buffer])");
+            assertEquals(2, getEngine().executeScript("f.length"));
+            getEngine().executeScript("f[0] = 8");
+            assertEquals(8.0, f.getDouble(0), 0);
+        });
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import com.sun.webkit.Tracing;
+import java.io.IOException;
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import org.junit.After;
+import org.junit.Test;
+
+public class TracingTest extends TestBase {
+
+    // Each class change forces a style recalc and a layout from script
+    private static final String RELAYOUT =
+            "<html><head><style>.wide { width: 300px; }</style></head>"
+            + "<body><p id='p'>text</p><script>"
+            + "var p = document.getElementById('p');"
+            + "for (var i = 0; i < 20; i++) {"
+            + "  p.classList.toggle('wide');"
+            + "  p.getBoundingClientRect();"
+            + "}"
+            + "</script></body></html>";
+
+    @After public void disableTracing() {
+        submit(() -> {
+            Tracing.setEnabled(false);
+            Tracing.drain();
+            Tracing.takeDroppedCount();
+        });
+    }
+
+    private static int count(List<Tracing.Event> events, String name,
+                             char phase) {
+        int count = 0;
+        for (Tracing.Event event : events) {
+            if (event.getName().equals(name) && event.getPhase() == phase) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testSetEnabledOffEventThread() {
+        Tracing.setEnabled(true);
+    }
+
+    @Test public void testDisabled() {
+        submit(() -> {
+            assertFalse(Tracing.isEnabled());
+            Tracing.drain();
+        });
+        loadContent(RELAYOUT);
+        submit(() -> {
+            assertTrue(Tracing.drain().isEmpty());
+        });
+    }
+
+    @Test public void testEvents() {
+        submit(() -> {
+            Tracing.setEnabled(true);
+            assertTrue(Tracing.isEnabled());
+        });
+        loadContent(RELAYOUT);
+        submit(() -> {
+            List<Tracing.Event> events = Tracing.drain();
+            for (String name : new String[] {"JavaScript", "StyleRecalc", "Layout"}) {
+                int begins = count(events, name, Tracing.PHASE_BEGIN);
+                assertTrue(name, begins > 0);
+                assertEquals(name, begins, count(events, name, Tracing.PHASE_END));
+            }
+            long timestamp = Long.MIN_VALUE;
+            for (Tracing.Event event : events) {
+                if (event.getThread() == events.get(0).getThread()) {
+                    assertTrue(event.getTimestamp() >= timestamp);
+                    timestamp = event.getTimestamp();
+                }
+            }
+            assertTrue(Tracing.drain().isEmpty());
+        });
+    }
+
+    @Test public void testChromeTrace() {
+        submit(() -> {
+            Tracing.setEnabled(true);
+        });
+        loadContent(RELAYOUT);
+        submit(() -> {
+            StringBuilder trace = new StringBuilder();
+            try {
+                Tracing.writeChromeTrace(Tracing.drain(), trace);
+            } catch (IOException e) {
+                throw new AssertionError(e);
+            }
+            assertTrue(trace.toString().startsWith("{\"traceEvents\":["));
+            assertTrue(trace.toString().contains(
+                    "{\"name\":\"Layout\",\"cat\":\"webkit\",\"ph\":\"B\""));
+        });
+    }
+}
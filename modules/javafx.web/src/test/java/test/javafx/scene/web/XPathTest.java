@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertEquals;
+import org.junit.Before;
+import org.junit.Test;
+
+public class XPathTest extends TestBase {
+
+    private static final String DOCUMENT =
+            "<root>"
+            + "<a id='a1'><b id='b1'/><b id='dup'/></a>"
+            + "<a id='a2'><b id='b2'/><c><b id='dup'/></c></a>"
+            + "</root>";
+
+    @Before
+    public void setUp() {
+        // An XML document, so that name tests can use the tag index.
+        loadContent("<html><body><script>"
+                + "var doc = new DOMParser().parseFromString(\""
+                + DOCUMENT + "\", 'application/xml');"
+                + "function byId(id) {"
+                + "  return doc.evaluate(\"//*[@id='\" + id + \"']\", doc, null,"
+                + "      XPathResult.FIRST_ORDERED_NODE_TYPE, null).singleNodeValue;"
+                + "}"
+                + "function ids(expression, context) {"
+                + "  var result = doc.evaluate(expression, context || doc, null,"
+                + "      XPathResult.ORDERED_NODE_SNAPSHOT_TYPE, null);"
+                + "  var ids = [];"
+                + "  for (var i = 0; i < result.snapshotLength; i++)"
+                + "    ids.push(result.snapshotItem(i).getAttribute('id'));"
+                + "  return ids.join(',');"
+                + "}"
+                + "</script></body></html>");
+    }
+
+    // Runs the query more than once, so that later evaluations can be
+    // served by an index built at the current tree version.
+    private String ids(String expression, String context) {
+        String script = "ids(\"" + expression + "\", " + context + ")";
+        String first = (String) executeScript(script);
+        for (int i = 0; i < 2; i++) {
+            assertEquals(expression, first, executeScript(script));
+        }
+        return first;
+    }
+
+    private String ids(String expression) {
+        return ids(expression, "doc");
+    }
+
+    @Test public void testNameTest() {
+        assertEquals("b1,dup,b2,dup", ids("//b"));
+        assertEquals("b2,dup", ids(".//b", "byId('a2')"));
+        assertEquals("a2", ids("//a[b/@id='b2']"));
+    }
+
+    @Test public void testDuplicateId() {
+        assertEquals("dup,dup", ids("//b[@id='dup']"));
+        assertEquals("dup", ids(".//b[@id='dup']", "byId('a1')"));
+        assertEquals("dup", ids("descendant::*[@id='dup']", "byId('a2')"));
+        assertEquals("", ids("//a[@id='dup']"));
+    }
+
+    @Test public void testMovedId() {
+        assertEquals("b1", ids(".//b[@id='b1']", "byId('a1')"));
+        assertEquals("", ids(".//b[@id='b1']", "byId('a2')"));
+
+        executeScript("byId('a2').appendChild(byId('b1'))");
+        assertEquals("", ids(".//b[@id='b1']", "byId('a1')"));
+        assertEquals("b1", ids(".//b[@id='b1']", "byId('a2')"));
+        assertEquals("b2,dup,b1", ids(".//b", "byId('a2')"));
+
+        executeScript("byId('b2').setAttribute('id', 'moved')");
+        assertEquals("", ids("//b[@id='b2']"));
+        assertEquals("moved", ids("//b[@id='moved']"));
+    }
+
+    @Test public void testMutationBetweenEvaluations() {
+        assertEquals("b1,dup,b2,dup", ids("//b"));
+
+        executeScript("var b = doc.createElement('b');"
+                + "b.setAttribute('id', 'b3');"
+                + "byId('a1').appendChild(b)");
+        assertEquals("b1,dup,b3,b2,dup", ids("//b"));
+        assertEquals("b3", ids("//b[@id='b3']"));
+
+        executeScript("byId('a1').removeChild(byId('b1'))");
+        assertEquals("dup,b3,b2,dup", ids("//b"));
+        assertEquals("", ids("//b[@id='b1']"));
+
+        executeScript("doc.documentElement.removeChild(byId('a2'))");
+        assertEquals("dup,b3", ids("//b"));
+        assertEquals("a1", ids("//a"));
+    }
+}
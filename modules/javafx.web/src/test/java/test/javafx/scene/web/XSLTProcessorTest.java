@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertEquals;
+import org.junit.Before;
+import org.junit.Test;
+
+public class XSLTProcessorTest extends TestBase {
+
+    private static final String SHEET_PREFIX =
+            "<xsl:stylesheet version='1.0'"
+            + " xmlns:xsl='http://www.w3.org/1999/XSL/Transform'>"
+            + "<xsl:output method='xml'/>"
+            + "<xsl:template match='/'><out>";
+    private static final String SHEET_SUFFIX =
+            "<xsl:value-of select='/in/@v'/></out></xsl:template>"
+            + "</xsl:stylesheet>";
+
+    @Before
+    public void setUp() {
+        loadContent("<html><body><script>"
+                + "var parser = new DOMParser();"
+                + "function sheet(prefix) {"
+                + "  return parser.parseFromString("
+                + "      \"" + SHEET_PREFIX + "<xsl:text>\" + prefix + \"</xsl:text>"
+                + SHEET_SUFFIX + "\", 'text/xml');"
+                + "}"
+                + "var input = parser.parseFromString(\"<in v='1'/>\", 'text/xml');"
+                + "var processor = new XSLTProcessor();"
+                + "function transform() {"
+                + "  return processor.transformToDocument(input)"
+                + "      .documentElement.textContent;"
+                + "}"
+                + "</script></body></html>");
+    }
+
+    private String transform() {
+        return (String) executeScript("transform()");
+    }
+
+    @Test public void testRepeatedTransform() {
+        executeScript("processor.importStylesheet(sheet('a:'))");
+        assertEquals("a:1", transform());
+        assertEquals("a:1", transform());
+        executeScript("input.documentElement.setAttribute('v', '2')");
+        assertEquals("a:2", transform());
+    }
+
+    @Test public void testStylesheetMutation() {
+        executeScript("var xsl = sheet('a:'); processor.importStylesheet(xsl)");
+        assertEquals("a:1", transform());
+
+        executeScript("xsl.getElementsByTagNameNS("
+                + "'http://www.w3.org/1999/XSL/Transform', 'text')[0]"
+                + ".textContent = 'b:'");
+        assertEquals("b:1", transform());
+
+        executeScript("var out = xsl.getElementsByTagName('out')[0];"
+                + "out.insertBefore(xsl.createTextNode('c'), out.firstChild)");
+        assertEquals("cb:1", transform());
+
+        executeScript("out.removeChild(out.firstChild)");
+        assertEquals("b:1", transform());
+    }
+
+    @Test public void testReimportDifferentStylesheet() {
+        executeScript("processor.importStylesheet(sheet('a:'))");
+        assertEquals("a:1", transform());
+
+        executeScript("processor.importStylesheet(sheet('b:'))");
+        assertEquals("b:1", transform());
+
+        executeScript("processor.reset();"
+                + "processor.importStylesheet(sheet('c:'))");
+        assertEquals("c:1", transform());
+    }
+
+    @Test public void testUnrelatedMutationKeepsOutput() {
+        executeScript("var xsl = sheet('a:'); processor.importStylesheet(xsl)");
+        assertEquals("a:1", transform());
+
+        // Bumps the stylesheet document's tree version without changing
+        // the markup of the imported node.
+        executeScript("var comment = xsl.createComment('x');"
+                + "xsl.appendChild(comment); xsl.removeChild(comment)");
+        assertEquals("a:1", transform());
+    }
+}
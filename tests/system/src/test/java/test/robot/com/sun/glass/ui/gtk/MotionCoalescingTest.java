@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.robot.com.sun.glass.ui.gtk;
+
+import com.sun.glass.ui.Robot;
+import com.sun.glass.ui.gtk.GtkApplicationShim;
+import com.sun.javafx.PlatformUtil;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.input.MouseEvent;
+import javafx.stage.Stage;
+import org.junit.Test;
+import test.robot.testharness.VisualTestBase;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+/**
+ * Tests that a burst of motion events is merged natively by GTK Glass and
+ * still ends with the latest position.
+ */
+public class MotionCoalescingTest extends VisualTestBase {
+
+    private static final int WIDTH = 400;
+    private static final int HEIGHT = 300;
+    private static final int BURST = 100;
+
+    private Stage testStage;
+    private Robot robot;
+    private volatile int moved;
+    private volatile double lastX;
+
+    private void showScene() {
+        runAndWait(() -> {
+            Scene scene = new Scene(new Group(), WIDTH, HEIGHT);
+            scene.addEventHandler(MouseEvent.MOUSE_MOVED, e -> {
+                moved++;
+                lastX = e.getScreenX();
+            });
+            testStage = getStage();
+            testStage.setScene(scene);
+            testStage.setX(0);
+            testStage.setY(0);
+            testStage.show();
+        });
+        waitFirstFrame();
+    }
+
+    private void waitForMouseAt(int x) {
+        long timeout = System.currentTimeMillis() + 5000;
+        while (lastX != x && System.currentTimeMillis() < timeout) {
+            sleep(20);
+        }
+        assertEquals(x, lastX, 0.5);
+    }
+
+    @Test(timeout=15000)
+    public void testMotionBurst() {
+        assumeTrue(PlatformUtil.isLinux());
+        showScene();
+        int x = (int) testStage.getX() + 50;
+        int y = (int) testStage.getY() + HEIGHT / 2;
+        runAndWait(() -> {
+            robot = com.sun.glass.ui.Application.GetApplication().createRobot();
+            robot.mouseMove(x, y);
+        });
+        waitForMouseAt(x);
+
+        long[] before = new long[2];
+        runAndWait(() -> {
+            System.arraycopy(GtkApplicationShim.getEventCounts(), 0, before, 0, 2);
+            moved = 0;
+            // The event thread is busy until the whole burst is posted, so
+            // the events are all queued when GTK gets to them
+            for (int i = 1; i <= BURST; i++) {
+                robot.mouseMove(x + i, y);
+            }
+        });
+        waitForMouseAt(x + BURST);
+
+        long[] after = new long[2];
+        runAndWait(() -> System.arraycopy(GtkApplicationShim.getEventCounts(), 0, after, 0, 2));
+        long coalesced = after[0] - before[0];
+        int delivered = moved;
+        assertTrue("no motion delivered", delivered >= 1);
+        assertTrue("burst was not merged, " + delivered + " events delivered",
+                   delivered < BURST);
+        assertTrue(delivered + " delivered and " + coalesced + " merged events for a burst of " + BURST,
+                   delivered + coalesced <= BURST);
+    }
+}
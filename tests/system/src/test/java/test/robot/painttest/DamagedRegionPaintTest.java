@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.robot.painttest;
+
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.paint.Color;
+import javafx.scene.shape.Rectangle;
+import javafx.stage.Stage;
+import org.junit.Test;
+import test.robot.testharness.VisualTestBase;
+
+/**
+ * Tests that presenting only the damaged regions of a frame leaves the
+ * window with the same content as presenting the whole frame. On GTK this
+ * covers the MIT-SHM and cairo paths of the uploading painter, which is
+ * the one used under Xvfb.
+ */
+public class DamagedRegionPaintTest extends VisualTestBase {
+
+    private static final int WIDTH = 400;
+    private static final int HEIGHT = 300;
+    private static final int SIZE = 50;
+    private static final double TOLERANCE = 0.07;
+
+    private Stage testStage;
+    private Scene testScene;
+    private Rectangle changing;
+    private Rectangle unchanged;
+    private Stage cover;
+
+    private void showScene() {
+        runAndWait(() -> {
+            changing = new Rectangle(10, 10, SIZE, SIZE);
+            changing.setFill(Color.RED);
+            unchanged = new Rectangle(WIDTH - SIZE - 10, HEIGHT - SIZE - 10, SIZE, SIZE);
+            unchanged.setFill(Color.BLUE);
+            testScene = new Scene(new Group(changing, unchanged), WIDTH, HEIGHT);
+            testScene.setFill(Color.WHITE);
+
+            testStage = getStage();
+            testStage.setScene(testScene);
+            testStage.setX(0);
+            testStage.setY(0);
+            testStage.show();
+        });
+        waitFirstFrame();
+    }
+
+    private void assertColorAt(Color expected, int x, int y) {
+        assertColorEquals(expected, getColor(testScene, x, y), TOLERANCE);
+    }
+
+    @Test(timeout=15000)
+    public void testChangedRegion() {
+        showScene();
+        runAndWait(() -> changing.setFill(Color.GREEN));
+        waitNextFrame();
+        runAndWait(() -> {
+            assertColorAt(Color.GREEN, 10 + SIZE / 2, 10 + SIZE / 2);
+            assertColorAt(Color.BLUE, WIDTH - 10 - SIZE / 2, HEIGHT - 10 - SIZE / 2);
+            assertColorAt(Color.WHITE, WIDTH / 2, HEIGHT / 2);
+        });
+    }
+
+    @Test(timeout=15000)
+    public void testMovedNode() {
+        showScene();
+        runAndWait(() -> changing.setX(WIDTH / 2));
+        waitNextFrame();
+        runAndWait(() -> {
+            // The area the node left must be presented as well
+            assertColorAt(Color.WHITE, 10 + SIZE / 2, 10 + SIZE / 2);
+            assertColorAt(Color.RED, WIDTH / 2 + SIZE / 2, 10 + SIZE / 2);
+            assertColorAt(Color.BLUE, WIDTH - 10 - SIZE / 2, HEIGHT - 10 - SIZE / 2);
+        });
+    }
+
+    @Test(timeout=15000)
+    public void testManySmallChanges() {
+        showScene();
+        // More changes than there are dirty regions, which ViewPainter
+        // merges into larger damaged rectangles. Falling back to the entire
+        // frame past View.MAX_DAMAGE_RECTS is covered by QueuedPixelSourceTest,
+        // a single frame never has that many rectangles.
+        runAndWait(() -> {
+            Group root = (Group) testScene.getRoot();
+            for (int i = 0; i < 40; i++) {
+                Rectangle dot = new Rectangle(10 + (i % 20) * 12, 100 + (i / 20) * 12, 4, 4);
+                dot.setFill(Color.BLACK);
+                root.getChildren().add(dot);
+            }
+            changing.setFill(Color.GREEN);
+        });
+        waitNextFrame();
+        runAndWait(() -> {
+            assertColorAt(Color.GREEN, 10 + SIZE / 2, 10 + SIZE / 2);
+            assertColorAt(Color.BLACK, 12, 102);
+            assertColorAt(Color.BLUE, WIDTH - 10 - SIZE / 2, HEIGHT - 10 - SIZE / 2);
+        });
+    }
+
+    @Test(timeout=15000)
+    public void testExposeAfterPartialPresent() {
+        showScene();
+        runAndWait(() -> changing.setFill(Color.GREEN));
+        waitNextFrame();
+        // Cover the window and uncover it, which must present the whole
+        // frame again rather than only the last damaged region
+        runAndWait(() -> {
+            cover = getStage();
+            Scene coverScene = new Scene(new Group(), WIDTH, HEIGHT);
+            coverScene.setFill(Color.YELLOW);
+            cover.setScene(coverScene);
+            cover.setX(0);
+            cover.setY(0);
+            cover.show();
+        });
+        waitFirstFrame();
+        runAndWait(() -> cover.hide());
+        waitNextFrame();
+        runAndWait(() -> {
+            assertColorAt(Color.GREEN, 10 + SIZE / 2, 10 + SIZE / 2);
+            assertColorAt(Color.BLUE, WIDTH - 10 - SIZE / 2, HEIGHT - 10 - SIZE / 2);
+            assertColorAt(Color.WHITE, WIDTH / 2, HEIGHT / 2);
+        });
+    }
+}